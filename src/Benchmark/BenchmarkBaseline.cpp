@@ -0,0 +1,235 @@
+#include "BenchmarkBaseline.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+
+namespace
+{
+constexpr int BASELINE_FORMAT_VERSION = 1;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int findEntry( const QJsonArray& entries, const QString& stage, const QString& deck )
+{
+    for ( int i = 0; i < entries.size(); ++i )
+    {
+        const QJsonObject entry = entries[i].toObject();
+        if ( entry["stage"].toString() == stage && entry["deck"].toString() == deck )
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString formatMegabytes( qint64 bytes )
+{
+    return bytes < 0 ? QString( "-" ) : QString::number( bytes / 1048576.0, 'f', 1 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString formatChange( double baseline, double current )
+{
+    if ( baseline <= 0.0 || current < 0.0 ) return "-";
+    return QString( "%1%2%" ).arg( current >= baseline ? "+" : "" ).arg( ( current / baseline - 1.0 ) * 100.0, 0, 'f', 1 );
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool BenchmarkBaseline::load( const QString& filePath, QJsonArray* entries, QString* errorMessage )
+{
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        *errorMessage = QString( "Could not read the baseline %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    QJsonParseError     parseError;
+    const QJsonDocument document = QJsonDocument::fromJson( file.readAll(), &parseError );
+    if ( parseError.error != QJsonParseError::NoError || !document.isObject() )
+    {
+        *errorMessage = QString( "Invalid baseline %1: %2" ).arg( filePath ).arg( parseError.errorString() );
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+    if ( root["version"].toInt() != BASELINE_FORMAT_VERSION )
+    {
+        *errorMessage = QString( "Unsupported baseline format version %1 in %2" ).arg( root["version"].toInt() ).arg( filePath );
+        return false;
+    }
+
+    *entries = root["entries"].toArray();
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool BenchmarkBaseline::update( const QString& filePath, const QJsonArray& results, QString* errorMessage )
+{
+    // Start from an empty baseline if the file does not exist yet
+    QJsonArray entries;
+    if ( QFile::exists( filePath ) && !load( filePath, &entries, errorMessage ) )
+    {
+        return false;
+    }
+
+    for ( const QJsonValue& value : results )
+    {
+        const QJsonObject result = value.toObject();
+
+        QJsonObject entry;
+        entry["stage"]           = result["stage"];
+        entry["deck"]            = result["deck"];
+        entry["minMs"]           = result["minMs"];
+        entry["medianMs"]        = result["medianMs"];
+        entry["peakMemoryBytes"] = result["peakMemoryBytes"];
+
+        const int index = findEntry( entries, result["stage"].toString(), result["deck"].toString() );
+        if ( index >= 0 )
+        {
+            entries.replace( index, entry );
+        }
+        else
+        {
+            entries.append( entry );
+        }
+    }
+
+    QJsonObject root;
+    root["version"]   = BASELINE_FORMAT_VERSION;
+    root["updated"]   = QDateTime::currentDateTimeUtc().toString( Qt::ISODate );
+    root["host"]      = QSysInfo::machineHostName();
+    root["cpu"]       = QSysInfo::currentCpuArchitecture();
+    root["os"]        = QSysInfo::prettyProductName();
+    root["qtVersion"] = QString( qVersion() );
+    root["entries"]   = entries;
+
+    QFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) || file.write( QJsonDocument( root ).toJson( QJsonDocument::Indented ) ) < 0 )
+    {
+        *errorMessage = QString( "Could not write the baseline %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<BenchmarkBaseline::Comparison>
+    BenchmarkBaseline::compare( const QJsonArray& entries, const QJsonArray& results, const Tolerances& tolerances )
+{
+    QList<Comparison> comparisons;
+    for ( const QJsonValue& value : results )
+    {
+        const QJsonObject result = value.toObject();
+
+        Comparison comparison;
+        comparison.stage        = result["stage"].toString();
+        comparison.deck         = result["deck"].toString();
+        comparison.currentMs    = result["minMs"].toDouble();
+        comparison.currentBytes = result["peakMemoryBytes"].toInteger( -1 );
+
+        const int index = findEntry( entries, comparison.stage, comparison.deck );
+        if ( index >= 0 )
+        {
+            const QJsonObject entry  = entries[index].toObject();
+            comparison.hasBaseline   = true;
+            comparison.baselineMs    = entry["minMs"].toDouble();
+            comparison.baselineBytes = entry["peakMemoryBytes"].toInteger( -1 );
+
+            const double timeDelta = comparison.currentMs - comparison.baselineMs;
+            comparison.timeRegressed =
+                timeDelta > tolerances.minTimeDeltaMs && comparison.currentMs > comparison.baselineMs * ( 1.0 + tolerances.time );
+
+            // Peak memory is only compared when both runs could measure it
+            if ( comparison.baselineBytes >= 0 && comparison.currentBytes >= 0 )
+            {
+                const qint64 memoryDelta   = comparison.currentBytes - comparison.baselineBytes;
+                comparison.memoryRegressed = memoryDelta > tolerances.minMemoryDeltaBytes &&
+                                             comparison.currentBytes > comparison.baselineBytes * ( 1.0 + tolerances.memory );
+            }
+        }
+
+        comparisons.append( comparison );
+    }
+    return comparisons;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// One line per stage and deck, followed by a summary naming the regressed stages
+//--------------------------------------------------------------------------------------------------
+QString BenchmarkBaseline::report( const QList<Comparison>& comparisons, const Tolerances& tolerances )
+{
+    QString text = QString( "Baseline comparison, tolerance %1% time and %2% peak memory\n" )
+                       .arg( tolerances.time * 100.0, 0, 'f', 0 )
+                       .arg( tolerances.memory * 100.0, 0, 'f', 0 );
+    text += QString( "%1 %2 %3 %4 %5 %6 %7 %8  %9\n" )
+                .arg( "stage", -16 )
+                .arg( "deck", -8 )
+                .arg( "base ms", 10 )
+                .arg( "now ms", 10 )
+                .arg( "change", 8 )
+                .arg( "base MB", 9 )
+                .arg( "now MB", 9 )
+                .arg( "change", 8 )
+                .arg( "result" );
+
+    QStringList regressed;
+    for ( const Comparison& comparison : comparisons )
+    {
+        QString result = "ok";
+        if ( !comparison.hasBaseline )
+        {
+            result = "no baseline";
+        }
+        else if ( comparison.isRegression() )
+        {
+            QStringList reasons;
+            if ( comparison.timeRegressed ) reasons << "time";
+            if ( comparison.memoryRegressed ) reasons << "memory";
+            result = QString( "REGRESSED (%1)" ).arg( reasons.join( ", " ) );
+            regressed << QString( "%1/%2 (%3)" ).arg( comparison.stage ).arg( comparison.deck ).arg( reasons.join( ", " ) );
+        }
+
+        text += QString( "%1 %2 %3 %4 %5 %6 %7 %8  %9\n" )
+                    .arg( comparison.stage, -16 )
+                    .arg( comparison.deck, -8 )
+                    .arg( comparison.hasBaseline ? QString::number( comparison.baselineMs, 'f', 2 ) : QString( "-" ), 10 )
+                    .arg( QString::number( comparison.currentMs, 'f', 2 ), 10 )
+                    .arg( comparison.hasBaseline ? formatChange( comparison.baselineMs, comparison.currentMs ) : QString( "-" ), 8 )
+                    .arg( comparison.hasBaseline ? formatMegabytes( comparison.baselineBytes ) : QString( "-" ), 9 )
+                    .arg( formatMegabytes( comparison.currentBytes ), 9 )
+                    .arg( comparison.hasBaseline && comparison.baselineBytes >= 0
+                              ? formatChange( static_cast<double>( comparison.baselineBytes ), static_cast<double>( comparison.currentBytes ) )
+                              : QString( "-" ),
+                          8 )
+                    .arg( result );
+    }
+
+    if ( regressed.isEmpty() )
+    {
+        text += "No regressions\n";
+    }
+    else
+    {
+        text += QString( "%1 of %2 regressed: %3\n" ).arg( regressed.size() ).arg( comparisons.size() ).arg( regressed.join( "; " ) );
+    }
+    return text;
+}
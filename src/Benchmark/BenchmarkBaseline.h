@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QList>
+#include <QString>
+
+//==================================================================================================
+/// Stored benchmark results for the performance regression tests.
+///
+/// The baseline holds the minimum time and the peak memory of each stage and deck. A run regresses
+/// when a stage is slower or uses more memory than the baseline by more than the tolerance. The
+/// numbers are machine specific, so the baseline is only written by an explicit update.
+//==================================================================================================
+class BenchmarkBaseline
+{
+public:
+    struct Tolerances
+    {
+        double time                = 0.25; // Allowed relative increase of the minimum time
+        double memory              = 0.20; // Allowed relative increase of the peak memory
+        double minTimeDeltaMs      = 1.0; // Smaller differences are timer noise
+        qint64 minMemoryDeltaBytes = 4 * 1024 * 1024;
+    };
+
+    struct Comparison
+    {
+        QString stage;
+        QString deck;
+        bool    hasBaseline = false;
+
+        double baselineMs    = 0.0;
+        double currentMs     = 0.0;
+        qint64 baselineBytes = -1; // -1 if not measured
+        qint64 currentBytes  = -1;
+
+        bool timeRegressed   = false;
+        bool memoryRegressed = false;
+
+        bool isRegression() const { return timeRegressed || memoryRegressed; }
+    };
+
+    static bool load( const QString& filePath, QJsonArray* entries, QString* errorMessage );
+
+    // Replace the entries of the measured stages and decks, other entries are kept
+    static bool update( const QString& filePath, const QJsonArray& results, QString* errorMessage );
+
+    static QList<Comparison> compare( const QJsonArray& entries, const QJsonArray& results, const Tolerances& tolerances );
+    static QString           report( const QList<Comparison>& comparisons, const Tolerances& tolerances );
+};
@@ -0,0 +1,175 @@
+#include "DataDeck/DataArrayKernels.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+//==================================================================================================
+/// Checks the SIMD paths of DataArrayKernels against their scalar tail loops. A call with one value
+/// always takes the scalar loop, so the result for a whole array is compared with the sum of the
+/// results for each value. Every array is also tested at each length and start offset, so values
+/// land in both SIMD lanes and in the tail.
+//==================================================================================================
+
+namespace
+{
+const double NAN_VALUE = std::numeric_limits<double>::quiet_NaN();
+const double INF_VALUE = std::numeric_limits<double>::infinity();
+
+int failureCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void check( bool condition, const char* what, size_t offset, size_t count )
+{
+    if ( !condition )
+    {
+        std::fprintf( stderr, "FAILED: %s, offset %zu, count %zu\n", what, offset, count );
+        ++failureCount;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool isSameDouble( double a, double b )
+{
+    return a == b || ( std::isnan( a ) && std::isnan( b ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void checkCountOutOfRange( const std::vector<double>& values, double minValue, double maxValue )
+{
+    for ( size_t offset = 0; offset < values.size(); ++offset )
+    {
+        for ( size_t count = 0; offset + count <= values.size(); ++count )
+        {
+            const double* start = values.data() + offset;
+
+            DataArrayKernels::RangeCounts scalar;
+            for ( size_t i = 0; i < count; ++i )
+            {
+                scalar += DataArrayKernels::countOutOfRange( start + i, 1, minValue, maxValue );
+            }
+
+            const DataArrayKernels::RangeCounts counts = DataArrayKernels::countOutOfRange( start, count, minValue, maxValue );
+            check( counts.below == scalar.below, "countOutOfRange below", offset, count );
+            check( counts.above == scalar.above, "countOutOfRange above", offset, count );
+            check( counts.nonFinite == scalar.nonFinite, "countOutOfRange nonFinite", offset, count );
+
+            // findOutOfRange reports the same values as countOutOfRange, also when the output is full
+            std::vector<qint64> offsets( count + 1, -1 );
+            const size_t        found = DataArrayKernels::findOutOfRange( start, count, minValue, maxValue, offsets.data(), count );
+            check( static_cast<qint64>( found ) == scalar.total(), "findOutOfRange count", offset, count );
+            for ( size_t j = 0; j < found; ++j )
+            {
+                const qint64 valueOffset = offsets[j];
+                check( valueOffset >= 0 && valueOffset < static_cast<qint64>( count ) &&
+                           DataArrayKernels::countOutOfRange( start + valueOffset, 1, minValue, maxValue ).total() == 1,
+                       "findOutOfRange offset",
+                       offset,
+                       count );
+            }
+
+            if ( found > 1 )
+            {
+                const size_t limited = DataArrayKernels::findOutOfRange( start, count, minValue, maxValue, offsets.data(), 1 );
+                check( limited == 1, "findOutOfRange maxOffsets", offset, count );
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void checkCompareValues( const std::vector<double>& base, const std::vector<double>& other, double absTolerance, double relTolerance )
+{
+    for ( size_t offset = 0; offset < base.size(); ++offset )
+    {
+        for ( size_t count = 0; offset + count <= base.size(); ++count )
+        {
+            const double* baseStart  = base.data() + offset;
+            const double* otherStart = other.data() + offset;
+
+            DataArrayKernels::DeltaStats scalar;
+            for ( size_t i = 0; i < count; ++i )
+            {
+                scalar.merge( DataArrayKernels::compareValues( baseStart + i, otherStart + i, 1, absTolerance, relTolerance ),
+                              static_cast<qint64>( i ) );
+            }
+
+            const DataArrayKernels::DeltaStats stats =
+                DataArrayKernels::compareValues( baseStart, otherStart, count, absTolerance, relTolerance );
+            check( stats.changedCount == scalar.changedCount, "compareValues changedCount", offset, count );
+            check( stats.firstChanged == scalar.firstChanged, "compareValues firstChanged", offset, count );
+            check( stats.lastChanged == scalar.lastChanged, "compareValues lastChanged", offset, count );
+            check( isSameDouble( stats.sumDelta, scalar.sumDelta ), "compareValues sumDelta", offset, count );
+            check( isSameDouble( stats.sumAbsDelta, scalar.sumAbsDelta ), "compareValues sumAbsDelta", offset, count );
+            check( isSameDouble( stats.maxAbsDelta, scalar.maxAbsDelta ), "compareValues maxAbsDelta", offset, count );
+            check( stats.maxAbsDeltaOffset == scalar.maxAbsDeltaOffset, "compareValues maxAbsDeltaOffset", offset, count );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Results that follow from the definitions, so both paths are also checked on their own
+//--------------------------------------------------------------------------------------------------
+void checkExpectedValues()
+{
+    const std::vector<double> values = { NAN_VALUE, -INF_VALUE, INF_VALUE, -1.0, 0.0, 1.0, 2.0 };
+
+    const DataArrayKernels::RangeCounts counts = DataArrayKernels::countOutOfRange( values.data(), values.size(), 0.0, 1.0 );
+    check( counts.nonFinite == 3, "NaN and Inf are non-finite", 0, values.size() );
+    check( counts.below == 1, "finite value below the range", 0, values.size() );
+    check( counts.above == 1, "finite value above the range", 0, values.size() );
+
+    // With no relative tolerance, 0 * Inf is NaN and the absolute tolerance applies
+    const std::vector<double> base  = { INF_VALUE, INF_VALUE, 1.0, NAN_VALUE, NAN_VALUE, 1.0 };
+    const std::vector<double> other = { INF_VALUE, 1.0, 1.5, NAN_VALUE, 1.0, 1.0 };
+
+    const DataArrayKernels::DeltaStats stats = DataArrayKernels::compareValues( base.data(), other.data(), base.size(), 1.0, 0.0 );
+    check( stats.changedCount == 2, "Inf to finite and NaN to finite are changed", 0, base.size() );
+    check( stats.firstChanged == 1 && stats.lastChanged == 4, "changed range", 0, base.size() );
+    check( stats.maxAbsDeltaOffset == -1 && stats.sumDelta == 0.0, "non-finite deltas are not summed", 0, base.size() );
+
+    // A relative tolerance on an Inf magnitude is Inf, so the change from Inf to a finite value is not seen
+    const DataArrayKernels::DeltaStats relative = DataArrayKernels::compareValues( base.data(), other.data(), base.size(), 0.0, 0.1 );
+    check( relative.changedCount == 2 && relative.firstChanged == 2, "relative tolerance with Inf", 0, base.size() );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int main()
+{
+    // Odd lengths leave a value for the scalar tail at every start offset
+    const std::vector<double> values = { NAN_VALUE, 0.5, -INF_VALUE, INF_VALUE, -2.0, 3.0,       1.0, 0.0,
+                                         -0.0,      NAN_VALUE, 7.0,  -1e300,    1e300, INF_VALUE, 0.25 };
+
+    checkCountOutOfRange( values, 0.0, 1.0 );
+    checkCountOutOfRange( values, -INF_VALUE, INF_VALUE );
+    checkCountOutOfRange( values, 2.0, 1.0 );
+
+    const std::vector<double> base  = { NAN_VALUE, NAN_VALUE, 1.0,       INF_VALUE, INF_VALUE, -INF_VALUE, 0.0,  1.0,
+                                        1.0,       2.0,       -1e300,    0.0,       5.0,       100.0,      -3.0 };
+    const std::vector<double> other = { NAN_VALUE, 1.0,       NAN_VALUE, INF_VALUE, 1.0,       INF_VALUE,  -0.0, 1.05,
+                                        1.0,       2.5,       1e300,     INF_VALUE, 5.0,       101.0,      -3.5 };
+
+    const double tolerances[][2] = { { 0.0, 0.0 }, { 0.1, 0.0 }, { 0.0, 0.1 }, { 0.1, 0.01 }, { 0.0, INF_VALUE } };
+    for ( const auto& tolerance : tolerances )
+    {
+        checkCompareValues( base, other, tolerance[0], tolerance[1] );
+    }
+
+    checkExpectedValues();
+
+    std::printf( "DataArrayKernels, SIMD %s: %d failures\n", DataArrayKernels::isSimdEnabled() ? "enabled" : "disabled", failureCount );
+    return failureCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,374 @@
+#include "DataDeckBenchmark.h"
+#include "SyntheticDeckGenerator.h"
+
+#include "DataDeck/DataArrayKernels.h"
+#include "DataDeck/DataFileSyntaxHighlighter.h"
+#include "DataDeck/KeywordDatabase.h"
+#include "DataDeck/RimDataDeck.h"
+
+#include "opm/input/eclipse/Deck/Deck.hpp"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTextDocument>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+
+#if defined( Q_OS_WIN )
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined( Q_OS_UNIX )
+#include <sys/resource.h>
+#endif
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QJsonObject DataDeckBenchmark::StageResult::toJson() const
+{
+    std::vector<double> sorted = timesMs;
+    std::sort( sorted.begin(), sorted.end() );
+
+    QJsonObject object;
+    object["stage"]      = stage;
+    object["deck"]       = deck;
+    object["iterations"] = static_cast<int>( sorted.size() );
+    if ( !sorted.empty() )
+    {
+        object["minMs"]    = sorted.front();
+        object["medianMs"] = sorted[sorted.size() / 2];
+        object["meanMs"]   = std::accumulate( sorted.begin(), sorted.end(), 0.0 ) / sorted.size();
+        object["maxMs"]    = sorted.back();
+    }
+    if ( peakMemoryBytes >= 0 )
+    {
+        object["peakMemoryBytes"] = peakMemoryBytes;
+    }
+    return object;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckBenchmark::DataDeckBenchmark( const Options& options )
+    : m_options( options )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckBenchmark::DeckSize> DataDeckBenchmark::deckSizes()
+{
+    return { DeckSize{ "small", 20, 20, 5 }, DeckSize{ "medium", 60, 60, 20 }, DeckSize{ "large", 120, 120, 50 } };
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QStringList DataDeckBenchmark::stageNames()
+{
+    return { "keywordDatabase", "parse", "buildSections", "textPositions", "resolveIncludes", "serialize", "highlight" };
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Fixed seed and densities, so every run times the same files
+//--------------------------------------------------------------------------------------------------
+QString DataDeckBenchmark::writeDeck( const QString& directory, const DeckSize& size )
+{
+    SyntheticDeckGenerator::Parameters parameters;
+    parameters.baseName           = size.name.toUpper();
+    parameters.nx                 = size.nx;
+    parameters.ny                 = size.ny;
+    parameters.nz                 = size.nz;
+    parameters.wellCount          = 8;
+    parameters.completionsPerWell = size.nz;
+    parameters.reportSteps        = 24;
+    parameters.includeDepth       = 2;
+    parameters.repeatDensity      = 0.1;
+    parameters.commentDensity     = 0.02;
+
+    const SyntheticDeckGenerator::Result result = SyntheticDeckGenerator::generate( directory, parameters );
+    return result.success() ? result.filePath : QString();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckBenchmark::peakMemoryBytes()
+{
+#if defined( Q_OS_LINUX )
+    // VmHWM follows resets through clear_refs, ru_maxrss does not
+    QFile status( "/proc/self/status" );
+    if ( status.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        for ( QByteArray line = status.readLine(); !line.isEmpty(); line = status.readLine() )
+        {
+            if ( line.startsWith( "VmHWM:" ) )
+            {
+                return line.mid( 6 ).trimmed().split( ' ' ).front().toLongLong() * 1024;
+            }
+        }
+    }
+    return -1;
+#elif defined( Q_OS_WIN )
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+    {
+        return static_cast<qint64>( counters.PeakWorkingSetSize );
+    }
+    return -1;
+#elif defined( Q_OS_UNIX )
+    struct rusage usage;
+    if ( getrusage( RUSAGE_SELF, &usage ) == 0 )
+    {
+        return static_cast<qint64>( usage.ru_maxrss ); // Bytes on macOS
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Set the peak to the current resident size, so the next reading is the peak of one stage. Other
+/// platforms report the peak of the process, the performance tests run each stage in its own process.
+//--------------------------------------------------------------------------------------------------
+bool DataDeckBenchmark::resetPeakMemory()
+{
+#if defined( Q_OS_LINUX )
+    QFile clearRefs( "/proc/self/clear_refs" );
+    return clearRefs.open( QIODevice::WriteOnly ) && clearRefs.write( "5" ) == 1;
+#else
+    return false;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckBenchmark::isStageEnabled( const QString& stage ) const
+{
+    return m_options.stageNames.isEmpty() || m_options.stageNames.contains( stage );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckBenchmark::StageResult DataDeckBenchmark::measure( const QString& stage, const QString& deck, const std::function<void()>& body ) const
+{
+    StageResult result;
+    result.stage = stage;
+    result.deck  = deck;
+
+    resetPeakMemory();
+
+    for ( int i = 0; i < m_options.iterations; ++i )
+    {
+        QElapsedTimer timer;
+        timer.start();
+        body();
+        result.timesMs.push_back( timer.nsecsElapsed() / 1.0e6 );
+    }
+
+    result.peakMemoryBytes = peakMemoryBytes();
+
+    std::fprintf( stderr, "%-16s %-8s %10.2f ms (min of %d) %8.1f MB peak\n", qPrintable( stage ), qPrintable( deck ),
+                  *std::min_element( result.timesMs.begin(), result.timesMs.end() ), m_options.iterations,
+                  result.peakMemoryBytes / 1048576.0 );
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The stages run in pipeline order and each stage reuses the output of the previous one
+//--------------------------------------------------------------------------------------------------
+void DataDeckBenchmark::runDeckStages( const DeckSize& size, const QString& filePath, QJsonArray& results ) const
+{
+    std::shared_ptr<Opm::Deck> deck = RimDataDeck::parseDeckFile( filePath );
+    if ( isStageEnabled( "parse" ) )
+    {
+        results.append( measure( "parse", size.name, [&]() { deck = RimDataDeck::parseDeckFile( filePath ); } ).toJson() );
+    }
+
+    // Builds the tree once, the stages below build it again step by step
+    RimDataDeck dataDeck;
+    dataDeck.setDeck( deck, filePath );
+
+    if ( isStageEnabled( "buildSections" ) )
+    {
+        // Includes the text position pass, which buildSectionsFromDeck() runs first
+        results.append( measure( "buildSections", size.name, [&]() { dataDeck.buildSectionsFromDeck(); } ).toJson() );
+    }
+
+    if ( isStageEnabled( "textPositions" ) )
+    {
+        results.append( measure( "textPositions", size.name, [&]() { dataDeck.calculateTextPositions(); } ).toJson() );
+    }
+
+    if ( isStageEnabled( "resolveIncludes" ) )
+    {
+        results.append( measure( "resolveIncludes", size.name, [&]() { dataDeck.resolveIncludesFromRawFile(); } ).toJson() );
+    }
+
+    QString text = dataDeck.serializeToText();
+    if ( isStageEnabled( "serialize" ) )
+    {
+        results.append( measure( "serialize", size.name, [&]() { text = dataDeck.serializeToText(); } ).toJson() );
+    }
+
+    if ( isStageEnabled( "highlight" ) )
+    {
+        // Format every block, including the blocks the editor leaves to the idle pass
+        auto highlight = [&text]()
+        {
+            QTextDocument             document( text );
+            DataFileSyntaxHighlighter highlighter( &document );
+            highlighter.rehighlight();
+            while ( !highlighter.isIdlePassComplete() )
+            {
+                QCoreApplication::processEvents();
+            }
+        };
+        results.append( measure( "highlight", size.name, highlight ).toJson() );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckBenchmark::run()
+{
+    std::unique_ptr<QTemporaryDir> temporaryDirectory;
+    QString                        workDirectory = m_options.workDirectory;
+    if ( workDirectory.isEmpty() )
+    {
+        temporaryDirectory = std::make_unique<QTemporaryDir>();
+        workDirectory      = temporaryDirectory->path();
+    }
+    QDir().mkpath( workDirectory );
+
+    QJsonArray results;
+    QJsonArray decks;
+
+    KeywordDatabase* keywordDatabase = KeywordDatabase::instance();
+    if ( isStageEnabled( "keywordDatabase" ) )
+    {
+        results.append( measure( "keywordDatabase", "", [keywordDatabase]() { keywordDatabase->loadKeywords(); } ).toJson() );
+    }
+
+    for ( const DeckSize& size : deckSizes() )
+    {
+        if ( !m_options.sizeNames.isEmpty() && !m_options.sizeNames.contains( size.name ) ) continue;
+
+        const QString filePath = writeDeck( workDirectory, size );
+        if ( filePath.isEmpty() )
+        {
+            std::fprintf( stderr, "Could not write the %s deck to %s\n", qPrintable( size.name ), qPrintable( workDirectory ) );
+            return EXIT_FAILED;
+        }
+
+        QJsonObject deck;
+        deck["name"]      = size.name;
+        deck["cellCount"] = size.cellCount();
+        deck["fileBytes"] = QFileInfo( filePath ).size();
+        decks.append( deck );
+
+        try
+        {
+            runDeckStages( size, filePath, results );
+        }
+        catch ( const std::exception& e )
+        {
+            std::fprintf( stderr, "The %s deck failed: %s\n", qPrintable( size.name ), e.what() );
+            return EXIT_FAILED;
+        }
+    }
+
+    QJsonObject root;
+    root["qtVersion"]  = QString( qVersion() );
+    root["simd"]       = DataArrayKernels::isSimdEnabled();
+    root["iterations"] = m_options.iterations;
+    root["decks"]      = decks;
+    root["results"]    = results;
+
+    const QByteArray json = QJsonDocument( root ).toJson( QJsonDocument::Indented );
+
+    QFile output;
+    bool  isOpen = false;
+    if ( m_options.outputFilePath.isEmpty() )
+    {
+        isOpen = output.open( stdout, QIODevice::WriteOnly );
+    }
+    else
+    {
+        output.setFileName( m_options.outputFilePath );
+        isOpen = output.open( QIODevice::WriteOnly | QIODevice::Truncate );
+    }
+    if ( !isOpen || output.write( json ) < 0 )
+    {
+        std::fprintf( stderr, "Could not write the results: %s\n", qPrintable( output.errorString() ) );
+        return EXIT_FAILED;
+    }
+
+    if ( m_options.updateBaseline )
+    {
+        QString errorMessage;
+        if ( !BenchmarkBaseline::update( m_options.baselineFilePath, results, &errorMessage ) )
+        {
+            std::fprintf( stderr, "%s\n", qPrintable( errorMessage ) );
+            return EXIT_FAILED;
+        }
+        std::fprintf( stderr, "Updated %d entries in %s\n", static_cast<int>( results.size() ), qPrintable( m_options.baselineFilePath ) );
+        return EXIT_OK;
+    }
+
+    if ( !m_options.baselineFilePath.isEmpty() )
+    {
+        return compareWithBaseline( results );
+    }
+
+    return EXIT_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckBenchmark::compareWithBaseline( const QJsonArray& results ) const
+{
+    QJsonArray entries;
+    QString    errorMessage;
+    if ( !BenchmarkBaseline::load( m_options.baselineFilePath, &entries, &errorMessage ) )
+    {
+        std::fprintf( stderr, "%s\n", qPrintable( errorMessage ) );
+        return EXIT_FAILED;
+    }
+
+    const QList<BenchmarkBaseline::Comparison> comparisons = BenchmarkBaseline::compare( entries, results, m_options.tolerances );
+    std::fprintf( stderr, "\n%s", qPrintable( BenchmarkBaseline::report( comparisons, m_options.tolerances ) ) );
+
+    bool isBaselineMissing = false;
+    for ( const BenchmarkBaseline::Comparison& comparison : comparisons )
+    {
+        if ( comparison.isRegression() ) return EXIT_REGRESSION;
+        isBaselineMissing = isBaselineMissing || !comparison.hasBaseline;
+    }
+
+    if ( !isBaselineMissing ) return EXIT_OK;
+    if ( m_options.allowMissingBaseline ) return EXIT_NO_BASELINE;
+
+    // A stage without a baseline would otherwise pass the gate without being compared
+    std::fprintf( stderr,
+                  "No baseline entry for some stages in %s. Record them with the update_benchmark_baseline target.\n",
+                  qPrintable( m_options.baselineFilePath ) );
+    return EXIT_FAILED;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "BenchmarkBaseline.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <vector>
+
+class RimDataDeck;
+
+//==================================================================================================
+/// Times each stage of the deck pipeline separately on generated decks of several sizes, and writes
+/// the results as JSON so runs from different commits can be compared.
+///
+/// Every stage runs a number of iterations and reports the minimum, median, mean and maximum time.
+/// The minimum is the most stable value to compare between runs. The peak resident memory of the
+/// process is reset before each stage where the platform allows it, so it is the peak of the stage.
+///
+/// With a baseline file the results are compared with the stored baseline, and the exit code tells
+/// the performance tests whether a stage regressed.
+//==================================================================================================
+class DataDeckBenchmark
+{
+public:
+    static constexpr int EXIT_OK          = 0;
+    static constexpr int EXIT_FAILED      = 1;
+    static constexpr int EXIT_REGRESSION  = 2;
+    static constexpr int EXIT_NO_BASELINE = 77; // Reported as skipped by CTest, only with allowMissingBaseline
+
+    struct DeckSize
+    {
+        QString name;
+        int     nx = 0;
+        int     ny = 0;
+        int     nz = 0;
+
+        qint64 cellCount() const { return qint64( nx ) * ny * nz; }
+    };
+
+    struct Options
+    {
+        QStringList sizeNames;       // Empty runs all sizes
+        QStringList stageNames;      // Empty runs all stages
+        int         iterations = 5;
+        QString     outputFilePath;  // Empty writes to stdout
+        QString     workDirectory;   // Empty uses a temporary directory
+
+        QString                       baselineFilePath; // Empty skips the baseline comparison
+        bool                          updateBaseline       = false; // Write the results to the baseline instead
+        bool                          allowMissingBaseline = false; // Skip instead of fail for stages without a baseline
+        BenchmarkBaseline::Tolerances tolerances;
+    };
+
+    struct StageResult
+    {
+        QString             stage;
+        QString             deck;
+        std::vector<double> timesMs;
+        qint64              peakMemoryBytes = -1; // -1 if the platform cannot measure it
+
+        QJsonObject toJson() const;
+    };
+
+    explicit DataDeckBenchmark( const Options& options );
+
+    int run();
+
+    static QList<DeckSize> deckSizes();
+    static QStringList     stageNames();
+
+    // Writes a synthetic deck of the size with SyntheticDeckGenerator, returns the DATA file path
+    static QString writeDeck( const QString& directory, const DeckSize& size );
+
+    // Peak resident memory of the process, -1 if unknown. Reset is only supported on Linux.
+    static qint64 peakMemoryBytes();
+    static bool   resetPeakMemory();
+
+private:
+    bool        isStageEnabled( const QString& stage ) const;
+    StageResult measure( const QString& stage, const QString& deck, const std::function<void()>& body ) const;
+    void        runDeckStages( const DeckSize& size, const QString& filePath, QJsonArray& results ) const;
+    int         compareWithBaseline( const QJsonArray& results ) const;
+
+private:
+    Options m_options;
+};
@@ -0,0 +1,83 @@
+#include "SyntheticDeckGenerator.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstdio>
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Write a synthetic Eclipse deck for benchmarks and stress tests." );
+    parser.addHelpOption();
+    parser.addOption( QCommandLineOption( "output-dir", "Directory for the deck and its include files.", "directory", "." ) );
+    parser.addOption( QCommandLineOption( "name", "Base name of the DATA file.", "name", "SYNTHETIC" ) );
+    parser.addOption( QCommandLineOption( "nx", "Grid cells in I.", "count", "10" ) );
+    parser.addOption( QCommandLineOption( "ny", "Grid cells in J.", "count", "10" ) );
+    parser.addOption( QCommandLineOption( "nz", "Grid cells in K.", "count", "10" ) );
+    parser.addOption( QCommandLineOption( "target-size", "Choose NX, NY and NZ for a deck of about this size, like 500M or 10G.", "size" ) );
+    parser.addOption( QCommandLineOption( "wells", "Number of wells.", "count", "4" ) );
+    parser.addOption( QCommandLineOption( "completions", "COMPDAT rows per well.", "count", "1" ) );
+    parser.addOption( QCommandLineOption( "steps", "Number of report steps.", "count", "12" ) );
+    parser.addOption( QCommandLineOption( "include-depth", "Nesting depth of the grid array include files, 0 for one file.", "depth", "1" ) );
+    parser.addOption( QCommandLineOption( "repeat-density", "Fraction of values written as repeat counts, 0 to 1.", "fraction", "0.1" ) );
+    parser.addOption( QCommandLineOption( "comment-density", "Probability of a comment line after each data line, 0 to 1.", "fraction", "0.05" ) );
+    parser.addOption( QCommandLineOption( "seed", "Random seed, the same seed gives the same deck.", "seed", "1" ) );
+    parser.process( app );
+
+    SyntheticDeckGenerator::Parameters parameters;
+    parameters.baseName           = parser.value( "name" );
+    parameters.nx                 = parser.value( "nx" ).toInt();
+    parameters.ny                 = parser.value( "ny" ).toInt();
+    parameters.nz                 = parser.value( "nz" ).toInt();
+    parameters.wellCount          = parser.value( "wells" ).toInt();
+    parameters.completionsPerWell = parser.value( "completions" ).toInt();
+    parameters.reportSteps        = parser.value( "steps" ).toInt();
+    parameters.includeDepth       = parser.value( "include-depth" ).toInt();
+    parameters.repeatDensity      = parser.value( "repeat-density" ).toDouble();
+    parameters.commentDensity     = parser.value( "comment-density" ).toDouble();
+    parameters.seed               = parser.value( "seed" ).toULongLong();
+
+    if ( parser.isSet( "target-size" ) )
+    {
+        const qint64 bytes = SyntheticDeckGenerator::parseByteSize( parser.value( "target-size" ) );
+        if ( bytes <= 0 )
+        {
+            std::fprintf( stderr, "Invalid target size: %s\n", qPrintable( parser.value( "target-size" ) ) );
+            return 2;
+        }
+        parameters = SyntheticDeckGenerator::forTargetSize( bytes, parameters );
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const SyntheticDeckGenerator::Result result = SyntheticDeckGenerator::generate( parser.value( "output-dir" ), parameters );
+    if ( !result.success() )
+    {
+        std::fprintf( stderr, "%s\n", qPrintable( result.errorMessage ) );
+        return 1;
+    }
+
+    const qint64 elapsedMs = timer.elapsed();
+
+    QJsonObject summary;
+    summary["file"]         = result.filePath;
+    summary["includeFiles"] = QJsonArray::fromStringList( result.includeFilePaths );
+    summary["nx"]           = parameters.nx;
+    summary["ny"]           = parameters.ny;
+    summary["nz"]           = parameters.nz;
+    summary["cellCount"]    = parameters.cellCount();
+    summary["bytesWritten"] = result.bytesWritten;
+    summary["elapsedMs"]    = elapsedMs;
+    summary["mbPerSecond"]  = elapsedMs > 0 ? result.bytesWritten / 1048576.0 / ( elapsedMs / 1000.0 ) : 0.0;
+
+    std::fprintf( stdout, "%s", QJsonDocument( summary ).toJson( QJsonDocument::Indented ).constData() );
+    return 0;
+}
@@ -0,0 +1,350 @@
+#include "EditingSessionReplayer.h"
+
+#include "DataDeck/DataDeckLoader.h"
+#include "DataDeck/DataFileCompleter.h"
+#include "DataDeck/DataFileSyntaxHighlighter.h"
+#include "DataDeck/RimDataDeck.h"
+#include "DataDeck/RimDataDeckTextEditor.h"
+#include "DataDeck/RimDataKeyword.h"
+#include "MainWindow.h"
+
+#include "cafPdmObject.h"
+#include "cafPdmUiTreeView.h"
+
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QKeyEvent>
+#include <QMessageBox>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTextCursor>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+EditingSessionReplayer::EditingSessionReplayer( const Options& options )
+    : m_options( options )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int EditingSessionReplayer::run()
+{
+    EditingSession session;
+    QString        errorMessage;
+    if ( !EditingSession::load( m_options.sessionFilePath, &session, &errorMessage ) )
+    {
+        std::fprintf( stderr, "%s\n", qPrintable( errorMessage ) );
+        return 1;
+    }
+
+    const QString deckFilePath = QFileInfo( m_options.deckFilePath.isEmpty() ? session.deckFilePath : m_options.deckFilePath ).absoluteFilePath();
+    if ( !QFileInfo::exists( deckFilePath ) )
+    {
+        std::fprintf( stderr, "The deck %s does not exist, use --deck to replay on another deck\n", qPrintable( deckFilePath ) );
+        return 1;
+    }
+
+    // Keep the replay out of the recent files of the user. On Windows the native format is the
+    // registry, which setPath does not redirect.
+    QTemporaryDir settingsDirectory;
+    QSettings::setPath( QSettings::NativeFormat, QSettings::UserScope, settingsDirectory.path() );
+    QSettings::setPath( QSettings::IniFormat, QSettings::UserScope, settingsDirectory.path() );
+
+    // Message boxes would block the replay, they are closed and reported instead
+    QTimer dialogTimer;
+    QObject::connect( &dialogTimer, &QTimer::timeout, [this]() { closeModalDialogs(); } );
+    dialogTimer.start( 50 );
+
+    QJsonObject root;
+    {
+        MainWindow window;
+        window.m_autoOpenLastFile = false;
+        window.resize( 1200, 800 );
+        window.show();
+        window.activateWindow();
+
+        if ( !openDeck( window, deckFilePath, &errorMessage ) )
+        {
+            std::fprintf( stderr, "%s\n", qPrintable( errorMessage ) );
+            return 1;
+        }
+
+        window.m_textEditor->setFocus();
+        QCoreApplication::processEvents();
+
+        QMap<QString, std::vector<double>> timesByType;
+        std::vector<double>                allTimes;
+        int                                skippedCount = 0;
+
+        QElapsedTimer replayTimer;
+        replayTimer.start();
+
+        const qint64 firstEventTimeMs = session.events.isEmpty() ? 0 : session.events.front().timeMs;
+        for ( const EditingSessionEvent& event : session.events )
+        {
+            if ( m_options.realtime )
+            {
+                const qint64 dueMs = event.timeMs - firstEventTimeMs;
+                while ( replayTimer.elapsed() < dueMs )
+                {
+                    QCoreApplication::processEvents( QEventLoop::AllEvents, static_cast<int>( dueMs - replayTimer.elapsed() ) );
+                    QThread::msleep( 1 );
+                }
+            }
+
+            const double latencyMs = replayEvent( window, event );
+            if ( latencyMs < 0.0 )
+            {
+                skippedCount++;
+                continue;
+            }
+
+            timesByType[EditingSessionEvent::typeName( event.type )].push_back( latencyMs );
+            allTimes.push_back( latencyMs );
+        }
+
+        QJsonObject latency;
+        latency["all"] = latencySummary( allTimes );
+        for ( auto it = timesByType.cbegin(); it != timesByType.cend(); ++it )
+        {
+            latency[it.key()] = latencySummary( it.value() );
+        }
+
+        root["session"]       = QFileInfo( m_options.sessionFilePath ).absoluteFilePath();
+        root["deck"]          = deckFilePath;
+        root["qtVersion"]     = QString( qVersion() );
+        root["realtime"]      = m_options.realtime;
+        root["eventCount"]    = static_cast<int>( session.events.size() );
+        root["skippedEvents"] = skippedCount;
+        root["replayMs"]      = replayTimer.elapsed();
+        root["latency"]       = latency;
+        root["dialogs"]       = QJsonArray::fromStringList( m_dialogMessages );
+    }
+
+    const QByteArray json = QJsonDocument( root ).toJson( QJsonDocument::Indented );
+
+    QFile output;
+    bool  isOpen = false;
+    if ( m_options.outputFilePath.isEmpty() )
+    {
+        isOpen = output.open( stdout, QIODevice::WriteOnly );
+    }
+    else
+    {
+        output.setFileName( m_options.outputFilePath );
+        isOpen = output.open( QIODevice::WriteOnly | QIODevice::Truncate );
+    }
+    if ( !isOpen || output.write( json ) < 0 )
+    {
+        std::fprintf( stderr, "Could not write the results: %s\n", qPrintable( output.errorString() ) );
+        return 1;
+    }
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Load the deck the same way as the user, select it and wait until the text is loaded and the
+/// first highlighting pass is done, so the replay starts from an idle editor
+//--------------------------------------------------------------------------------------------------
+bool EditingSessionReplayer::openDeck( MainWindow& window, const QString& filePath, QString* errorMessage )
+{
+    window.importDataFile( filePath );
+    if ( !waitUntil( [&window]() { return !window.m_dataDeckLoader->isLoading(); } ) )
+    {
+        *errorMessage = QString( "Timed out loading %1" ).arg( filePath );
+        return false;
+    }
+
+    m_dataDeck = window.findDataDeck( filePath );
+    if ( !m_dataDeck )
+    {
+        *errorMessage = QString( "Could not load %1" ).arg( filePath );
+        if ( !m_dialogMessages.isEmpty() ) *errorMessage += ": " + m_dialogMessages.last();
+        return false;
+    }
+
+    window.m_pdmUiTreeView->selectAsCurrentItem( m_dataDeck.p() );
+    QCoreApplication::processEvents();
+
+    if ( window.isLargeFileViewerActive() )
+    {
+        *errorMessage = QString( "%1 is too large for the text editor, there is nothing to replay" ).arg( filePath );
+        return false;
+    }
+
+    RimDataDeckTextEditor* textEditor = window.m_textEditor;
+    if ( !waitUntil( [this, textEditor]() { return textEditor->dataDeck() == m_dataDeck.p() && !textEditor->isLoading(); } ) )
+    {
+        *errorMessage = QString( "Timed out loading the text of %1" ).arg( filePath );
+        return false;
+    }
+
+    DataFileSyntaxHighlighter* highlighter = textEditor->document()->findChild<DataFileSyntaxHighlighter*>();
+    if ( highlighter && !waitUntil( [highlighter]() { return highlighter->isIdlePassComplete(); } ) )
+    {
+        *errorMessage = QString( "Timed out highlighting %1" ).arg( filePath );
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool EditingSessionReplayer::waitUntil( const std::function<bool()>& condition )
+{
+    QDeadlineTimer deadline( std::chrono::seconds( m_options.loadTimeoutSeconds ) );
+    while ( !condition() )
+    {
+        if ( deadline.hasExpired() )
+        {
+            return false;
+        }
+
+        QCoreApplication::processEvents( QEventLoop::AllEvents, 50 );
+        QThread::msleep( 1 );
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Deliver one event and return the time until the editor is repainted, or -1 if the event does not
+/// apply to the deck
+//--------------------------------------------------------------------------------------------------
+double EditingSessionReplayer::replayEvent( MainWindow& window, const EditingSessionEvent& event )
+{
+    RimDataDeckTextEditor* textEditor = window.m_textEditor;
+
+    // Keys go to the completer popup while it is visible, as they do for the user
+    auto keyTarget = [textEditor]() -> QWidget*
+    {
+        QAbstractItemView* popup = textEditor->completer() ? textEditor->completer()->popup() : nullptr;
+        if ( popup && popup->isVisible() ) return popup;
+        return textEditor;
+    };
+
+    // A sync parses on a worker thread, the events after it apply to the synced tree as they did
+    // when recorded. The parse is not part of the latency.
+    if ( !waitUntil( [&window]() { return !window.m_isSyncingTextToTree; } ) ) return -1.0;
+
+    // Resolve tree selections before the clock starts
+    caf::PdmObject* selectedObject = nullptr;
+    if ( event.type == EditingSessionEvent::Type::TREE_SELECTION )
+    {
+        if ( !m_dataDeck ) return -1.0;
+
+        if ( event.keywordIndex < 0 )
+        {
+            selectedObject = m_dataDeck.p();
+        }
+        else
+        {
+            const std::vector<RimDataKeyword*> keywords = m_dataDeck->keywordsInDeckOrder();
+            if ( event.keywordIndex >= static_cast<int>( keywords.size() ) ) return -1.0;
+
+            selectedObject = keywords[event.keywordIndex];
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    switch ( event.type )
+    {
+        case EditingSessionEvent::Type::KEY_PRESS:
+        {
+            const auto modifiers = Qt::KeyboardModifiers( event.modifiers );
+
+            QKeyEvent press( QEvent::KeyPress, event.key, modifiers, event.text );
+            QApplication::sendEvent( keyTarget(), &press );
+
+            QKeyEvent release( QEvent::KeyRelease, event.key, modifiers, event.text );
+            QApplication::sendEvent( keyTarget(), &release );
+            break;
+        }
+        case EditingSessionEvent::Type::CURSOR_MOVE:
+        {
+            QTextCursor cursor = textEditor->textCursor();
+            cursor.setPosition( std::clamp( event.position, 0, textEditor->document()->characterCount() - 1 ) );
+            textEditor->setTextCursor( cursor );
+            break;
+        }
+        case EditingSessionEvent::Type::TREE_SELECTION:
+            window.m_pdmUiTreeView->selectAsCurrentItem( selectedObject );
+            break;
+        case EditingSessionEvent::Type::SYNC_TEXT_TO_TREE:
+            window.slotSyncTextToTree();
+            break;
+        case EditingSessionEvent::Type::SYNC_TREE_TO_TEXT:
+            window.slotSyncTreeToText();
+            break;
+    }
+
+    // Include the work posted by the event and the repaint the user waits for
+    QCoreApplication::processEvents();
+    textEditor->viewport()->repaint();
+
+    return timer.nsecsElapsed() / 1.0e6;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void EditingSessionReplayer::closeModalDialogs()
+{
+    QWidget* dialog = QApplication::activeModalWidget();
+    if ( !dialog )
+    {
+        return;
+    }
+
+    QMessageBox* messageBox = qobject_cast<QMessageBox*>( dialog );
+    m_dialogMessages.append( messageBox ? messageBox->text() : dialog->windowTitle() );
+    dialog->close();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Nearest rank percentiles, the tail is what the user notices as lag
+//--------------------------------------------------------------------------------------------------
+QJsonObject EditingSessionReplayer::latencySummary( std::vector<double> timesMs )
+{
+    QJsonObject object;
+    object["count"] = static_cast<int>( timesMs.size() );
+    if ( timesMs.empty() )
+    {
+        return object;
+    }
+
+    std::sort( timesMs.begin(), timesMs.end() );
+
+    auto percentile = [&timesMs]( double p )
+    {
+        const size_t rank = static_cast<size_t>( std::ceil( p / 100.0 * timesMs.size() ) );
+        return timesMs[std::clamp<size_t>( rank, 1, timesMs.size() ) - 1];
+    };
+
+    object["p50Ms"]  = percentile( 50.0 );
+    object["p90Ms"]  = percentile( 90.0 );
+    object["p99Ms"]  = percentile( 99.0 );
+    object["maxMs"]  = timesMs.back();
+    object["meanMs"] = std::accumulate( timesMs.begin(), timesMs.end(), 0.0 ) / timesMs.size();
+    return object;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "DataDeck/EditingSession.h"
+
+#include "cafPdmPointer.h"
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <vector>
+
+class MainWindow;
+class RimDataDeck;
+
+//==================================================================================================
+/// Replays a recorded editing session against a deck in a headless main window, and writes the
+/// latency of each event type as percentiles in JSON.
+///
+/// An event is timed from delivery until the events it posted are processed and the editor is
+/// repainted, which covers the key handling, completer, highlighter and tree selection paths. By
+/// default the events are replayed back to back; in real time mode the recorded pauses are kept, so
+/// background work like highlighting and validation runs between events as it did for the user.
+//==================================================================================================
+class EditingSessionReplayer
+{
+public:
+    struct Options
+    {
+        QString sessionFilePath;
+        QString deckFilePath; // Overrides the deck recorded in the session
+        QString outputFilePath; // Standard output if empty
+        bool    realtime           = false;
+        int     loadTimeoutSeconds = 600;
+    };
+
+    explicit EditingSessionReplayer( const Options& options );
+
+    int run();
+
+private:
+    bool   openDeck( MainWindow& window, const QString& filePath, QString* errorMessage );
+    bool   waitUntil( const std::function<bool()>& condition );
+    double replayEvent( MainWindow& window, const EditingSessionEvent& event );
+    void   closeModalDialogs();
+
+    static QJsonObject latencySummary( std::vector<double> timesMs );
+
+private:
+    Options                      m_options;
+    caf::PdmPointer<RimDataDeck> m_dataDeck;
+    QStringList                  m_dialogMessages;
+};
@@ -0,0 +1,70 @@
+#include "EditingSessionReplayer.h"
+
+#include "DataDeck/DataDeckValidator.h"
+
+#include "cafCmdFeatureManager.h"
+#include "cafFactory.h"
+#include "cafPdmDefaultObjectFactory.h"
+#include "cafPdmUiFieldEditorHandle.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+
+#include <cstdio>
+
+int main( int argc, char* argv[] )
+{
+    // The replay drives the real main window, but never shows it on a display
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+    {
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    }
+
+    DataDeckValidator::registerLogBackend();
+
+    auto exitCode = 0;
+    {
+        QApplication app( argc, argv );
+
+        QCommandLineParser parser;
+        parser.setApplicationDescription( "Replays a recorded editing session and writes the latency of each event type as JSON." );
+        parser.addHelpOption();
+        parser.addPositionalArgument( "session", "Editing session recorded with Tools > Record Editing Session." );
+        parser.addOption( QCommandLineOption( "deck", "Replay on this DATA file instead of the recorded one.", "file" ) );
+        parser.addOption( QCommandLineOption( "realtime", "Keep the recorded pauses between events." ) );
+        parser.addOption( QCommandLineOption( { "o", "output" }, "Write the JSON result to this file instead of stdout.", "file" ) );
+        parser.addOption( QCommandLineOption( "timeout", "Seconds to wait for the deck to load, default 600.", "seconds", "600" ) );
+        parser.process( app );
+
+        if ( parser.positionalArguments().size() != 1 )
+        {
+            std::fprintf( stderr, "%s", qPrintable( parser.helpText() ) );
+            return 2;
+        }
+
+        caf::CmdFeatureManager::createSingleton();
+
+        EditingSessionReplayer::Options options;
+        options.sessionFilePath    = parser.positionalArguments().front();
+        options.deckFilePath       = parser.value( "deck" );
+        options.outputFilePath     = parser.value( "output" );
+        options.realtime           = parser.isSet( "realtime" );
+        options.loadTimeoutSeconds = parser.value( "timeout" ).toInt();
+
+        EditingSessionReplayer replayer( options );
+        exitCode = replayer.run();
+    }
+
+    caf::CmdFeatureManager::deleteSingleton();
+    caf::PdmDefaultObjectFactory::deleteSingleton();
+    {
+        auto factory = caf::Factory<caf::PdmUiFieldEditorHandle, QString>::instance();
+        factory->deleteCreatorObjects();
+    }
+    {
+        auto factory = caf::Factory<caf::CmdFeature, std::string>::instance();
+        factory->deleteCreatorObjects();
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,445 @@
+#include "SyntheticDeckGenerator.h"
+
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr int    VALUES_PER_LINE = 8;
+constexpr int    MAX_REPEAT      = 16;
+constexpr size_t BUFFER_SIZE     = size_t( 1 ) << 22;
+
+//==================================================================================================
+/// Buffered file output. Numbers are formatted into the buffer directly, without temporary strings.
+//==================================================================================================
+class StreamWriter
+{
+public:
+    explicit StreamWriter( const QString& filePath )
+        : m_file( filePath )
+        , m_bytesWritten( 0 )
+    {
+        m_buffer.reserve( BUFFER_SIZE );
+    }
+
+    bool open() { return m_file.open( QIODevice::WriteOnly | QIODevice::Truncate ); }
+
+    void write( std::string_view text )
+    {
+        if ( m_buffer.size() + text.size() > BUFFER_SIZE ) flush();
+        m_buffer.insert( m_buffer.end(), text.begin(), text.end() );
+    }
+
+    void write( const char* text ) { write( std::string_view( text ) ); }
+    void write( const QString& text ) { write( std::string_view( text.toStdString() ) ); }
+
+    void writeInt( qint64 value )
+    {
+        char buffer[24];
+        auto [end, error] = std::to_chars( buffer, buffer + sizeof( buffer ), value );
+        write( std::string_view( buffer, end - buffer ) );
+    }
+
+    void writeDouble( double value, int decimals )
+    {
+        char buffer[48];
+        auto [end, error] = std::to_chars( buffer, buffer + sizeof( buffer ), value, std::chars_format::fixed, decimals );
+        write( std::string_view( buffer, end - buffer ) );
+    }
+
+    bool close()
+    {
+        flush();
+        m_file.close();
+        return m_file.error() == QFileDevice::NoError;
+    }
+
+    qint64  bytesWritten() const { return m_bytesWritten + static_cast<qint64>( m_buffer.size() ); }
+    QString errorString() const { return m_file.errorString(); }
+
+private:
+    void flush()
+    {
+        if ( m_buffer.empty() ) return;
+        m_file.write( m_buffer.data(), static_cast<qint64>( m_buffer.size() ) );
+        m_bytesWritten += static_cast<qint64>( m_buffer.size() );
+        m_buffer.clear();
+    }
+
+private:
+    QFile             m_file;
+    std::vector<char> m_buffer;
+    qint64            m_bytesWritten;
+};
+
+//==================================================================================================
+/// A grid array and how to draw its values
+//==================================================================================================
+struct ArrayDefinition
+{
+    const char*                             keyword;
+    int                                     decimals; // -1 for integer arrays
+    std::function<double( std::mt19937_64& )> value;
+};
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<ArrayDefinition> gridArrays()
+{
+    auto uniform = []( std::mt19937_64& random ) { return std::uniform_real_distribution<double>( 0.0, 1.0 )( random ); };
+
+    return {
+        { "PORO", 4, [uniform]( std::mt19937_64& random ) { return 0.05 + 0.3 * uniform( random ); } },
+        { "NTG", 3, [uniform]( std::mt19937_64& random ) { return 0.5 + 0.5 * uniform( random ); } },
+        { "PERMX", 2, [uniform]( std::mt19937_64& random ) { return std::exp( 1.0 + 5.0 * uniform( random ) ); } },
+        { "PERMY", 2, [uniform]( std::mt19937_64& random ) { return std::exp( 1.0 + 5.0 * uniform( random ) ); } },
+        { "PERMZ", 3, [uniform]( std::mt19937_64& random ) { return 0.1 * std::exp( 1.0 + 5.0 * uniform( random ) ); } },
+        { "ACTNUM", -1, [uniform]( std::mt19937_64& random ) { return uniform( random ) < 0.02 ? 0.0 : 1.0; } },
+    };
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void writeComment( StreamWriter& writer, std::mt19937_64& random, double density )
+{
+    if ( density > 0.0 && std::uniform_real_distribution<double>( 0.0, 1.0 )( random ) < density )
+    {
+        writer.write( "-- Synthetic comment line, ignored by the parser\n" );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Write one value per cell, VALUES_PER_LINE tokens per line. Runs of equal values are written as
+/// repeat counts with the probability given by the repeat density.
+//--------------------------------------------------------------------------------------------------
+void writeArray( StreamWriter& writer, std::mt19937_64& random, const ArrayDefinition& array, qint64 count, const SyntheticDeckGenerator::Parameters& parameters )
+{
+    std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+    std::uniform_int_distribution<int>     runLength( 2, MAX_REPEAT );
+
+    writer.write( array.keyword );
+    writer.write( "\n" );
+
+    int tokensOnLine = 0;
+    for ( qint64 i = 0; i < count; )
+    {
+        qint64 repeat = 1;
+        if ( parameters.repeatDensity > 0.0 && uniform( random ) < parameters.repeatDensity )
+        {
+            repeat = std::min<qint64>( runLength( random ), count - i );
+        }
+
+        writer.write( " " );
+        if ( repeat > 1 )
+        {
+            writer.writeInt( repeat );
+            writer.write( "*" );
+        }
+
+        const double value = array.value( random );
+        if ( array.decimals < 0 )
+        {
+            writer.writeInt( static_cast<qint64>( value ) );
+        }
+        else
+        {
+            writer.writeDouble( value, array.decimals );
+        }
+
+        i += repeat;
+        if ( ++tokensOnLine == VALUES_PER_LINE && i < count )
+        {
+            writer.write( "\n" );
+            writeComment( writer, random, parameters.commentDensity );
+            tokensOnLine = 0;
+        }
+    }
+    writer.write( " /\n\n" );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString includeFileName( const SyntheticDeckGenerator::Parameters& parameters, int level )
+{
+    return QString( "%1_GRID_%2.INC" ).arg( parameters.baseName ).arg( level );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void writeInclude( StreamWriter& writer, const QString& fileName )
+{
+    writer.write( "INCLUDE\n '" );
+    writer.write( fileName );
+    writer.write( "' /\n\n" );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool closeWriter( StreamWriter& writer, SyntheticDeckGenerator::Result& result, const QString& filePath )
+{
+    result.bytesWritten += writer.bytesWritten();
+    if ( !writer.close() )
+    {
+        result.errorMessage = QString( "Could not write %1: %2" ).arg( filePath ).arg( writer.errorString() );
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void writeRunspec( StreamWriter& writer, const SyntheticDeckGenerator::Parameters& parameters )
+{
+    writer.write( "RUNSPEC\n\nTITLE\n Synthetic deck " );
+    writer.write( parameters.baseName );
+    writer.write( "\n\nDIMENS\n " );
+    writer.writeInt( parameters.nx );
+    writer.write( " " );
+    writer.writeInt( parameters.ny );
+    writer.write( " " );
+    writer.writeInt( parameters.nz );
+    writer.write( " /\n\nOIL\n\nWATER\n\nMETRIC\n\nSTART\n 1 'JAN' 2020 /\n\n" );
+
+    writer.write( "WELLDIMS\n " );
+    writer.writeInt( std::max( 1, parameters.wellCount ) );
+    writer.write( " " );
+    writer.writeInt( std::max( 1, parameters.completionsPerWell ) );
+    writer.write( " 1 " );
+    writer.writeInt( std::max( 1, parameters.wellCount ) );
+    writer.write( " /\n\nTABDIMS\n 1 1 20 20 /\n\nEQLDIMS\n 1 /\n\n" );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void writeSchedule( StreamWriter& writer, std::mt19937_64& random, const SyntheticDeckGenerator::Parameters& parameters )
+{
+    auto isInjector = []( int well ) { return well % 4 == 3; };
+    auto wellName   = []( int well ) { return QString( "W%1" ).arg( well + 1 ); };
+    auto wellI      = [&parameters]( int well ) { return 1 + static_cast<int>( ( qint64( well ) * 7919 ) % parameters.nx ); };
+    auto wellJ      = [&parameters]( int well ) { return 1 + static_cast<int>( ( qint64( well ) * 104729 ) % parameters.ny ); };
+
+    writer.write( "SCHEDULE\n\n" );
+    if ( parameters.wellCount <= 0 )
+    {
+        writer.write( "TSTEP\n " );
+        writer.writeInt( std::max( 1, parameters.reportSteps ) );
+        writer.write( "*30 /\n\nEND\n" );
+        return;
+    }
+
+    writer.write( "WELSPECS\n" );
+    for ( int well = 0; well < parameters.wellCount; ++well )
+    {
+        writer.write( " '" + wellName( well ) + "' 'G1' " );
+        writer.writeInt( wellI( well ) );
+        writer.write( " " );
+        writer.writeInt( wellJ( well ) );
+        writer.write( isInjector( well ) ? " 1* 'WATER' /\n" : " 1* 'OIL' /\n" );
+    }
+    writer.write( "/\n\nCOMPDAT\n" );
+    for ( int well = 0; well < parameters.wellCount; ++well )
+    {
+        for ( int row = 0; row < std::max( 1, parameters.completionsPerWell ); ++row )
+        {
+            const int k = 1 + row % parameters.nz;
+            writer.write( " '" + wellName( well ) + "' 2* " );
+            writer.writeInt( k );
+            writer.write( " " );
+            writer.writeInt( k );
+            writer.write( " 'OPEN' /\n" );
+            writeComment( writer, random, parameters.commentDensity );
+        }
+    }
+    writer.write( "/\n\n" );
+
+    std::uniform_real_distribution<double> rate( 100.0, 2000.0 );
+    for ( int step = 0; step < std::max( 1, parameters.reportSteps ); ++step )
+    {
+        if ( step % 10 == 0 )
+        {
+            writer.write( "WCONPROD\n" );
+            for ( int well = 0; well < parameters.wellCount; ++well )
+            {
+                if ( isInjector( well ) ) continue;
+                writer.write( " '" + wellName( well ) + "' 'OPEN' 'ORAT' " );
+                writer.writeDouble( rate( random ), 1 );
+                writer.write( " /\n" );
+            }
+            writer.write( "/\n\nWCONINJE\n" );
+            for ( int well = 0; well < parameters.wellCount; ++well )
+            {
+                if ( !isInjector( well ) ) continue;
+                writer.write( " '" + wellName( well ) + "' 'WATER' 'OPEN' 'RATE' " );
+                writer.writeDouble( rate( random ), 1 );
+                writer.write( " /\n" );
+            }
+            writer.write( "/\n\n" );
+        }
+        writer.write( "TSTEP\n 30 /\n\n" );
+    }
+    writer.write( "END\n" );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+/// About eight bytes per double value and two per integer value, less for repeated values
+//--------------------------------------------------------------------------------------------------
+double SyntheticDeckGenerator::Parameters::bytesPerCell() const
+{
+    return ( 5 * 8.0 + 2.0 ) * ( 1.0 - 0.8 * std::clamp( repeatDensity, 0.0, 1.0 ) ) + 6.0 * commentDensity;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 SyntheticDeckGenerator::Parameters::estimatedBytes() const
+{
+    return static_cast<qint64>( bytesPerCell() * cellCount() ) + 200 * qint64( wellCount ) * std::max( 1, completionsPerWell ) +
+           20 * qint64( reportSteps );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+SyntheticDeckGenerator::Parameters SyntheticDeckGenerator::forTargetSize( qint64 bytes, const Parameters& parameters )
+{
+    Parameters   sized = parameters;
+    const double cells = std::max( 1.0, bytes / sized.bytesPerCell() );
+
+    // Reservoir grids are flat, use at most 100 layers
+    sized.nz = std::clamp( static_cast<int>( std::cbrt( cells ) / 2.0 ), 1, 100 );
+    sized.nx = sized.ny = std::max( 1, static_cast<int>( std::sqrt( cells / sized.nz ) ) );
+    return sized;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 SyntheticDeckGenerator::parseByteSize( const QString& text )
+{
+    static const QRegularExpression pattern( "^\\s*(\\d+(?:\\.\\d+)?)\\s*([KMG]?)B?\\s*$", QRegularExpression::CaseInsensitiveOption );
+
+    const QRegularExpressionMatch match = pattern.match( text );
+    if ( !match.hasMatch() ) return -1;
+
+    const QString unit       = match.captured( 2 ).toUpper();
+    const double  multiplier = unit == "K" ? 1024.0 : unit == "M" ? 1024.0 * 1024.0 : unit == "G" ? 1024.0 * 1024.0 * 1024.0 : 1.0;
+    return static_cast<qint64>( match.captured( 1 ).toDouble() * multiplier );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The grid arrays go into a chain of include files, each level holds one array and includes the
+/// next level. The last level holds the remaining arrays.
+//--------------------------------------------------------------------------------------------------
+SyntheticDeckGenerator::Result SyntheticDeckGenerator::generate( const QString& directory, const Parameters& parameters )
+{
+    Result result;
+
+    if ( parameters.nx <= 0 || parameters.ny <= 0 || parameters.nz <= 0 )
+    {
+        result.errorMessage = "The grid dimensions must be positive";
+        return result;
+    }
+    if ( !QDir().mkpath( directory ) )
+    {
+        result.errorMessage = QString( "Could not create %1" ).arg( directory );
+        return result;
+    }
+
+    std::mt19937_64              random( parameters.seed );
+    std::vector<ArrayDefinition> arrays    = gridArrays();
+    const qint64                 cellCount = parameters.cellCount();
+    size_t                       nextArray = 0;
+
+    for ( int level = 1; level <= parameters.includeDepth; ++level )
+    {
+        const QString filePath = QDir( directory ).filePath( includeFileName( parameters, level ) );
+        StreamWriter  writer( filePath );
+        if ( !writer.open() )
+        {
+            result.errorMessage = QString( "Could not create %1" ).arg( filePath );
+            return result;
+        }
+
+        writer.write( QString( "-- Include level %1 of %2\n\n" ).arg( level ).arg( parameters.includeDepth ) );
+        const bool isLastLevel = level == parameters.includeDepth;
+        while ( nextArray < arrays.size() && ( isLastLevel || nextArray < static_cast<size_t>( level ) ) )
+        {
+            writeArray( writer, random, arrays[nextArray++], cellCount, parameters );
+        }
+        if ( !isLastLevel )
+        {
+            writeInclude( writer, includeFileName( parameters, level + 1 ) );
+        }
+
+        if ( !closeWriter( writer, result, filePath ) ) return result;
+        result.includeFilePaths.append( filePath );
+    }
+
+    result.filePath = QDir( directory ).filePath( parameters.baseName + ".DATA" );
+    StreamWriter writer( result.filePath );
+    if ( !writer.open() )
+    {
+        result.errorMessage = QString( "Could not create %1" ).arg( result.filePath );
+        return result;
+    }
+
+    writer.write( "-- Synthetic deck written by SyntheticDeckGenerator\n" );
+    writer.write( QString( "-- Seed %1, repeat density %2, comment density %3\n\n" )
+                      .arg( parameters.seed )
+                      .arg( parameters.repeatDensity )
+                      .arg( parameters.commentDensity ) );
+
+    writeRunspec( writer, parameters );
+
+    writer.write( "GRID\n\nDX\n " );
+    writer.writeInt( cellCount );
+    writer.write( "*100 /\n\nDY\n " );
+    writer.writeInt( cellCount );
+    writer.write( "*100 /\n\nDZ\n " );
+    writer.writeInt( cellCount );
+    writer.write( "*5 /\n\nTOPS\n " );
+    writer.writeInt( qint64( parameters.nx ) * parameters.ny );
+    writer.write( "*2000 /\n\n" );
+
+    if ( parameters.includeDepth > 0 )
+    {
+        writeInclude( writer, includeFileName( parameters, 1 ) );
+    }
+    while ( nextArray < arrays.size() )
+    {
+        writeArray( writer, random, arrays[nextArray++], cellCount, parameters );
+    }
+
+    writer.write( "PROPS\n\nSWOF\n 0.2 0.0 1.0 0.0\n 0.6 0.3 0.2 0.0\n 1.0 1.0 0.0 0.0 /\n\n" );
+    writer.write( "PVTW\n 200 1.0 4.0E-5 0.5 0.0 /\n\nPVDO\n 100 1.05 1.0\n 300 1.02 1.1 /\n\n" );
+    writer.write( "DENSITY\n 850 1000 1.0 /\n\nROCK\n 200 4.0E-5 /\n\n" );
+
+    writer.write( "REGIONS\n\nSATNUM\n " );
+    writer.writeInt( cellCount );
+    writer.write( "*1 /\n\n" );
+
+    writer.write( "SOLUTION\n\nEQUIL\n 2000 200 2100 0 1500 0 /\n\n" );
+    writer.write( "SUMMARY\n\nFOPR\n\nFWPR\n\nFWIR\n\nFPR\n\nWBHP\n/\n\n" );
+
+    writeSchedule( writer, random, parameters );
+
+    closeWriter( writer, result, result.filePath );
+    return result;
+}
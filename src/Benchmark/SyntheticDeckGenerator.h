@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+//==================================================================================================
+/// Writes valid, reproducible Eclipse decks of any size from a few parameters, for benchmarks and
+/// stress tests of the load, highlight and sync paths without production data.
+///
+/// The grid arrays are streamed through a large buffer and the numbers are formatted with
+/// std::to_chars, so even decks of several GB are written at close to disk speed. The same
+/// parameters and seed always give the same files.
+//==================================================================================================
+class SyntheticDeckGenerator
+{
+public:
+    struct Parameters
+    {
+        QString baseName = "SYNTHETIC";
+        int     nx       = 10;
+        int     ny       = 10;
+        int     nz       = 10;
+
+        int wellCount          = 4;
+        int completionsPerWell = 1; // COMPDAT rows per well
+        int reportSteps        = 12;
+        int includeDepth       = 1; // Nesting depth of the grid array includes, 0 writes one file
+
+        double repeatDensity  = 0.1; // Fraction of values written as repeat counts like 12*0.25
+        double commentDensity = 0.05; // Probability of a comment line after each data line
+
+        quint64 seed = 1;
+
+        qint64 cellCount() const { return qint64( nx ) * ny * nz; }
+        double bytesPerCell() const;
+        qint64 estimatedBytes() const;
+    };
+
+    struct Result
+    {
+        QString     filePath; // The DATA file
+        QStringList includeFilePaths;
+        qint64      bytesWritten = 0;
+        QString     errorMessage;
+
+        bool success() const { return errorMessage.isEmpty(); }
+    };
+
+    static Result generate( const QString& directory, const Parameters& parameters );
+
+    // Grid dimensions giving a deck of roughly the given size, other parameters are kept
+    static Parameters forTargetSize( qint64 bytes, const Parameters& parameters = Parameters() );
+
+    // Parse sizes like "512K", "20M" or "10G", returns -1 if invalid
+    static qint64 parseByteSize( const QString& text );
+};
@@ -0,0 +1,74 @@
+#include "DataDeckBenchmark.h"
+
+#include "DataDeck/DataDeckValidator.h"
+
+#include "cafPdmDefaultObjectFactory.h"
+
+#include <QCommandLineParser>
+#include <QGuiApplication>
+
+#include <algorithm>
+#include <cstdio>
+
+int main( int argc, char* argv[] )
+{
+    // The highlighting stage needs a GUI application for fonts, but never opens a window
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+    {
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    }
+
+    DataDeckValidator::registerLogBackend();
+
+    auto exitCode = 0;
+    {
+        QGuiApplication app( argc, argv );
+
+        QCommandLineParser parser;
+        parser.setApplicationDescription( "Times each stage of the DATA deck pipeline and writes the results as JSON." );
+        parser.addHelpOption();
+        parser.addOption( QCommandLineOption( "sizes",
+                                              "Comma separated deck sizes to run: small, medium, large. Default all.",
+                                              "sizes" ) );
+        parser.addOption( QCommandLineOption( "stages",
+                                              QString( "Comma separated stages to run: %1. Default all." )
+                                                  .arg( DataDeckBenchmark::stageNames().join( ", " ) ),
+                                              "stages" ) );
+        parser.addOption( QCommandLineOption( { "n", "iterations" }, "Iterations per stage, default 5.", "count", "5" ) );
+        parser.addOption( QCommandLineOption( { "o", "output" }, "Write the JSON result to this file instead of stdout.", "file" ) );
+        parser.addOption( QCommandLineOption( "work-dir", "Directory for the generated decks, default a temporary directory.", "directory" ) );
+        parser.addOption( QCommandLineOption( "baseline", "Compare the results with this baseline file and fail on regressions.", "file" ) );
+        parser.addOption( QCommandLineOption( "update-baseline", "Write the results to the baseline file instead of comparing." ) );
+        parser.addOption(
+            QCommandLineOption( "allow-missing-baseline", "Exit with 77 (skipped) instead of failing for stages without a baseline." ) );
+        parser.addOption( QCommandLineOption( "time-tolerance", "Allowed relative slowdown of a stage, default 0.25.", "fraction", "0.25" ) );
+        parser.addOption( QCommandLineOption( "memory-tolerance", "Allowed relative increase of the peak memory, default 0.20.", "fraction", "0.20" ) );
+        parser.process( app );
+
+        if ( parser.isSet( "update-baseline" ) && !parser.isSet( "baseline" ) )
+        {
+            std::fprintf( stderr, "--update-baseline needs --baseline\n" );
+            return DataDeckBenchmark::EXIT_FAILED;
+        }
+
+        DataDeckBenchmark::Options options;
+        if ( parser.isSet( "sizes" ) ) options.sizeNames = parser.value( "sizes" ).split( ',', Qt::SkipEmptyParts );
+        if ( parser.isSet( "stages" ) ) options.stageNames = parser.value( "stages" ).split( ',', Qt::SkipEmptyParts );
+        options.iterations     = std::max( 1, parser.value( "iterations" ).toInt() );
+        options.outputFilePath = parser.value( "output" );
+        options.workDirectory  = parser.value( "work-dir" );
+
+        options.baselineFilePath     = parser.value( "baseline" );
+        options.updateBaseline       = parser.isSet( "update-baseline" );
+        options.allowMissingBaseline = parser.isSet( "allow-missing-baseline" );
+        options.tolerances.time      = parser.value( "time-tolerance" ).toDouble();
+        options.tolerances.memory    = parser.value( "memory-tolerance" ).toDouble();
+
+        DataDeckBenchmark benchmark( options );
+        exitCode = benchmark.run();
+    }
+
+    caf::PdmDefaultObjectFactory::deleteSingleton();
+
+    return exitCode;
+}
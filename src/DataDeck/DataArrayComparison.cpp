@@ -0,0 +1,244 @@
+#include "DataArrayComparison.h"
+
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// Values per parallel work item when the array is not compared layer by layer
+constexpr size_t CHUNK_SIZE = size_t( 1 ) << 20;
+
+struct LayerResult
+{
+    DataArrayKernels::DeltaStats stats; // Offsets in the whole array
+    int                          i1 = 0, i2 = 0, j1 = 0, j2 = 0; // Changed cells, relative to the layer
+};
+
+//--------------------------------------------------------------------------------------------------
+/// Compare one K layer row by row, the rows give the J range and the first and last changed value
+/// of each row give the I range
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+LayerResult compareLayer( const T* base, const T* other, int sizeI, int sizeJ, qint64 layerOffset, const DataArrayComparison::Tolerance& tolerance )
+{
+    LayerResult layer;
+    bool        hasChanges = false;
+
+    for ( int j = 0; j < sizeJ; ++j )
+    {
+        const qint64 rowOffset = layerOffset + qint64( j ) * sizeI;
+        const auto   row = DataArrayKernels::compareValues( base + rowOffset, other + rowOffset, sizeI, tolerance.absolute, tolerance.relative );
+        if ( row.changedCount == 0 ) continue;
+
+        layer.stats.merge( row, rowOffset );
+
+        const int firstI = static_cast<int>( row.firstChanged );
+        const int lastI  = static_cast<int>( row.lastChanged );
+        if ( !hasChanges )
+        {
+            layer.i1 = firstI;
+            layer.i2 = lastI;
+            layer.j1 = j;
+            hasChanges = true;
+        }
+        layer.i1 = std::min( layer.i1, firstI );
+        layer.i2 = std::max( layer.i2, lastI );
+        layer.j2 = j;
+    }
+
+    return layer;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+DataArrayComparison::Result compareData( const std::vector<T>&                 base,
+                                         const std::vector<T>&                 other,
+                                         const DataDeckGridChecker::GridArray& shape,
+                                         bool                                  isCellArray,
+                                         const DataArrayComparison::Tolerance& tolerance )
+{
+    DataArrayComparison::Result result;
+    result.valueCount = static_cast<qint64>( base.size() );
+
+    const int    firstI = shape.box ? shape.box->i1 : 1;
+    const int    firstJ = shape.box ? shape.box->j1 : 1;
+    const int    firstK = shape.box ? shape.box->k1 : 1;
+    const int    sizeI  = shape.box ? shape.box->i2 - shape.box->i1 + 1 : shape.nx;
+    const int    sizeJ  = shape.box ? shape.box->j2 - shape.box->j1 + 1 : shape.ny;
+    const int    sizeK  = shape.box ? shape.box->k2 - shape.box->k1 + 1 : shape.nz;
+    const qint64 layerSize = qint64( sizeI ) * sizeJ;
+
+    if ( !isCellArray || sizeI <= 0 || sizeJ <= 0 || layerSize * sizeK != result.valueCount )
+    {
+        // Not one value per cell, compare in flat chunks without regions
+        std::vector<size_t> chunkStarts;
+        for ( size_t begin = 0; begin < base.size(); begin += CHUNK_SIZE )
+        {
+            chunkStarts.push_back( begin );
+        }
+
+        auto compareChunk = [&base, &other, &tolerance]( size_t begin )
+        {
+            const size_t count = std::min( CHUNK_SIZE, base.size() - begin );
+            return DataArrayKernels::compareValues( base.data() + begin, other.data() + begin, count, tolerance.absolute, tolerance.relative );
+        };
+
+        const auto chunks = QtConcurrent::blockingMapped<std::vector<DataArrayKernels::DeltaStats>>( chunkStarts, compareChunk );
+        for ( size_t i = 0; i < chunks.size(); ++i )
+        {
+            result.stats.merge( chunks[i], static_cast<qint64>( chunkStarts[i] ) );
+        }
+        if ( result.stats.maxAbsDeltaOffset >= 0 )
+        {
+            result.maxAbsDeltaLocation = QString( "value %1" ).arg( result.stats.maxAbsDeltaOffset + 1 );
+        }
+        return result;
+    }
+
+    std::vector<int> layers( sizeK );
+    std::iota( layers.begin(), layers.end(), 0 );
+
+    auto compareOne = [&base, &other, &tolerance, sizeI, sizeJ, layerSize]( int k )
+    { return compareLayer( base.data(), other.data(), sizeI, sizeJ, k * layerSize, tolerance ); };
+
+    const std::vector<LayerResult> layerResults = QtConcurrent::blockingMapped<std::vector<LayerResult>>( layers, compareOne );
+
+    for ( int k = 0; k < sizeK; ++k )
+    {
+        const LayerResult& layer = layerResults[k];
+        if ( layer.stats.changedCount == 0 ) continue;
+
+        result.stats.merge( layer.stats, 0 );
+
+        DataArrayComparison::Region region;
+        region.i1           = firstI + layer.i1;
+        region.i2           = firstI + layer.i2;
+        region.j1           = firstJ + layer.j1;
+        region.j2           = firstJ + layer.j2;
+        region.k1           = firstK + k;
+        region.k2           = firstK + k;
+        region.changedCount = layer.stats.changedCount;
+
+        // Extend the previous region if the layer above has the same footprint
+        if ( !result.regions.isEmpty() )
+        {
+            DataArrayComparison::Region& previous = result.regions.last();
+            if ( previous.k2 == region.k1 - 1 && previous.i1 == region.i1 && previous.i2 == region.i2 && previous.j1 == region.j1 &&
+                 previous.j2 == region.j2 )
+            {
+                previous.k2 = region.k2;
+                previous.changedCount += region.changedCount;
+                continue;
+            }
+        }
+
+        if ( result.regions.size() >= DataArrayComparison::MAX_REGIONS )
+        {
+            result.regionsTruncated = true;
+            continue;
+        }
+        result.regions.append( region );
+    }
+
+    if ( result.stats.maxAbsDeltaOffset >= 0 )
+    {
+        result.maxAbsDeltaLocation = shape.cellText( result.stats.maxAbsDeltaOffset );
+    }
+
+    return result;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataArrayComparison::Result::toText() const
+{
+    if ( !isValid() )
+    {
+        return errorMessage;
+    }
+
+    QStringList lines;
+
+    const double changedPercent = valueCount > 0 ? 100.0 * stats.changedCount / valueCount : 0.0;
+    lines.append( QString( "%1 of %2 values changed (%3%)" ).arg( stats.changedCount ).arg( valueCount ).arg( changedPercent, 0, 'g', 3 ) );
+
+    if ( stats.changedCount > 0 )
+    {
+        lines.append( QString( "Max |delta|: %1 at %2" ).arg( stats.maxAbsDelta, 0, 'g', 6 ).arg( maxAbsDeltaLocation ) );
+        lines.append( QString( "Mean delta: %1, mean |delta|: %2 (changed values)" )
+                          .arg( stats.sumDelta / stats.changedCount, 0, 'g', 6 )
+                          .arg( stats.sumAbsDelta / stats.changedCount, 0, 'g', 6 ) );
+    }
+
+    if ( !regions.isEmpty() )
+    {
+        lines.append( "Changed regions:" );
+        for ( const Region& region : regions )
+        {
+            lines.append( QString( "  I %1-%2  J %3-%4  K %5-%6  (%7 changed)" )
+                              .arg( region.i1 )
+                              .arg( region.i2 )
+                              .arg( region.j1 )
+                              .arg( region.j2 )
+                              .arg( region.k1 )
+                              .arg( region.k2 )
+                              .arg( region.changedCount ) );
+        }
+        if ( regionsTruncated )
+        {
+            lines.append( QString( "  ... more regions not listed" ) );
+        }
+    }
+
+    return lines.join( "\n" );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataArrayComparison::Result DataArrayComparison::compare( const Opm::DeckKeyword&                base,
+                                                          const Opm::DeckKeyword&                other,
+                                                          const DataDeckGridChecker::GridArray& shape,
+                                                          const Tolerance&                       tolerance )
+{
+    Result result;
+
+    if ( !base.isDataKeyword() || !other.isDataKeyword() )
+    {
+        result.errorMessage = "Only data arrays can be compared value by value";
+        return result;
+    }
+
+    const Opm::DeckItem& baseItem  = base.getDataRecord().getDataItem();
+    const Opm::DeckItem& otherItem = other.getDataRecord().getDataItem();
+
+    if ( baseItem.getType() != otherItem.getType() || baseItem.data_size() != otherItem.data_size() )
+    {
+        result.errorMessage = QString( "The arrays have different shapes: %1 and %2 values" ).arg( baseItem.data_size() ).arg( otherItem.data_size() );
+        return result;
+    }
+
+    const bool isCellArray = base.name() != "COORD" && base.name() != "ZCORN";
+
+    switch ( baseItem.getType() )
+    {
+        case Opm::type_tag::integer:
+            return compareData( baseItem.getData<int>(), otherItem.getData<int>(), shape, isCellArray, tolerance );
+        case Opm::type_tag::fdouble:
+            return compareData( baseItem.getData<double>(), otherItem.getData<double>(), shape, isCellArray, tolerance );
+        default:
+            result.errorMessage = "Only numeric arrays can be compared value by value";
+            return result;
+    }
+}
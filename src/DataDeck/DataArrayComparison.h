@@ -0,0 +1,57 @@
+#pragma once
+
+#include "DataArrayKernels.h"
+#include "DataDeckGridChecker.h"
+
+#include <QList>
+#include <QString>
+
+namespace Opm
+{
+class DeckKeyword;
+}
+
+//==================================================================================================
+/// Cell-wise comparison of two grid arrays of the same shape, like PERMX from two history match
+/// iterations.
+///
+/// The arrays are read directly from the parsed data items. Each K layer is compared row by row with
+/// the DataArrayKernels in parallel, and only the statistics and a bounding box per layer are kept,
+/// so memory use does not grow with the array size. Layers with the same bounding box are merged into
+/// one changed region.
+//==================================================================================================
+class DataArrayComparison
+{
+public:
+    struct Tolerance
+    {
+        double absolute = 0.0;
+        double relative = 0.0;
+    };
+
+    struct Region
+    {
+        int    i1 = 0, i2 = 0, j1 = 0, j2 = 0, k1 = 0, k2 = 0; // 1-based, inclusive
+        qint64 changedCount = 0;
+    };
+
+    struct Result
+    {
+        QString                      errorMessage; // Set if the arrays cannot be compared
+        qint64                       valueCount = 0;
+        DataArrayKernels::DeltaStats stats;
+        QString                      maxAbsDeltaLocation;
+        QList<Region>                regions; // Empty if the array is not one value per cell
+        bool                         regionsTruncated = false;
+
+        bool    isValid() const { return errorMessage.isEmpty(); }
+        QString toText() const;
+    };
+
+    static constexpr int MAX_REGIONS = 200;
+
+    static Result compare( const Opm::DeckKeyword&                base,
+                           const Opm::DeckKeyword&                other,
+                           const DataDeckGridChecker::GridArray& shape,
+                           const Tolerance&                       tolerance );
+};
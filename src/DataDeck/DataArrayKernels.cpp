@@ -0,0 +1,261 @@
+#include "DataArrayKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define DATA_ARRAY_KERNELS_SSE2
+#endif
+
+namespace DataArrayKernels
+{
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+RangeCounts& RangeCounts::operator+=( const RangeCounts& other )
+{
+    below += other.below;
+    above += other.above;
+    nonFinite += other.nonFinite;
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+RangeCounts countOutOfRange( const double* values, size_t count, double minValue, double maxValue )
+{
+    RangeCounts counts;
+    size_t      i = 0;
+
+#ifdef DATA_ARRAY_KERNELS_SSE2
+    // Compare masks are all ones per lane, subtracting them counts the hits per lane
+    const __m128d absMask  = _mm_castsi128_pd( _mm_set1_epi64x( 0x7fffffffffffffffLL ) );
+    const __m128d infinity = _mm_set1_pd( std::numeric_limits<double>::infinity() );
+    const __m128d minV     = _mm_set1_pd( minValue );
+    const __m128d maxV     = _mm_set1_pd( maxValue );
+
+    __m128i belowAcc  = _mm_setzero_si128();
+    __m128i aboveAcc  = _mm_setzero_si128();
+    __m128i finiteAcc = _mm_setzero_si128();
+
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const __m128d v      = _mm_loadu_pd( values + i );
+        const __m128d finite = _mm_cmplt_pd( _mm_and_pd( v, absMask ), infinity ); // False for NaN and Inf
+        const __m128d below  = _mm_and_pd( _mm_cmplt_pd( v, minV ), finite );
+        const __m128d above  = _mm_and_pd( _mm_cmpgt_pd( v, maxV ), finite );
+
+        belowAcc  = _mm_sub_epi64( belowAcc, _mm_castpd_si128( below ) );
+        aboveAcc  = _mm_sub_epi64( aboveAcc, _mm_castpd_si128( above ) );
+        finiteAcc = _mm_sub_epi64( finiteAcc, _mm_castpd_si128( finite ) );
+    }
+
+    alignas( 16 ) qint64 lanes[2];
+
+    _mm_store_si128( reinterpret_cast<__m128i*>( lanes ), belowAcc );
+    counts.below = lanes[0] + lanes[1];
+    _mm_store_si128( reinterpret_cast<__m128i*>( lanes ), aboveAcc );
+    counts.above = lanes[0] + lanes[1];
+    _mm_store_si128( reinterpret_cast<__m128i*>( lanes ), finiteAcc );
+    counts.nonFinite = static_cast<qint64>( i ) - ( lanes[0] + lanes[1] );
+#endif
+
+    for ( ; i < count; ++i )
+    {
+        const double v = values[i];
+        if ( !std::isfinite( v ) )
+            ++counts.nonFinite;
+        else if ( v < minValue )
+            ++counts.below;
+        else if ( v > maxValue )
+            ++counts.above;
+    }
+
+    return counts;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+RangeCounts countOutOfRange( const int* values, size_t count, int minValue, int maxValue )
+{
+    // Branch free so the loop is vectorized
+    qint64 below = 0;
+    qint64 above = 0;
+    for ( size_t i = 0; i < count; ++i )
+    {
+        below += values[i] < minValue;
+        above += values[i] > maxValue;
+    }
+
+    RangeCounts counts;
+    counts.below = below;
+    counts.above = above;
+    return counts;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t findOutOfRange( const double* values, size_t count, double minValue, double maxValue, qint64* offsets, size_t maxOffsets )
+{
+    size_t found = 0;
+    for ( size_t i = 0; i < count && found < maxOffsets; ++i )
+    {
+        const double v = values[i];
+        if ( !std::isfinite( v ) || v < minValue || v > maxValue )
+        {
+            offsets[found++] = static_cast<qint64>( i );
+        }
+    }
+    return found;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t findOutOfRange( const int* values, size_t count, int minValue, int maxValue, qint64* offsets, size_t maxOffsets )
+{
+    size_t found = 0;
+    for ( size_t i = 0; i < count && found < maxOffsets; ++i )
+    {
+        if ( values[i] < minValue || values[i] > maxValue )
+        {
+            offsets[found++] = static_cast<qint64>( i );
+        }
+    }
+    return found;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DeltaStats::merge( const DeltaStats& other, qint64 offset )
+{
+    if ( other.changedCount == 0 ) return;
+
+    if ( firstChanged < 0 ) firstChanged = offset + other.firstChanged;
+    lastChanged = offset + other.lastChanged;
+    changedCount += other.changedCount;
+    sumDelta += other.sumDelta;
+    sumAbsDelta += other.sumAbsDelta;
+
+    if ( other.maxAbsDeltaOffset >= 0 && ( maxAbsDeltaOffset < 0 || other.maxAbsDelta > maxAbsDelta ) )
+    {
+        maxAbsDelta       = other.maxAbsDelta;
+        maxAbsDeltaOffset = offset + other.maxAbsDeltaOffset;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Scalar definition of a changed value, the SIMD path gives the same result
+//--------------------------------------------------------------------------------------------------
+static bool isChanged( double base, double other, double absTolerance, double relTolerance )
+{
+    const bool baseIsNan  = std::isnan( base );
+    const bool otherIsNan = std::isnan( other );
+    if ( baseIsNan || otherIsNan ) return baseIsNan != otherIsNan;
+
+    const double absDelta  = std::fabs( other - base );
+    const double tolerance = std::max( absTolerance, relTolerance * std::max( std::fabs( base ), std::fabs( other ) ) );
+    return absDelta > tolerance;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+static void addChanged( DeltaStats& stats, size_t offset, double base, double other )
+{
+    if ( stats.firstChanged < 0 ) stats.firstChanged = static_cast<qint64>( offset );
+    stats.lastChanged = static_cast<qint64>( offset );
+    ++stats.changedCount;
+
+    const double delta = other - base;
+    if ( std::isfinite( delta ) )
+    {
+        stats.sumDelta += delta;
+        stats.sumAbsDelta += std::fabs( delta );
+        if ( stats.maxAbsDeltaOffset < 0 || std::fabs( delta ) > stats.maxAbsDelta )
+        {
+            stats.maxAbsDelta       = std::fabs( delta );
+            stats.maxAbsDeltaOffset = static_cast<qint64>( offset );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Most values are usually unchanged, so pairs are tested with SIMD and only changed pairs are
+/// accumulated one by one
+//--------------------------------------------------------------------------------------------------
+DeltaStats compareValues( const double* base, const double* other, size_t count, double absTolerance, double relTolerance )
+{
+    DeltaStats stats;
+    size_t     i = 0;
+
+#ifdef DATA_ARRAY_KERNELS_SSE2
+    const __m128d absMask = _mm_castsi128_pd( _mm_set1_epi64x( 0x7fffffffffffffffLL ) );
+    const __m128d absTolV = _mm_set1_pd( absTolerance );
+    const __m128d relTolV = _mm_set1_pd( relTolerance );
+
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const __m128d b         = _mm_loadu_pd( base + i );
+        const __m128d o         = _mm_loadu_pd( other + i );
+        const __m128d absDelta  = _mm_and_pd( _mm_sub_pd( o, b ), absMask );
+        const __m128d magnitude = _mm_max_pd( _mm_and_pd( b, absMask ), _mm_and_pd( o, absMask ) );
+        const __m128d tolerance = _mm_max_pd( _mm_mul_pd( relTolV, magnitude ), absTolV ); // absTolV if 0 * Inf
+        const __m128d nanXor    = _mm_xor_pd( _mm_cmpunord_pd( b, b ), _mm_cmpunord_pd( o, o ) );
+        const __m128d changed   = _mm_or_pd( _mm_cmpgt_pd( absDelta, tolerance ), nanXor );
+
+        const int mask = _mm_movemask_pd( changed );
+        if ( mask == 0 ) continue;
+
+        if ( mask & 1 ) addChanged( stats, i, base[i], other[i] );
+        if ( mask & 2 ) addChanged( stats, i + 1, base[i + 1], other[i + 1] );
+    }
+#endif
+
+    for ( ; i < count; ++i )
+    {
+        if ( isChanged( base[i], other[i], absTolerance, relTolerance ) )
+        {
+            addChanged( stats, i, base[i], other[i] );
+        }
+    }
+
+    return stats;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DeltaStats compareValues( const int* base, const int* other, size_t count, double absTolerance, double relTolerance )
+{
+    DeltaStats stats;
+    for ( size_t i = 0; i < count; ++i )
+    {
+        // Equal values are never changed, which skips the tolerance test for most cells
+        if ( base[i] != other[i] && isChanged( base[i], other[i], absTolerance, relTolerance ) )
+        {
+            addChanged( stats, i, base[i], other[i] );
+        }
+    }
+    return stats;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool isSimdEnabled()
+{
+#ifdef DATA_ARRAY_KERNELS_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+} // namespace DataArrayKernels
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <cstddef>
+
+//==================================================================================================
+/// Scanning kernels for large numeric arrays. The double kernels use SSE2 when the compiler targets
+/// it, the other kernels are plain loops written so the compiler can vectorize them.
+//==================================================================================================
+namespace DataArrayKernels
+{
+struct RangeCounts
+{
+    qint64 below     = 0;
+    qint64 above     = 0;
+    qint64 nonFinite = 0; // NaN and Inf, not included in below or above
+
+    qint64 total() const { return below + above + nonFinite; }
+
+    RangeCounts& operator+=( const RangeCounts& other );
+};
+
+// Count values outside [minValue, maxValue]. Use -Inf and +Inf for open bounds.
+RangeCounts countOutOfRange( const double* values, size_t count, double minValue, double maxValue );
+RangeCounts countOutOfRange( const int* values, size_t count, int minValue, int maxValue );
+
+// Write the offsets of the first maxOffsets values outside the range, returns the number written
+size_t findOutOfRange( const double* values, size_t count, double minValue, double maxValue, qint64* offsets, size_t maxOffsets );
+size_t findOutOfRange( const int* values, size_t count, int minValue, int maxValue, qint64* offsets, size_t maxOffsets );
+
+// Cell-wise difference of two arrays. A value is changed if |other - base| is above both the
+// absolute tolerance and the relative tolerance times max(|base|, |other|), or if only one is NaN.
+// Sums and the maximum are over the changed values with a finite delta.
+struct DeltaStats
+{
+    qint64 changedCount      = 0;
+    qint64 firstChanged      = -1;
+    qint64 lastChanged       = -1;
+    double sumDelta          = 0.0;
+    double sumAbsDelta       = 0.0;
+    double maxAbsDelta       = 0.0;
+    qint64 maxAbsDeltaOffset = -1;
+
+    // Add the stats of a range starting at offset
+    void merge( const DeltaStats& other, qint64 offset );
+};
+
+DeltaStats compareValues( const double* base, const double* other, size_t count, double absTolerance, double relTolerance );
+DeltaStats compareValues( const int* base, const int* other, size_t count, double absTolerance, double relTolerance );
+
+bool isSimdEnabled();
+} // namespace DataArrayKernels
@@ -0,0 +1,454 @@
+#include "DataDeckBatchRunner.h"
+#include "DataDeckSchemaChecker.h"
+#include "DataDeckValidator.h"
+#include "KeywordDatabase.h"
+#include "RimDataDeck.h"
+#include "RimIncludeFile.h"
+
+#include "opm/input/eclipse/Deck/Deck.hpp"
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <cstdio>
+#include <sstream>
+
+namespace
+{
+const QString BATCH_OPTION = "batch";
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void addOptions( QCommandLineParser& parser )
+{
+    parser.setApplicationDescription( "Load, validate and export Eclipse DATA files without a GUI." );
+    parser.addHelpOption();
+    parser.addOption( QCommandLineOption( BATCH_OPTION, "Run without a GUI and write the results as JSON." ) );
+    parser.addOption( QCommandLineOption( { "j", "jobs" }, "Number of decks processed in parallel, default one per core.", "count" ) );
+    parser.addOption( QCommandLineOption( "no-validate", "Only parse the decks and resolve includes." ) );
+    parser.addOption( QCommandLineOption( "memory", "Report the estimated memory of each parsed deck and its include decks." ) );
+    parser.addOption( QCommandLineOption( "export-dir",
+                                          "Write each deck in normalized form, with includes inlined, to this directory. Decks keep "
+                                          "their path relative to the common directory of the input decks.",
+                                          "directory" ) );
+    parser.addOption( QCommandLineOption( { "o", "output" }, "Write the JSON result to this file instead of stdout.", "file" ) );
+    parser.addPositionalArgument( "files", "DATA files to process.", "files..." );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QJsonObject problemToJson( const DataDeckProblem& problem )
+{
+    QJsonObject object;
+    object["severity"] = DataDeckProblem::severityToString( problem.severity ).toLower();
+    object["message"]  = problem.message;
+    if ( !problem.filePath.isEmpty() ) object["file"] = problem.filePath;
+    if ( problem.line > 0 ) object["line"] = problem.line;
+    if ( !problem.keyword.isEmpty() ) object["keyword"] = problem.keyword;
+    if ( problem.keywordIndex >= 0 ) object["keywordIndex"] = problem.keywordIndex;
+    return object;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The deepest directory containing all the files, empty if there is none (different drives)
+//--------------------------------------------------------------------------------------------------
+QString commonDirectory( const QStringList& filePaths )
+{
+    QString commonPath;
+    for ( const QString& filePath : filePaths )
+    {
+        const QString directory = QFileInfo( filePath ).absolutePath();
+        if ( commonPath.isNull() )
+        {
+            commonPath = directory;
+            continue;
+        }
+
+        while ( directory != commonPath && !directory.startsWith( commonPath.endsWith( '/' ) ? commonPath : commonPath + '/' ) )
+        {
+            const QString parentPath = QFileInfo( commonPath ).path();
+            if ( parentPath == commonPath ) return QString();
+            commonPath = parentPath;
+        }
+    }
+    return commonPath;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Decks keep their directory relative to the common directory of all the input decks, so decks
+/// with the same file name in different directories are not written to the same export file
+//--------------------------------------------------------------------------------------------------
+QString exportRelativePath( const QString& filePath, const QStringList& filePaths )
+{
+    const QString absoluteFilePath = QFileInfo( filePath ).absoluteFilePath();
+    const QString commonPath       = commonDirectory( filePaths );
+    if ( commonPath.isEmpty() )
+    {
+        // No common root, use the full path with the drive as the first directory
+        return QString( absoluteFilePath ).remove( ':' );
+    }
+    return QDir( commonPath ).relativeFilePath( absoluteFilePath );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString exportDeck( const Opm::Deck& deck,
+                    const QString&    filePath,
+                    const QString&    relativePath,
+                    const QString&    exportDirectory,
+                    QString*          errorMessage )
+{
+    const QString   exportPath = QDir( exportDirectory ).absoluteFilePath( relativePath );
+    const QFileInfo exportInfo( exportPath );
+    if ( !exportInfo.absoluteDir().exists() && !QDir().mkpath( exportInfo.absolutePath() ) )
+    {
+        *errorMessage = QString( "Could not create the export directory %1" ).arg( exportInfo.absolutePath() );
+        return QString();
+    }
+
+    if ( QFileInfo( exportPath ).canonicalFilePath() == QFileInfo( filePath ).canonicalFilePath() )
+    {
+        *errorMessage = QString( "Export would overwrite the input file %1" ).arg( filePath );
+        return QString();
+    }
+
+    std::ostringstream stream;
+    stream << deck;
+
+    QFile file( exportPath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) || file.write( QByteArray::fromStdString( stream.str() ) ) < 0 )
+    {
+        *errorMessage = QString( "Could not write %1: %2" ).arg( exportPath ).arg( file.errorString() );
+        return QString();
+    }
+
+    return exportPath;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckBatchRunner::DeckResult::problemCount( DataDeckProblem::Severity severity ) const
+{
+    int count = 0;
+    for ( const DataDeckProblem& problem : problems )
+    {
+        if ( problem.severity == severity ) ++count;
+    }
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QJsonObject DataDeckBatchRunner::DeckResult::toJson() const
+{
+    QJsonObject object;
+    object["file"]         = filePath;
+    object["success"]      = success();
+    object["keywordCount"] = keywordCount;
+    if ( !success() ) object["error"] = errorMessage;
+    if ( !exportedFilePath.isEmpty() ) object["exportedFile"] = exportedFilePath;
+
+    QJsonArray includes;
+    for ( const IncludeFile& includeFile : includeFiles )
+    {
+        QJsonObject include;
+        include["path"]         = includeFile.includePath;
+        include["resolvedPath"] = includeFile.resolvedPath;
+        include["exists"]       = includeFile.exists;
+        includes.append( include );
+    }
+    object["includes"] = includes;
+
+    QJsonArray problemArray;
+    for ( const DataDeckProblem& problem : problems )
+    {
+        problemArray.append( problemToJson( problem ) );
+    }
+    object["problems"] = problemArray;
+
+    QJsonObject counts;
+    counts["error"]          = problemCount( DataDeckProblem::Severity::ERROR );
+    counts["warning"]        = problemCount( DataDeckProblem::Severity::WARNING );
+    counts["info"]           = problemCount( DataDeckProblem::Severity::INFO );
+    object["problemCounts"] = counts;
+
+    QJsonObject timings;
+    timings["parseMs"]    = parseTimeMs;
+    timings["validateMs"] = validateTimeMs;
+    object["timings"]     = timings;
+
+    if ( memoryUsage ) object["memory"] = memoryUsage->toJson();
+
+    return object;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Checked before any application object exists, so the GUI is never created in batch mode
+//--------------------------------------------------------------------------------------------------
+bool DataDeckBatchRunner::isBatchMode( int argc, char* argv[] )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( QByteArray( argv[i] ) == "--" + BATCH_OPTION.toLatin1() ) return true;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckBatchRunner::helpText()
+{
+    QCommandLineParser parser;
+    addOptions( parser );
+    return parser.helpText();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckBatchRunner::parseArguments( const QStringList& arguments, Options* options, QString* errorMessage )
+{
+    QCommandLineParser parser;
+    addOptions( parser );
+
+    if ( !parser.parse( arguments ) )
+    {
+        *errorMessage = parser.errorText();
+        return false;
+    }
+
+    if ( parser.isSet( "help" ) )
+    {
+        options->helpRequested = true;
+        return true;
+    }
+
+    if ( parser.isSet( "jobs" ) )
+    {
+        bool ok           = false;
+        options->jobCount = parser.value( "jobs" ).toInt( &ok );
+        if ( !ok || options->jobCount < 1 )
+        {
+            *errorMessage = QString( "Invalid job count: %1" ).arg( parser.value( "jobs" ) );
+            return false;
+        }
+    }
+
+    options->validate        = !parser.isSet( "no-validate" );
+    options->reportMemory    = parser.isSet( "memory" );
+    options->exportDirectory = parser.value( "export-dir" );
+    options->outputFilePath  = parser.value( "output" );
+    options->filePaths       = parser.positionalArguments();
+
+    if ( options->filePaths.isEmpty() )
+    {
+        *errorMessage = "No DATA files given";
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Follow INCLUDE statements recursively, the same way the editor builds its include tree
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckBatchRunner::IncludeFile> DataDeckBatchRunner::resolveIncludeFiles( const QString& filePath )
+{
+    QList<IncludeFile> includeFiles;
+
+    QStringList   pendingFiles{ filePath };
+    QSet<QString> visitedFiles{ QFileInfo( filePath ).absoluteFilePath() };
+
+    while ( !pendingFiles.isEmpty() )
+    {
+        const QString currentFile = pendingFiles.takeFirst();
+        const QString basePath    = QFileInfo( currentFile ).absolutePath();
+
+        for ( const QString& includePath : RimDataDeck::scanIncludePaths( currentFile ) )
+        {
+            IncludeFile includeFile;
+            includeFile.includePath  = includePath;
+            includeFile.resolvedPath = RimIncludeFile::resolveAbsolutePath( includePath, basePath );
+            includeFile.exists       = QFileInfo( includeFile.resolvedPath ).isFile();
+
+            if ( visitedFiles.contains( includeFile.resolvedPath ) ) continue;
+            visitedFiles.insert( includeFile.resolvedPath );
+
+            if ( includeFile.exists )
+            {
+                pendingFiles.append( includeFile.resolvedPath );
+            }
+            includeFiles.append( includeFile );
+        }
+    }
+
+    return includeFiles;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Safe to call from worker threads
+//--------------------------------------------------------------------------------------------------
+DataDeckBatchRunner::DeckResult DataDeckBatchRunner::processDeck( const QString& filePath, const Options& options )
+{
+    DeckResult result;
+    result.filePath = QFileInfo( filePath ).absoluteFilePath();
+
+    if ( !QFileInfo( filePath ).isFile() )
+    {
+        result.errorMessage = "File not found";
+        return result;
+    }
+
+    result.includeFiles = resolveIncludeFiles( result.filePath );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto deck          = DataDeckValidator::parseCollectingProblems( result.filePath, result.problems );
+    result.parseTimeMs = timer.restart();
+
+    if ( !deck )
+    {
+        result.errorMessage = result.problems.isEmpty() ? QString( "Could not parse the deck" ) : result.problems.last().message;
+        return result;
+    }
+
+    result.keywordCount = static_cast<int>( deck->size() );
+
+    if ( options.validate )
+    {
+        result.problems.append( DataDeckValidator::checkDeck( *deck, std::make_shared<DataDeckSchemaChecker>() ) );
+        result.validateTimeMs = timer.restart();
+    }
+
+    if ( options.reportMemory )
+    {
+        // The include files are parsed on their own, as the loader parses them for the editor. The
+        // project tree is not built, caf objects are not made to be created on worker threads.
+        DataDeckMemoryUsage memoryUsage;
+        memoryUsage.parsedDeckBytes = DataDeckMemoryUsage::deckBytes( *deck );
+        for ( const IncludeFile& includeFile : result.includeFiles )
+        {
+            if ( !includeFile.exists ) continue;
+
+            try
+            {
+                memoryUsage.includeDeckBytes += DataDeckMemoryUsage::deckBytes( *RimDataDeck::parseDeckFile( includeFile.resolvedPath ) );
+            }
+            catch ( const std::exception& )
+            {
+                // The problem is reported by the parse of the main deck, which inlines the file
+            }
+        }
+        result.memoryUsage = memoryUsage;
+    }
+
+    if ( !options.exportDirectory.isEmpty() )
+    {
+        QString errorMessage;
+        result.exportedFilePath = exportDeck( *deck,
+                                              result.filePath,
+                                              exportRelativePath( result.filePath, options.filePaths ),
+                                              options.exportDirectory,
+                                              &errorMessage );
+        if ( !errorMessage.isEmpty() )
+        {
+            DataDeckProblem problem;
+            problem.message  = errorMessage;
+            problem.filePath = result.filePath;
+            result.problems.append( problem );
+        }
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// One deck per job, so the job count limits how many decks are parsed and held in memory at the
+/// same time.
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckBatchRunner::DeckResult> DataDeckBatchRunner::processDecks( const Options& options )
+{
+    // The keyword database is created on first use and must not be created concurrently
+    KeywordDatabase::instance();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount( options.jobCount > 0 ? options.jobCount : QThread::idealThreadCount() );
+
+    return QtConcurrent::blockingMapped<QList<DeckResult>>( &pool,
+                                                            options.filePaths,
+                                                            [&options]( const QString& filePath ) { return processDeck( filePath, options ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckBatchRunner::run( const Options& options )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QList<DeckResult> results = processDecks( options );
+
+    QJsonArray decks;
+    int        failedCount  = 0;
+    int        errorCount   = 0;
+    int        warningCount = 0;
+    for ( const DeckResult& result : results )
+    {
+        decks.append( result.toJson() );
+        if ( !result.success() ) ++failedCount;
+        errorCount += result.problemCount( DataDeckProblem::Severity::ERROR );
+        warningCount += result.problemCount( DataDeckProblem::Severity::WARNING );
+    }
+
+    QJsonObject summary;
+    summary["deckCount"]    = static_cast<int>( results.size() );
+    summary["failedCount"]  = failedCount;
+    summary["errorCount"]   = errorCount;
+    summary["warningCount"] = warningCount;
+    summary["elapsedMs"]    = timer.elapsed();
+
+    QJsonObject root;
+    root["decks"]   = decks;
+    root["summary"] = summary;
+
+    const QByteArray json = QJsonDocument( root ).toJson( QJsonDocument::Indented );
+
+    QFile output;
+    bool  isOpen = false;
+    if ( options.outputFilePath.isEmpty() )
+    {
+        isOpen = output.open( stdout, QIODevice::WriteOnly );
+    }
+    else
+    {
+        output.setFileName( options.outputFilePath );
+        isOpen = output.open( QIODevice::WriteOnly | QIODevice::Truncate );
+    }
+
+    if ( !isOpen || output.write( json ) < 0 )
+    {
+        std::fprintf( stderr, "Could not write the results: %s\n", qPrintable( output.errorString() ) );
+        return EXIT_USAGE_ERROR;
+    }
+    output.close();
+
+    return failedCount > 0 || errorCount > 0 ? EXIT_PROBLEMS_FOUND : EXIT_OK;
+}
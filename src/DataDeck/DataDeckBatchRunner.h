@@ -0,0 +1,76 @@
+#pragma once
+
+#include "DataDeckMemoryUsage.h"
+#include "DataDeckProblem.h"
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+//==================================================================================================
+/// Headless processing of DATA files for batch jobs and compute nodes, started with --batch.
+///
+/// Each deck is parsed with its includes, validated with the same checks as the editor and
+/// optionally written to an export directory in the normalized form produced by opm-common. Decks
+/// are processed in parallel, one deck per job, and the results are written as one JSON document.
+/// Only QCoreApplication is needed, so no display server is required.
+//==================================================================================================
+class DataDeckBatchRunner
+{
+public:
+    struct Options
+    {
+        QStringList filePaths;
+        int         jobCount = 0; // 0 uses one job per core
+        bool        validate = true;
+        bool        reportMemory = false; // Estimate the memory of the parsed deck and its include decks
+        QString     exportDirectory; // Empty if the decks are not exported
+        QString     outputFilePath; // Empty writes the JSON result to stdout
+        bool        helpRequested = false;
+    };
+
+    struct IncludeFile
+    {
+        QString includePath; // As written in the deck
+        QString resolvedPath;
+        bool    exists = false;
+    };
+
+    struct DeckResult
+    {
+        QString                filePath;
+        QString                errorMessage; // Set if the deck could not be parsed
+        int                    keywordCount = 0;
+        QList<IncludeFile>     includeFiles;
+        QList<DataDeckProblem> problems;
+        QString                exportedFilePath;
+        qint64                 parseTimeMs    = 0;
+        qint64                 validateTimeMs = 0;
+
+        std::optional<DataDeckMemoryUsage> memoryUsage;
+
+        bool        success() const { return errorMessage.isEmpty(); }
+        int         problemCount( DataDeckProblem::Severity severity ) const;
+        QJsonObject toJson() const;
+    };
+
+    // Returns false and sets errorMessage for invalid command line arguments
+    static bool    parseArguments( const QStringList& arguments, Options* options, QString* errorMessage );
+    static bool    isBatchMode( int argc, char* argv[] );
+    static QString helpText();
+
+    static DeckResult        processDeck( const QString& filePath, const Options& options );
+    static QList<DeckResult> processDecks( const Options& options );
+
+    // Process the decks and write the results, returns the process exit code
+    static int run( const Options& options );
+
+    static QList<IncludeFile> resolveIncludeFiles( const QString& filePath );
+
+    static constexpr int EXIT_OK             = 0;
+    static constexpr int EXIT_PROBLEMS_FOUND = 1; // A deck failed to parse or has errors
+    static constexpr int EXIT_USAGE_ERROR    = 2;
+};
@@ -0,0 +1,433 @@
+#include "DataDeckDiff.h"
+#include "DeckKeywordHash.h"
+#include "KeywordDatabase.h"
+
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+
+#include <QHash>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+// Beyond this many edits the sequences are treated as unrelated, which bounds time and memory
+constexpr int MAX_EDIT_DISTANCE = 4096;
+
+struct DeckSection
+{
+    QString          name;
+    std::vector<int> keywordIndices;
+};
+
+//--------------------------------------------------------------------------------------------------
+/// Split the deck into sections. Keywords before the first section keyword get an unnamed section.
+//--------------------------------------------------------------------------------------------------
+std::vector<DeckSection> splitIntoSections( const Opm::Deck& deck )
+{
+    KeywordDatabase* database = KeywordDatabase::instance();
+
+    std::vector<DeckSection> sections( 1 );
+    for ( size_t i = 0; i < deck.size(); ++i )
+    {
+        const QString name = QString::fromStdString( deck[i].name() );
+        if ( database->isSection( name ) )
+        {
+            sections.push_back( DeckSection{ name, {} } );
+        }
+        sections.back().keywordIndices.push_back( static_cast<int>( i ) );
+    }
+
+    if ( sections.front().keywordIndices.empty() )
+    {
+        sections.erase( sections.begin() );
+    }
+    return sections;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+qint64 countChangedValues( const std::vector<T>& base, const std::vector<T>& other )
+{
+    const size_t common  = std::min( base.size(), other.size() );
+    qint64       changed = static_cast<qint64>( std::max( base.size(), other.size() ) - common );
+    for ( size_t i = 0; i < common; ++i )
+    {
+        changed += base[i] != other[i];
+    }
+    return changed;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Fill in the record or value details of a changed keyword
+//--------------------------------------------------------------------------------------------------
+void compareKeywordContent( const Opm::DeckKeyword& base, const Opm::DeckKeyword& other, DataDeckKeywordDiff& diff )
+{
+    if ( base.isDataKeyword() && other.isDataKeyword() )
+    {
+        const Opm::DeckItem& baseItem  = base.getDataRecord().getDataItem();
+        const Opm::DeckItem& otherItem = other.getDataRecord().getDataItem();
+
+        if ( baseItem.getType() == otherItem.getType() )
+        {
+            switch ( baseItem.getType() )
+            {
+                case Opm::type_tag::integer:
+                    diff.changedValueCount = countChangedValues( baseItem.getData<int>(), otherItem.getData<int>() );
+                    return;
+                case Opm::type_tag::fdouble:
+                    diff.changedValueCount = countChangedValues( baseItem.getData<double>(), otherItem.getData<double>() );
+                    return;
+                case Opm::type_tag::string:
+                    diff.changedValueCount = countChangedValues( baseItem.getData<std::string>(), otherItem.getData<std::string>() );
+                    return;
+                default:
+                    break;
+            }
+        }
+    }
+
+    std::vector<size_t> baseRecords( base.size() );
+    std::vector<size_t> otherRecords( other.size() );
+    for ( size_t i = 0; i < base.size(); ++i )
+    {
+        baseRecords[i] = DeckKeywordHash::recordHash( base.getRecord( i ) );
+    }
+    for ( size_t i = 0; i < other.size(); ++i )
+    {
+        otherRecords[i] = DeckKeywordHash::recordHash( other.getRecord( i ) );
+    }
+
+    // Between two matched records, removed and added records pair up as changed records
+    std::vector<std::pair<int, int>> matches = DataDeckDiff::alignSequences( baseRecords, otherRecords );
+    matches.emplace_back( static_cast<int>( base.size() ), static_cast<int>( other.size() ) );
+
+    int previousBase  = -1;
+    int previousOther = -1;
+    for ( const auto& [baseIndex, otherIndex] : matches )
+    {
+        const int removed = baseIndex - previousBase - 1;
+        const int added   = otherIndex - previousOther - 1;
+        const int changed = std::min( removed, added );
+
+        diff.changedRecordCount += changed;
+        diff.removedRecordCount += removed - changed;
+        diff.addedRecordCount += added - changed;
+
+        previousBase  = baseIndex;
+        previousOther = otherIndex;
+    }
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckKeywordDiff::description() const
+{
+    switch ( change )
+    {
+        case Change::ADDED:
+            return "Added";
+        case Change::REMOVED:
+            return "Removed";
+        default:
+            break;
+    }
+
+    QStringList details;
+    if ( changedValueCount > 0 ) details.append( QString( "%1 value(s) changed" ).arg( changedValueCount ) );
+    if ( changedRecordCount > 0 ) details.append( QString( "%1 record(s) changed" ).arg( changedRecordCount ) );
+    if ( addedRecordCount > 0 ) details.append( QString( "%1 record(s) added" ).arg( addedRecordCount ) );
+    if ( removedRecordCount > 0 ) details.append( QString( "%1 record(s) removed" ).arg( removedRecordCount ) );
+
+    return details.isEmpty() ? QString( "Changed" ) : QString( "Changed: %1" ).arg( details.join( ", " ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckDiff DataDeckDiff::compare( const Opm::Deck& base, const Opm::Deck& other )
+{
+    const std::vector<size_t> baseHashes  = DeckKeywordHash::keywordHashes( base );
+    const std::vector<size_t> otherHashes = DeckKeywordHash::keywordHashes( other );
+
+    const std::vector<DeckSection> baseSections  = splitIntoSections( base );
+    const std::vector<DeckSection> otherSections = splitIntoSections( other );
+
+    auto sectionKeys = []( const std::vector<DeckSection>& sections )
+    {
+        std::vector<size_t> keys;
+        for ( const DeckSection& section : sections )
+        {
+            keys.push_back( qHash( section.name ) );
+        }
+        return keys;
+    };
+
+    auto keywordKeys = []( const Opm::Deck& deck, const DeckSection& section )
+    {
+        std::vector<size_t> keys;
+        for ( int index : section.keywordIndices )
+        {
+            keys.push_back( qHashBits( deck[index].name().data(), deck[index].name().size() ) );
+        }
+        return keys;
+    };
+
+    DataDeckDiff result;
+
+    auto addOneSided = [&result]( const Opm::Deck& deck, const DeckSection& section, int keywordIndex, DataDeckKeywordDiff::Change change )
+    {
+        DataDeckKeywordDiff diff;
+        diff.change  = change;
+        diff.keyword = QString::fromStdString( deck[keywordIndex].name() );
+        diff.section = section.name;
+        if ( change == DataDeckKeywordDiff::Change::ADDED )
+        {
+            diff.otherIndex = keywordIndex;
+        }
+        else
+        {
+            diff.baseIndex = keywordIndex;
+        }
+        result.m_keywordDiffs.append( diff );
+    };
+
+    auto addUnmatchedSection = [&addOneSided]( const Opm::Deck& deck, const DeckSection& section, DataDeckKeywordDiff::Change change )
+    {
+        for ( int index : section.keywordIndices )
+        {
+            addOneSided( deck, section, index, change );
+        }
+    };
+
+    std::vector<std::pair<int, int>> sectionMatches = alignSequences( sectionKeys( baseSections ), sectionKeys( otherSections ) );
+    sectionMatches.emplace_back( static_cast<int>( baseSections.size() ), static_cast<int>( otherSections.size() ) );
+
+    int previousBaseSection  = -1;
+    int previousOtherSection = -1;
+    for ( const auto& [baseSectionIndex, otherSectionIndex] : sectionMatches )
+    {
+        for ( int i = previousBaseSection + 1; i < baseSectionIndex; ++i )
+        {
+            addUnmatchedSection( base, baseSections[i], DataDeckKeywordDiff::Change::REMOVED );
+        }
+        for ( int i = previousOtherSection + 1; i < otherSectionIndex; ++i )
+        {
+            addUnmatchedSection( other, otherSections[i], DataDeckKeywordDiff::Change::ADDED );
+        }
+
+        previousBaseSection  = baseSectionIndex;
+        previousOtherSection = otherSectionIndex;
+
+        if ( baseSectionIndex >= static_cast<int>( baseSections.size() ) ) break;
+
+        const DeckSection& baseSection  = baseSections[baseSectionIndex];
+        const DeckSection& otherSection = otherSections[otherSectionIndex];
+
+        std::vector<std::pair<int, int>> keywordMatches = alignSequences( keywordKeys( base, baseSection ), keywordKeys( other, otherSection ) );
+        keywordMatches.emplace_back( static_cast<int>( baseSection.keywordIndices.size() ), static_cast<int>( otherSection.keywordIndices.size() ) );
+
+        int previousBase  = -1;
+        int previousOther = -1;
+        for ( const auto& [basePosition, otherPosition] : keywordMatches )
+        {
+            for ( int i = previousBase + 1; i < basePosition; ++i )
+            {
+                addOneSided( base, baseSection, baseSection.keywordIndices[i], DataDeckKeywordDiff::Change::REMOVED );
+            }
+            for ( int i = previousOther + 1; i < otherPosition; ++i )
+            {
+                addOneSided( other, otherSection, otherSection.keywordIndices[i], DataDeckKeywordDiff::Change::ADDED );
+            }
+
+            previousBase  = basePosition;
+            previousOther = otherPosition;
+
+            if ( basePosition >= static_cast<int>( baseSection.keywordIndices.size() ) ) break;
+
+            const int baseIndex  = baseSection.keywordIndices[basePosition];
+            const int otherIndex = otherSection.keywordIndices[otherPosition];
+            if ( baseHashes[baseIndex] != otherHashes[otherIndex] )
+            {
+                DataDeckKeywordDiff diff;
+                diff.change     = DataDeckKeywordDiff::Change::CHANGED;
+                diff.keyword    = QString::fromStdString( base[baseIndex].name() );
+                diff.section    = baseSection.name;
+                diff.baseIndex  = baseIndex;
+                diff.otherIndex = otherIndex;
+                result.m_keywordDiffs.append( diff );
+            }
+        }
+    }
+
+    // Record and value details are the expensive part for large arrays
+    QtConcurrent::blockingMap( result.m_keywordDiffs,
+                               [&base, &other]( DataDeckKeywordDiff& diff )
+                               {
+                                   if ( diff.change == DataDeckKeywordDiff::Change::CHANGED )
+                                   {
+                                       compareKeywordContent( base[diff.baseIndex], other[diff.otherIndex], diff );
+                                   }
+                               } );
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const QList<DataDeckKeywordDiff>& DataDeckDiff::keywordDiffs() const
+{
+    return m_keywordDiffs;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckDiff::count( DataDeckKeywordDiff::Change change ) const
+{
+    return static_cast<int>(
+        std::count_if( m_keywordDiffs.begin(), m_keywordDiffs.end(), [change]( const DataDeckKeywordDiff& diff ) { return diff.change == change; } ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckDiff::isEmpty() const
+{
+    return m_keywordDiffs.isEmpty();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckDiff::summary() const
+{
+    if ( isEmpty() )
+    {
+        return "No differences";
+    }
+
+    return QString( "%1 keyword(s) changed, %2 added, %3 removed" )
+        .arg( count( DataDeckKeywordDiff::Change::CHANGED ) )
+        .arg( count( DataDeckKeywordDiff::Change::ADDED ) )
+        .arg( count( DataDeckKeywordDiff::Change::REMOVED ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Myers O(ND) difference algorithm after trimming the common prefix and suffix. Only the diagonals
+/// reached in each step are kept for the backtrack, so memory is O(D^2). If the sequences differ by
+/// more than MAX_EDIT_DISTANCE edits, the middle part is left unmatched.
+//--------------------------------------------------------------------------------------------------
+std::vector<std::pair<int, int>> DataDeckDiff::alignSequences( const std::vector<size_t>& base, const std::vector<size_t>& other )
+{
+    const int baseSize  = static_cast<int>( base.size() );
+    const int otherSize = static_cast<int>( other.size() );
+
+    std::vector<std::pair<int, int>> matches;
+
+    int prefix = 0;
+    while ( prefix < baseSize && prefix < otherSize && base[prefix] == other[prefix] )
+    {
+        matches.emplace_back( prefix, prefix );
+        ++prefix;
+    }
+
+    int suffix = 0;
+    while ( suffix < baseSize - prefix && suffix < otherSize - prefix && base[baseSize - 1 - suffix] == other[otherSize - 1 - suffix] )
+    {
+        ++suffix;
+    }
+
+    const int n = baseSize - prefix - suffix;
+    const int m = otherSize - prefix - suffix;
+
+    if ( n > 0 && m > 0 )
+    {
+        auto equal = [&]( int x, int y ) { return base[prefix + x] == other[prefix + y]; };
+
+        const int        maxD   = std::min( n + m, MAX_EDIT_DISTANCE );
+        const int        offset = maxD + 1;
+        std::vector<int> v( 2 * offset + 1, 0 );
+
+        std::vector<std::vector<int>> trace; // trace[d][k + d] is the furthest x on diagonal k after step d
+        int                           foundD = -1;
+
+        for ( int d = 0; d <= maxD && foundD < 0; ++d )
+        {
+            for ( int k = -d; k <= d; k += 2 )
+            {
+                int x = ( k == -d || ( k != d && v[offset + k - 1] < v[offset + k + 1] ) ) ? v[offset + k + 1] : v[offset + k - 1] + 1;
+                int y = x - k;
+                while ( x < n && y < m && equal( x, y ) )
+                {
+                    ++x;
+                    ++y;
+                }
+                v[offset + k] = x;
+
+                if ( x >= n && y >= m )
+                {
+                    foundD = d;
+                }
+            }
+            trace.emplace_back( v.begin() + offset - d, v.begin() + offset + d + 1 );
+        }
+
+        if ( foundD >= 0 )
+        {
+            std::vector<std::pair<int, int>> middle;
+
+            int x = n;
+            int y = m;
+            for ( int d = foundD; d > 0; --d )
+            {
+                const std::vector<int>& previous = trace[d - 1];
+                auto                    at       = [&previous, d]( int k ) { return previous[k + d - 1]; };
+
+                const int k     = x - y;
+                const int prevK = ( k == -d || ( k != d && at( k - 1 ) < at( k + 1 ) ) ) ? k + 1 : k - 1;
+                const int prevX = at( prevK );
+                const int prevY = prevX - prevK;
+
+                // The edit step ends where the snake of this step starts
+                const int startX = prevK == k + 1 ? prevX : prevX + 1;
+                while ( x > startX )
+                {
+                    middle.emplace_back( x - 1, y - 1 );
+                    --x;
+                    --y;
+                }
+                x = prevX;
+                y = prevY;
+            }
+            while ( x > 0 && y > 0 )
+            {
+                middle.emplace_back( x - 1, y - 1 );
+                --x;
+                --y;
+            }
+
+            std::reverse( middle.begin(), middle.end() );
+            for ( const auto& [x0, y0] : middle )
+            {
+                matches.emplace_back( prefix + x0, prefix + y0 );
+            }
+        }
+    }
+
+    for ( int i = suffix; i > 0; --i )
+    {
+        matches.emplace_back( baseSize - i, otherSize - i );
+    }
+
+    return matches;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+class Deck;
+}
+
+//==================================================================================================
+/// Difference for one keyword between a base deck and another deck
+//==================================================================================================
+struct DataDeckKeywordDiff
+{
+    enum class Change
+    {
+        ADDED, // Only in the other deck
+        REMOVED, // Only in the base deck
+        CHANGED
+    };
+
+    Change  change = Change::CHANGED;
+    QString keyword;
+    QString section;
+    int     baseIndex  = -1; // Keyword index in the base deck, -1 if added
+    int     otherIndex = -1; // Keyword index in the other deck, -1 if removed
+
+    // Details for changed keywords
+    int    changedRecordCount = 0;
+    int    addedRecordCount   = 0;
+    int    removedRecordCount = 0;
+    qint64 changedValueCount  = 0; // Data keywords only
+
+    QString description() const;
+};
+
+//==================================================================================================
+/// Structural comparison of two parsed decks.
+///
+/// Keywords are compared by content hash. Sections are aligned by name, and keywords within a section
+/// by name and order, using the Myers difference algorithm. Changed keywords are compared record by
+/// record, or value by value for data arrays. Hashing and the keyword comparisons run in parallel.
+//==================================================================================================
+class DataDeckDiff
+{
+public:
+    static DataDeckDiff compare( const Opm::Deck& base, const Opm::Deck& other );
+
+    const QList<DataDeckKeywordDiff>& keywordDiffs() const;
+
+    int     count( DataDeckKeywordDiff::Change change ) const;
+    bool    isEmpty() const;
+    QString summary() const;
+
+    // Index pairs of the longest common subsequence of two sequences, in order
+    static std::vector<std::pair<int, int>> alignSequences( const std::vector<size_t>& base, const std::vector<size_t>& other );
+
+private:
+    QList<DataDeckKeywordDiff> m_keywordDiffs; // Unchanged keywords are not listed
+};
@@ -0,0 +1,127 @@
+#include "DataDeckFileScan.h"
+#include "DataDeckLogging.h"
+#include "DataDeckTrace.h"
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+
+namespace
+{
+// Extracts the file name from patterns like: 'filename' / or "filename" /
+const QRegularExpression INCLUDE_PATH_REGEX( R"(['"]([^'"]+)['"])" );
+
+//--------------------------------------------------------------------------------------------------
+/// Bytes of the text in UTF-8, as it is stored in the file
+//--------------------------------------------------------------------------------------------------
+qint64 utf8Bytes( const QString& text )
+{
+    qint64 bytes = 0;
+    for ( const QChar character : text )
+    {
+        const char16_t unit = character.unicode();
+        if ( unit < 0x80 )
+            bytes += 1;
+        else if ( unit < 0x800 )
+            bytes += 2;
+        else if ( QChar::isHighSurrogate( unit ) )
+            bytes += 4; // The low surrogate that follows adds nothing
+        else if ( !QChar::isLowSurrogate( unit ) )
+            bytes += 3;
+    }
+    return bytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString withoutComment( const QString& line )
+{
+    const int commentPos = line.indexOf( "--" );
+    return commentPos >= 0 ? line.left( commentPos ) : line;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+/// Reads the file as serializeToText() does. Returns nothing if the file cannot be read.
+//--------------------------------------------------------------------------------------------------
+std::optional<DataDeckFileScan> DataDeckFileScan::scanFile( const QString& filePath )
+{
+    DATADECK_TRACE_SCOPE_DETAIL( "loader", "DataDeckFileScan::scanFile", filePath );
+
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qCDebug( logInclude ) << "Could not open file for scanning:" << filePath;
+        return std::nullopt;
+    }
+
+    QTextStream in( &file );
+    return scanText( in.readAll() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckFileScan DataDeckFileScan::scanText( const QString& text )
+{
+    DataDeckFileScan scan;
+    scan.includePaths = findIncludePaths( text );
+
+    const QStringList lines = text.split( '\n' );
+    for ( const DataDeckKeywordScanner::KeywordLines& keywordLines : DataDeckKeywordScanner::scanText( text ) )
+    {
+        KeywordText keyword;
+        keyword.lines = keywordLines;
+        for ( int line = keywordLines.firstLine; line <= keywordLines.lastLine; ++line )
+        {
+            keyword.bytes += utf8Bytes( lines[line] ) + 1;
+        }
+        scan.keywords.append( keyword );
+    }
+
+    return scan;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The path is taken from the line after a line holding only "INCLUDE"
+//--------------------------------------------------------------------------------------------------
+QStringList DataDeckFileScan::findIncludePaths( const QString& text )
+{
+    QStringList includePaths;
+
+    const QStringList lines = text.split( '\n' );
+    for ( int lineIndex = 0; lineIndex < lines.size(); ++lineIndex )
+    {
+        if ( withoutComment( lines[lineIndex] ).trimmed().compare( "INCLUDE", Qt::CaseInsensitive ) != 0 )
+        {
+            continue;
+        }
+
+        if ( lineIndex + 1 >= lines.size() )
+        {
+            qCDebug( logInclude ) << "No next line available after INCLUDE at line" << lineIndex + 1;
+            break;
+        }
+
+        // The path line is consumed, so it is not checked for a keyword
+        ++lineIndex;
+        const QString                 pathLine = withoutComment( lines[lineIndex] ).trimmed();
+        const QRegularExpressionMatch match    = INCLUDE_PATH_REGEX.match( pathLine );
+        if ( !match.hasMatch() )
+        {
+            qCDebug( logInclude ) << "Could not extract include path from line" << lineIndex + 1 << ":" << pathLine;
+            continue;
+        }
+
+        const QString includePath = match.captured( 1 ).trimmed();
+        if ( !includePath.isEmpty() && !includePaths.contains( includePath ) )
+        {
+            includePaths.append( includePath );
+        }
+    }
+
+    qCDebug( logInclude ) << "Found" << includePaths.size() << "unique include paths";
+
+    return includePaths;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "DataDeckKeywordScanner.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+//==================================================================================================
+/// What building the tree of a deck needs from the text of its file: the INCLUDE paths, and the
+/// line range and size of each keyword. The loader scans each file on its worker thread, so setDeck()
+/// does not read the files again on the GUI thread.
+//==================================================================================================
+struct DataDeckFileScan
+{
+    struct KeywordText
+    {
+        DataDeckKeywordScanner::KeywordLines lines;
+        qint64                               bytes = 0; // UTF-8 text of the lines, with their line ends
+    };
+
+    QStringList        includePaths; // As written in the file, in file order without duplicates
+    QList<KeywordText> keywords;
+
+    static std::optional<DataDeckFileScan> scanFile( const QString& filePath );
+    static DataDeckFileScan                scanText( const QString& text );
+    static QStringList                     findIncludePaths( const QString& text );
+};
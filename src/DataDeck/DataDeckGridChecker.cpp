@@ -0,0 +1,349 @@
+#include "DataDeckGridChecker.h"
+#include "KeywordDatabase.h"
+
+#include "opm/common/OpmLog/KeywordLocation.hpp"
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+
+#include <QHash>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace
+{
+const QSet<QString> ARRAY_SECTIONS = { "GRID", "EDIT", "PROPS", "REGIONS" };
+
+// Data keywords in the array sections that are not one value per cell
+const QSet<QString> NON_CELL_ARRAYS = { "MAPAXES", "COORDSYS", "GDORIENT", "MAPUNITS", "GRIDUNIT" };
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int intItem( const Opm::DeckRecord& record, const char* name, int fallback )
+{
+    if ( !record.hasItem( name ) ) return fallback;
+
+    const Opm::DeckItem& item = record.getItem( name );
+    return item.hasValue( 0 ) ? item.get<int>( 0 ) : fallback;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString stringItem( const Opm::DeckRecord& record, const char* name )
+{
+    if ( !record.hasItem( name ) ) return QString();
+
+    const Opm::DeckItem& item = record.getItem( name );
+    return item.hasValue( 0 ) ? QString::fromStdString( item.get<std::string>( 0 ) ) : QString();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Number of nonzero values in ACTNUM, counted straight from the data item
+//--------------------------------------------------------------------------------------------------
+qint64 activeCellCount( const Opm::DeckKeyword& actnum )
+{
+    const Opm::DeckItem&    item   = actnum.getDataRecord().getDataItem();
+    const std::vector<int>& values = item.getData<int>();
+    return static_cast<qint64>( values.size() - std::count( values.begin(), values.end(), 0 ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Check the value count of one array. Returns an empty message if the count is accepted.
+//--------------------------------------------------------------------------------------------------
+QString checkArrayLength( const Opm::DeckKeyword& keyword, const DataDeckGridChecker::GridArray& array, qint64 activeCellCount )
+{
+    const QString name   = QString::fromStdString( keyword.name() );
+    const qint64  actual = static_cast<qint64>( keyword.getDataRecord().getDataItem().data_size() );
+
+    const qint64 nx = array.nx, ny = array.ny, nz = array.nz;
+    const qint64 cellCount = nx * ny * nz;
+
+    // Arrays of a local grid are sized by its CARFIN
+    const QString dims = array.localGrid.isEmpty() ? QString( "DIMENS" ) : QString( "CARFIN %1" ).arg( array.localGrid );
+
+    // Accepted counts and a description of where the first one comes from
+    QList<qint64> expected;
+    QString       source;
+
+    if ( name == "COORD" )
+    {
+        expected << ( nx + 1 ) * ( ny + 1 ) * 6;
+        source = dims + " (NX+1)*(NY+1)*6";
+    }
+    else if ( name == "ZCORN" )
+    {
+        expected << cellCount * 8;
+        source = dims + " NX*NY*NZ*8";
+    }
+    else if ( array.box )
+    {
+        expected << array.box->cellCount();
+        if ( name == "TOPS" ) expected << array.box->layerCellCount();
+        source = array.box->toString();
+        if ( !array.localGrid.isEmpty() ) source += " in " + dims;
+    }
+    else
+    {
+        expected << cellCount;
+        if ( name == "TOPS" ) expected << nx * ny;
+        source = dims + " NX*NY*NZ";
+    }
+
+    if ( expected.contains( actual ) )
+    {
+        return QString();
+    }
+
+    // ACTNUM of the global grid
+    if ( activeCellCount >= 0 && array.localGrid.isEmpty() && actual == activeCellCount && activeCellCount != expected.first() )
+    {
+        return QString( "%1 has %2 values, which is the ACTNUM active cell count. Grid arrays need a value for every cell, "
+                        "%3 expects %4" )
+            .arg( name )
+            .arg( actual )
+            .arg( source )
+            .arg( expected.first() );
+    }
+
+    return QString( "%1 has %2 values, %3 expects %4" ).arg( name ).arg( actual ).arg( source ).arg( expected.first() );
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckGridChecker::GridBox::cellCount() const
+{
+    return qint64( i2 - i1 + 1 ) * ( j2 - j1 + 1 ) * ( k2 - k1 + 1 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckGridChecker::GridBox::layerCellCount() const
+{
+    return qint64( i2 - i1 + 1 ) * ( j2 - j1 + 1 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckGridChecker::GridBox::toString() const
+{
+    return QString( "BOX %1-%2 %3-%4 %5-%6" ).arg( i1 ).arg( i2 ).arg( j1 ).arg( j2 ).arg( k1 ).arg( k2 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckGridChecker::GridArray::cellOfOffset( qint64 offset, int* i, int* j, int* k ) const
+{
+    const int firstI = box ? box->i1 : 1;
+    const int firstJ = box ? box->j1 : 1;
+    const int firstK = box ? box->k1 : 1;
+    const int sizeI  = box ? box->i2 - box->i1 + 1 : nx;
+    const int sizeJ  = box ? box->j2 - box->j1 + 1 : ny;
+
+    *i = firstI + static_cast<int>( offset % sizeI );
+    *j = firstJ + static_cast<int>( ( offset / sizeI ) % sizeJ );
+    *k = firstK + static_cast<int>( offset / ( qint64( sizeI ) * sizeJ ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckGridChecker::GridArray::cellText( qint64 offset ) const
+{
+    int i = 0, j = 0, k = 0;
+    cellOfOffset( offset, &i, &j, &k );
+
+    const QString cell = QString( "(%1,%2,%3)" ).arg( i ).arg( j ).arg( k );
+    return localGrid.isEmpty() ? cell : localGrid + " " + cell;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckGridChecker::check( const Opm::Deck& deck )
+{
+    const Opm::DeckKeyword* actnum = nullptr;
+    std::vector<GridArray>  arrays = collectGridArrays( deck, &actnum );
+    if ( arrays.empty() )
+    {
+        return {};
+    }
+
+    // Only used to explain a common mistake, so the latest full ACTNUM is good enough
+    const qint64 activeCount = actnum ? activeCellCount( *actnum ) : -1;
+
+    auto checkOne = [&deck, activeCount]( const GridArray& array ) -> QString
+    { return checkArrayLength( deck[array.keywordIndex], array, activeCount ); };
+
+    const std::vector<QString> messages = QtConcurrent::blockingMapped<std::vector<QString>>( arrays, checkOne );
+
+    QList<DataDeckProblem> problems;
+    for ( size_t i = 0; i < arrays.size(); ++i )
+    {
+        if ( messages[i].isEmpty() ) continue;
+
+        const Opm::DeckKeyword& keyword  = deck[arrays[i].keywordIndex];
+        const auto&             location = keyword.location();
+
+        DataDeckProblem problem;
+        problem.severity     = DataDeckProblem::Severity::ERROR;
+        problem.message      = messages[i];
+        problem.filePath     = QString::fromStdString( location.filename );
+        problem.line         = static_cast<int>( location.lineno );
+        problem.keyword      = QString::fromStdString( keyword.name() );
+        problem.keywordIndex = static_cast<int>( arrays[i].keywordIndex );
+        problems.append( problem );
+    }
+
+    return problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Walk the deck once and collect the numeric cell arrays with the grid dimensions and BOX in effect.
+/// Inside CARFIN or REFINE and ENDFIN the dimensions are those of the local grid, and a BOX refers to
+/// its cells.
+/// Arrays before DIMENS or SPECGRID are skipped. The latest ACTNUM of the global grid outside a BOX
+/// is returned in actnum if requested.
+//--------------------------------------------------------------------------------------------------
+std::vector<DataDeckGridChecker::GridArray> DataDeckGridChecker::collectGridArrays( const Opm::Deck& deck, const Opm::DeckKeyword** actnum )
+{
+    KeywordDatabase* database = KeywordDatabase::instance();
+
+    std::vector<GridArray> arrays;
+    std::optional<GridBox> box;
+    QString                currentSection;
+    QString                localGrid;
+    int                    nx = 0, ny = 0, nz = 0;
+
+    QHash<QString, std::array<int, 3>> localGridDims; // NX, NY and NZ of each CARFIN by name
+
+    if ( actnum ) *actnum = nullptr;
+
+    for ( size_t i = 0; i < deck.size(); ++i )
+    {
+        const Opm::DeckKeyword& keyword = deck[i];
+        const QString           name    = QString::fromStdString( keyword.name() );
+
+        if ( database->isSection( name ) )
+        {
+            currentSection = name;
+            localGrid.clear();
+            box.reset();
+            continue;
+        }
+
+        if ( ( name == "DIMENS" || name == "SPECGRID" ) && keyword.size() > 0 )
+        {
+            const Opm::DeckRecord& record = keyword.getRecord( 0 );
+            nx                            = intItem( record, "NX", 0 );
+            ny                            = intItem( record, "NY", 0 );
+            nz                            = intItem( record, "NZ", 0 );
+            continue;
+        }
+
+        // A local grid refines a box of global cells, without NX, NY and NZ each cell is one local cell
+        if ( name == "CARFIN" && keyword.size() > 0 )
+        {
+            const Opm::DeckRecord& record = keyword.getRecord( 0 );
+
+            const int i1 = intItem( record, "I1", 1 ), i2 = intItem( record, "I2", nx );
+            const int j1 = intItem( record, "J1", 1 ), j2 = intItem( record, "J2", ny );
+            const int k1 = intItem( record, "K1", 1 ), k2 = intItem( record, "K2", nz );
+
+            localGrid = stringItem( record, "NAME" );
+            if ( localGrid.isEmpty() ) localGrid = name;
+
+            localGridDims[localGrid] = { intItem( record, "NX", i2 - i1 + 1 ),
+                                         intItem( record, "NY", j2 - j1 + 1 ),
+                                         intItem( record, "NZ", k2 - k1 + 1 ) };
+            box.reset();
+            continue;
+        }
+
+        // Selects a local grid defined by CARFIN for the following arrays. An unknown grid has no
+        // dimensions, so its arrays are skipped.
+        if ( name == "REFINE" && keyword.size() > 0 )
+        {
+            localGrid = stringItem( keyword.getRecord( 0 ), "NAME" );
+            if ( localGrid.isEmpty() ) localGrid = name;
+            box.reset();
+            continue;
+        }
+
+        if ( name == "ENDFIN" )
+        {
+            localGrid.clear();
+            box.reset();
+            continue;
+        }
+
+        const std::array<int, 3> localDims = localGridDims.value( localGrid, { 0, 0, 0 } );
+        const int                gridNx    = localGrid.isEmpty() ? nx : localDims[0];
+        const int                gridNy    = localGrid.isEmpty() ? ny : localDims[1];
+        const int                gridNz    = localGrid.isEmpty() ? nz : localDims[2];
+
+        if ( name == "BOX" && keyword.size() > 0 )
+        {
+            const Opm::DeckRecord& record = keyword.getRecord( 0 );
+
+            GridBox newBox;
+            newBox.i1 = intItem( record, "I1", 1 );
+            newBox.i2 = intItem( record, "I2", gridNx );
+            newBox.j1 = intItem( record, "J1", 1 );
+            newBox.j2 = intItem( record, "J2", gridNy );
+            newBox.k1 = intItem( record, "K1", 1 );
+            newBox.k2 = intItem( record, "K2", gridNz );
+            box       = newBox;
+            continue;
+        }
+
+        if ( name == "ENDBOX" )
+        {
+            box.reset();
+            continue;
+        }
+
+        if ( !ARRAY_SECTIONS.contains( currentSection ) || !keyword.isDataKeyword() || NON_CELL_ARRAYS.contains( name ) )
+        {
+            continue;
+        }
+
+        const Opm::type_tag type = keyword.getDataRecord().getDataItem().getType();
+        if ( type != Opm::type_tag::integer && type != Opm::type_tag::fdouble )
+        {
+            continue;
+        }
+
+        if ( name == "ACTNUM" && !box && localGrid.isEmpty() && actnum )
+        {
+            *actnum = &keyword;
+        }
+
+        if ( gridNx <= 0 || gridNy <= 0 || gridNz <= 0 )
+        {
+            continue;
+        }
+
+        GridArray array;
+        array.keywordIndex = i;
+        array.nx           = gridNx;
+        array.ny           = gridNy;
+        array.nz           = gridNz;
+        array.box          = box;
+        array.localGrid    = localGrid;
+        arrays.push_back( array );
+    }
+
+    return arrays;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "DataDeckProblem.h"
+
+#include <optional>
+#include <vector>
+
+namespace Opm
+{
+class Deck;
+class DeckKeyword;
+} // namespace Opm
+
+//==================================================================================================
+/// Checks the length of grid property arrays in the GRID, EDIT, PROPS and REGIONS sections against
+/// the grid size from DIMENS or SPECGRID, or against the current BOX. Arrays between CARFIN or
+/// REFINE and ENDFIN are checked against the size of the local grid.
+///
+/// Value counts are read from the parsed data items, where repeat counts like 100*0.25 are already
+/// expanded, so no text is generated. The keyword layout is collected in one sequential pass, the
+/// arrays are then checked in parallel.
+//==================================================================================================
+class DataDeckGridChecker
+{
+public:
+    struct GridBox
+    {
+        int i1 = 0, i2 = 0, j1 = 0, j2 = 0, k1 = 0, k2 = 0; // 1-based, inclusive
+
+        qint64  cellCount() const;
+        qint64  layerCellCount() const;
+        QString toString() const;
+    };
+
+    // A numeric cell array in the GRID, EDIT, PROPS or REGIONS section, with the grid and BOX in effect
+    struct GridArray
+    {
+        size_t                 keywordIndex = 0;
+        int                    nx = 0, ny = 0, nz = 0;
+        std::optional<GridBox> box;
+        QString                localGrid; // Inside CARFIN or REFINE and ENDFIN, nx, ny and nz are then the local grid's
+
+        // 1-based (I,J,K) of a value offset in the array, taking the BOX into account
+        void    cellOfOffset( qint64 offset, int* i, int* j, int* k ) const;
+        QString cellText( qint64 offset ) const; // "(I,J,K)", prefixed by the local grid name
+    };
+
+    static QList<DataDeckProblem> check( const Opm::Deck& deck );
+
+    static std::vector<GridArray> collectGridArrays( const Opm::Deck& deck, const Opm::DeckKeyword** actnum = nullptr );
+};
@@ -0,0 +1,144 @@
+#include "DataDeckKeywordScanner.h"
+
+#include <QRegularExpression>
+
+namespace
+{
+// Keyword names are up to eight characters, starting with a letter
+const QRegularExpression KEYWORD_NAME_REGEX( "^[A-Za-z][A-Za-z0-9_+-]{0,7}$" );
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckKeywordScanner::DataDeckKeywordScanner()
+    : m_inRecord( false )
+    , m_isTerminated( false )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckKeywordScanner::addLine( int lineNumber, const QString& line )
+{
+    const QString trimmedLine = stripComment( line ).trimmed();
+    if ( trimmedLine.isEmpty() )
+    {
+        return false;
+    }
+
+    // A single word inside an unterminated record is a value, not a keyword
+    if ( !m_inRecord && KEYWORD_NAME_REGEX.match( trimmedLine ).hasMatch() )
+    {
+        closeKeyword();
+        m_current.keyword   = trimmedLine.toUpper();
+        m_current.firstLine = lineNumber;
+        m_current.lastLine  = lineNumber;
+        m_isTerminated      = false;
+        return true;
+    }
+
+    // Data after the terminating "/" belongs to no keyword
+    if ( m_current.firstLine < 0 || m_isTerminated )
+    {
+        return false;
+    }
+
+    m_current.lastLine = lineNumber;
+    if ( trimmedLine == "/" )
+    {
+        m_isTerminated = true;
+        m_inRecord     = false;
+    }
+    else
+    {
+        m_inRecord = !hasRecordTerminator( trimmedLine );
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckKeywordScanner::finish()
+{
+    closeKeyword();
+    m_inRecord = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckKeywordScanner::closeKeyword()
+{
+    if ( m_current.firstLine >= 0 )
+    {
+        m_keywords.append( m_current );
+    }
+    m_current = KeywordLines();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckKeywordScanner::KeywordLines> DataDeckKeywordScanner::scanText( const QString& text )
+{
+    DataDeckKeywordScanner scanner;
+
+    int lineNumber = 0;
+    int lineStart  = 0;
+    while ( lineStart <= text.size() )
+    {
+        int lineEnd = text.indexOf( '\n', lineStart );
+        if ( lineEnd < 0 ) lineEnd = text.size();
+
+        scanner.addLine( lineNumber, text.mid( lineStart, lineEnd - lineStart ) );
+
+        ++lineNumber;
+        lineStart = lineEnd + 1;
+    }
+
+    scanner.finish();
+    return scanner.keywords();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckKeywordScanner::stripComment( const QString& line )
+{
+    bool isQuoted = false;
+    for ( int i = 0; i < line.size(); ++i )
+    {
+        if ( line[i] == '\'' )
+        {
+            isQuoted = !isQuoted;
+        }
+        else if ( !isQuoted && line[i] == '-' && i + 1 < line.size() && line[i + 1] == '-' )
+        {
+            return line.left( i );
+        }
+    }
+    return line;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// A "/" outside quoted strings ends the record, the rest of the line is ignored by the parser
+//--------------------------------------------------------------------------------------------------
+bool DataDeckKeywordScanner::hasRecordTerminator( const QString& line )
+{
+    bool isQuoted = false;
+    for ( const QChar character : line )
+    {
+        if ( character == '\'' )
+        {
+            isQuoted = !isQuoted;
+        }
+        else if ( !isQuoted && character == '/' )
+        {
+            return true;
+        }
+    }
+    return false;
+}
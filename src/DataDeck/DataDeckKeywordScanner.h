@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+//==================================================================================================
+/// Finds the line range of each keyword in DATA file text, fed one line at a time.
+///
+/// A keyword starts at a line holding only a keyword name, outside an unterminated record. It ends
+/// at a line holding only "/", or at its last data line before the next keyword, which is the
+/// trailing "/" of the last record for fixed size keywords. Comments and blank lines after the last
+/// data line are not part of the keyword.
+//==================================================================================================
+class DataDeckKeywordScanner
+{
+public:
+    struct KeywordLines
+    {
+        QString keyword;
+        int     firstLine = -1; // The keyword name line, 0-based
+        int     lastLine  = -1; // Inclusive, equal to firstLine for keywords without data
+    };
+
+    DataDeckKeywordScanner();
+
+    // Returns true if the line starts a keyword. Lines must be added in order.
+    bool addLine( int lineNumber, const QString& line );
+    void finish();
+
+    const QList<KeywordLines>& keywords() const { return m_keywords; }
+
+    static QList<KeywordLines> scanText( const QString& text );
+
+    // Comments start with "--" outside quoted strings
+    static QString stripComment( const QString& line );
+    static bool    hasRecordTerminator( const QString& line );
+
+private:
+    void closeKeyword();
+
+private:
+    QList<KeywordLines> m_keywords;
+    KeywordLines        m_current;
+    bool                m_inRecord; // Data was read since the last "/"
+    bool                m_isTerminated; // The current keyword ended with a "/" line
+};
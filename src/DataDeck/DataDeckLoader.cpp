@@ -0,0 +1,203 @@
+#include "DataDeckLoader.h"
+#include "DataDeckMetrics.h"
+#include "DataDeckTrace.h"
+#include "RimDataDeck.h"
+#include "RimIncludeFile.h"
+
+#include "opm/input/eclipse/Deck/Deck.hpp"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <optional>
+#include <stdexcept>
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckLoadResult::totalParseTimeNs() const
+{
+    qint64 totalNs = parseTimeNs;
+    for ( qint64 includeParseTimeNs : includeParseTimesNs )
+    {
+        totalNs += includeParseTimeNs;
+    }
+    return totalNs;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckLoader::DataDeckLoader( QObject* parent )
+    : QObject( parent )
+    , m_activeWatcher( nullptr )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckLoader::~DataDeckLoader()
+{
+    // Watchers are children of the loader. A parse still running in the thread pool completes on its
+    // own, its result is dropped together with the watcher.
+    m_activeWatcher = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Start parsing a DATA file in the global thread pool. A load already in progress is superseded.
+//--------------------------------------------------------------------------------------------------
+void DataDeckLoader::load( const QString& filePath )
+{
+    if ( isLoading() )
+    {
+        cancel();
+    }
+
+    m_currentFilePath = filePath;
+
+    auto* watcher = new QFutureWatcher<DataDeckLoadResult>( this );
+    connect( watcher, &QFutureWatcher<DataDeckLoadResult>::finished, this, [this, watcher]() { onJobFinished( watcher ); } );
+
+    m_activeWatcher = watcher;
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( &DataDeckLoader::parseDeckWithIncludes, filePath ) );
+
+    emit loadStarted( filePath );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The Opm parser cannot be interrupted, so canceling detaches from the job and discards its result
+/// when it arrives. The GUI is free immediately.
+//--------------------------------------------------------------------------------------------------
+void DataDeckLoader::cancel()
+{
+    if ( !m_activeWatcher )
+    {
+        return;
+    }
+
+    m_activeWatcher = nullptr;
+
+    QString filePath = m_currentFilePath;
+    m_currentFilePath.clear();
+
+    emit loadCanceled( filePath );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckLoader::isLoading() const
+{
+    return m_activeWatcher != nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckLoader::currentFilePath() const
+{
+    return m_currentFilePath;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckLoader::onJobFinished( QFutureWatcher<DataDeckLoadResult>* watcher )
+{
+    watcher->deleteLater();
+
+    if ( watcher != m_activeWatcher )
+    {
+        // Canceled or superseded by a newer load
+        return;
+    }
+
+    m_activeWatcher = nullptr;
+    m_currentFilePath.clear();
+
+    const DataDeckLoadResult result = watcher->result();
+    if ( result.success() )
+    {
+        DataDeckMetrics::recordParse( result.totalParseTimeNs() );
+    }
+
+    emit loadFinished( result );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Parse the main deck and every include file reachable from it, and scan the text of each parsed
+/// file for its INCLUDE statements and keyword positions. setDeck() builds the tree on the GUI thread
+/// from these results without parsing or reading the files again.
+//--------------------------------------------------------------------------------------------------
+DataDeckLoadResult DataDeckLoader::parseDeckWithIncludes( const QString& filePath )
+{
+    DATADECK_TRACE_SCOPE_DETAIL( "loader", "DataDeckLoader::parseDeckWithIncludes", filePath );
+
+    DataDeckLoadResult result;
+    result.filePath = filePath;
+
+    QElapsedTimer parseTimer;
+    parseTimer.start();
+
+    try
+    {
+        result.deck        = RimDataDeck::parseDeckFile( filePath );
+        result.parseTimeNs = parseTimer.nsecsElapsed();
+    }
+    catch ( const std::exception& e )
+    {
+        result.errorMessage = QString::fromStdString( e.what() );
+        return result;
+    }
+
+    QStringList   pendingFiles{ filePath };
+    QSet<QString> visitedFiles{ QFileInfo( filePath ).absoluteFilePath() };
+
+    while ( !pendingFiles.isEmpty() )
+    {
+        QString currentFile = pendingFiles.takeFirst();
+        QString basePath    = QFileInfo( currentFile ).absolutePath();
+
+        std::optional<DataDeckFileScan> fileScan = DataDeckFileScan::scanFile( currentFile );
+        if ( !fileScan )
+        {
+            continue;
+        }
+        result.fileScans.insert( currentFile, *fileScan );
+
+        for ( const QString& includePath : fileScan->includePaths )
+        {
+            QString resolvedPath = RimIncludeFile::resolveAbsolutePath( includePath, basePath );
+            if ( visitedFiles.contains( resolvedPath ) )
+            {
+                continue;
+            }
+            visitedFiles.insert( resolvedPath );
+
+            QFileInfo info( resolvedPath );
+            if ( !info.exists() || !info.isFile() )
+            {
+                continue;
+            }
+
+            try
+            {
+                parseTimer.restart();
+                result.includeDecks[resolvedPath]        = RimDataDeck::parseDeckFile( resolvedPath );
+                result.includeParseTimesNs[resolvedPath] = parseTimer.nsecsElapsed();
+                pendingFiles.append( resolvedPath );
+            }
+            catch ( const std::exception& )
+            {
+                result.includeDecks[resolvedPath] = nullptr;
+            }
+        }
+    }
+
+    return result;
+}
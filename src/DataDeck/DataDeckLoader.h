@@ -0,0 +1,65 @@
+#pragma once
+
+#include "DataDeckFileScan.h"
+
+#include <QMap>
+#include <QObject>
+#include <QString>
+
+#include <memory>
+
+namespace Opm
+{
+class Deck;
+}
+
+template <typename T>
+class QFutureWatcher;
+
+//==================================================================================================
+/// Result of parsing a DATA file and its include files off the GUI thread
+//==================================================================================================
+struct DataDeckLoadResult
+{
+    QString                                   filePath;
+    std::shared_ptr<Opm::Deck>                deck;
+    QMap<QString, std::shared_ptr<Opm::Deck>> includeDecks; // Keyed by resolved path, null if parsing failed
+    QString                                   errorMessage;
+    qint64                                    parseTimeNs = -1;
+    QMap<QString, qint64>                     includeParseTimesNs; // Keyed by resolved path, for the deck profile
+    QMap<QString, DataDeckFileScan>           fileScans; // The deck and each parsed include file, keyed as includeDecks
+
+    bool   success() const { return deck != nullptr; }
+    qint64 totalParseTimeNs() const; // The deck and its include files
+};
+
+//==================================================================================================
+/// Parses DATA files on a worker thread. The PDM tree is built by the receiver on the GUI thread.
+//==================================================================================================
+class DataDeckLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DataDeckLoader( QObject* parent = nullptr );
+    ~DataDeckLoader() override;
+
+    void    load( const QString& filePath );
+    void    cancel();
+    bool    isLoading() const;
+    QString currentFilePath() const;
+
+    static DataDeckLoadResult parseDeckWithIncludes( const QString& filePath );
+
+signals:
+    void loadStarted( const QString& filePath );
+    void loadFinished( const DataDeckLoadResult& result );
+    void loadCanceled( const QString& filePath );
+
+private:
+    void onJobFinished( QFutureWatcher<DataDeckLoadResult>* watcher );
+
+private:
+    QFutureWatcher<DataDeckLoadResult>* m_activeWatcher;
+    QString                             m_currentFilePath;
+};
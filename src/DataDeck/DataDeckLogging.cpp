@@ -0,0 +1,69 @@
+#include "DataDeckLogging.h"
+
+#include <QMap>
+
+// Debug messages are off unless enabled by a filter rule
+Q_LOGGING_CATEGORY( logDeck, "dataobjecteditor.deck", QtInfoMsg )
+Q_LOGGING_CATEGORY( logInclude, "dataobjecteditor.include", QtInfoMsg )
+Q_LOGGING_CATEGORY( logKeywords, "dataobjecteditor.keywords", QtInfoMsg )
+Q_LOGGING_CATEGORY( logValidation, "dataobjecteditor.validation", QtInfoMsg )
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+/// Debug state set from the GUI, keyed by category name. Rules from QT_LOGGING_RULES apply on top.
+//--------------------------------------------------------------------------------------------------
+QMap<QString, bool>& debugRules()
+{
+    static QMap<QString, bool> rules;
+    return rules;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const QLoggingCategory* findCategory( const QString& categoryName )
+{
+    for ( const QLoggingCategory* category : { &logDeck(), &logInclude(), &logKeywords(), &logValidation() } )
+    {
+        if ( categoryName == category->categoryName() )
+        {
+            return category;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QStringList DataDeckLogging::categoryNames()
+{
+    return { logDeck().categoryName(), logInclude().categoryName(), logKeywords().categoryName(), logValidation().categoryName() };
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckLogging::isDebugEnabled( const QString& categoryName )
+{
+    const QLoggingCategory* category = findCategory( categoryName );
+    return category && category->isDebugEnabled();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Replaces the filter rules set through this class, the categories are updated immediately
+//--------------------------------------------------------------------------------------------------
+void DataDeckLogging::setDebugEnabled( const QString& categoryName, bool enabled )
+{
+    debugRules()[categoryName] = enabled;
+
+    QStringList rules;
+    for ( auto it = debugRules().cbegin(); it != debugRules().cend(); ++it )
+    {
+        rules << QString( "%1.debug=%2" ).arg( it.key() ).arg( it.value() ? "true" : "false" );
+    }
+    QLoggingCategory::setFilterRules( rules.join( '\n' ) );
+}
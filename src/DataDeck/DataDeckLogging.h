@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QLoggingCategory>
+#include <QStringList>
+
+Q_DECLARE_LOGGING_CATEGORY( logDeck ) // dataobjecteditor.deck
+Q_DECLARE_LOGGING_CATEGORY( logInclude ) // dataobjecteditor.include
+Q_DECLARE_LOGGING_CATEGORY( logKeywords ) // dataobjecteditor.keywords
+Q_DECLARE_LOGGING_CATEGORY( logValidation ) // dataobjecteditor.validation
+
+//==================================================================================================
+/// Logging categories of the deck pipeline.
+///
+/// Debug output is off by default. qCDebug() tests the category before its arguments are formatted,
+/// so a disabled statement costs one branch, and with DATA_OBJECT_EDITOR_DEBUG_LOGGING=OFF the
+/// statements are compiled out. Categories are switched at runtime from Tools > Debug Logging, or
+/// with QT_LOGGING_RULES, for example "dataobjecteditor.include.debug=true".
+//==================================================================================================
+class DataDeckLogging
+{
+public:
+    static QStringList categoryNames();
+    static bool        isDebugEnabled( const QString& categoryName );
+    static void        setDebugEnabled( const QString& categoryName, bool enabled );
+};
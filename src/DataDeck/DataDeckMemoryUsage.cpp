@@ -0,0 +1,205 @@
+#include "DataDeckMemoryUsage.h"
+
+#include "cafPdmFieldHandle.h"
+#include "cafPdmObjectHandle.h"
+
+#include "opm/common/OpmLog/KeywordLocation.hpp"
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+#include "opm/input/eclipse/Deck/UDAValue.hpp"
+
+#include <QLocale>
+#include <QStringList>
+#include <QTextDocument>
+
+#include <vector>
+
+namespace
+{
+// Strings up to this length are stored inside std::string (libstdc++ and MSVC)
+constexpr size_t SMALL_STRING_CAPACITY = 15;
+
+// QArrayData header in front of the characters of a QString
+constexpr qint64 QSTRING_HEADER_BYTES = 16;
+
+// Heap blocks of the UI and XML capabilities caf allocates for each object and each field, approximate
+constexpr qint64 PDM_OBJECT_OVERHEAD_BYTES = 192;
+constexpr qint64 PDM_FIELD_OVERHEAD_BYTES  = 96;
+
+// Block map entry, layout and user data of a text block, approximate
+constexpr qint64 TEXT_BLOCK_OVERHEAD_BYTES = 160;
+
+// Each deck value has a status byte telling whether it was defaulted
+constexpr qint64 VALUE_STATUS_BYTES = 1;
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::totalBytes() const
+{
+    return parsedDeckBytes + pdmObjectBytes + editorDocumentBytes + includeDeckBytes + cacheBytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckMemoryUsage& DataDeckMemoryUsage::operator+=( const DataDeckMemoryUsage& other )
+{
+    parsedDeckBytes += other.parsedDeckBytes;
+    pdmObjectBytes += other.pdmObjectBytes;
+    editorDocumentBytes += other.editorDocumentBytes;
+    includeDeckBytes += other.includeDeckBytes;
+    cacheBytes += other.cacheBytes;
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QJsonObject DataDeckMemoryUsage::toJson() const
+{
+    QJsonObject object;
+    object["parsedDeckBytes"]     = parsedDeckBytes;
+    object["pdmObjectBytes"]      = pdmObjectBytes;
+    object["editorDocumentBytes"] = editorDocumentBytes;
+    object["includeDeckBytes"]    = includeDeckBytes;
+    object["cacheBytes"]          = cacheBytes;
+    object["totalBytes"]          = totalBytes();
+    return object;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckMemoryUsage::toText() const
+{
+    const QList<QPair<QString, qint64>> rows = { { "Parsed deck", parsedDeckBytes },
+                                                 { "Project tree", pdmObjectBytes },
+                                                 { "Editor document", editorDocumentBytes },
+                                                 { "Include decks", includeDeckBytes },
+                                                 { "Caches", cacheBytes },
+                                                 { "Total", totalBytes() } };
+
+    QStringList lines;
+    for ( const auto& [name, bytes] : rows )
+    {
+        lines << QString( "%1 %2" ).arg( name, -16 ).arg( formatBytes( bytes ), 10 );
+    }
+    return lines.join( '\n' );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckMemoryUsage::formatBytes( qint64 bytes )
+{
+    return QLocale::c().formattedDataSize( bytes, 1, QLocale::DataSizeTraditionalFormat );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The keywords are held by value in the deck, each with its records and items
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::deckBytes( const Opm::Deck& deck )
+{
+    qint64 bytes = sizeof( Opm::Deck );
+
+    for ( size_t keywordIndex = 0; keywordIndex < deck.size(); ++keywordIndex )
+    {
+        const Opm::DeckKeyword& keyword = deck[keywordIndex];
+
+        bytes += sizeof( Opm::DeckKeyword ) + stringBytes( keyword.name() );
+        bytes += stringBytes( keyword.location().keyword ) + stringBytes( keyword.location().filename );
+
+        for ( size_t recordIndex = 0; recordIndex < keyword.size(); ++recordIndex )
+        {
+            const Opm::DeckRecord& record = keyword.getRecord( recordIndex );
+
+            bytes += sizeof( Opm::DeckRecord );
+            for ( size_t itemIndex = 0; itemIndex < record.size(); ++itemIndex )
+            {
+                bytes += itemBytes( record.getItem( itemIndex ) );
+            }
+        }
+    }
+
+    return bytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::itemBytes( const Opm::DeckItem& item )
+{
+    const qint64 valueCount = static_cast<qint64>( item.data_size() );
+
+    qint64 bytes = sizeof( Opm::DeckItem ) + stringBytes( item.name() ) + valueCount * VALUE_STATUS_BYTES;
+
+    switch ( item.getType() )
+    {
+        case Opm::type_tag::integer:
+            bytes += valueCount * static_cast<qint64>( sizeof( int ) );
+            break;
+        case Opm::type_tag::fdouble:
+            bytes += valueCount * static_cast<qint64>( sizeof( double ) );
+            break;
+        case Opm::type_tag::string:
+            for ( const std::string& value : item.getData<std::string>() )
+            {
+                bytes += sizeof( std::string ) + stringBytes( value );
+            }
+            break;
+        case Opm::type_tag::uda:
+            for ( const Opm::UDAValue& value : item.getData<Opm::UDAValue>() )
+            {
+                bytes += sizeof( Opm::UDAValue );
+                if ( !value.is<double>() ) bytes += stringBytes( value.get<std::string>() );
+            }
+            break;
+        default:
+            break;
+    }
+
+    return bytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::documentBytes( const QTextDocument& document )
+{
+    return static_cast<qint64>( document.characterCount() ) * static_cast<qint64>( sizeof( QChar ) ) +
+           static_cast<qint64>( document.blockCount() ) * TEXT_BLOCK_OVERHEAD_BYTES;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The capability objects caf allocates besides the C++ object itself, add sizeof the object
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::pdmOverheadBytes( const caf::PdmObjectHandle& object )
+{
+    std::vector<caf::PdmFieldHandle*> fields;
+    object.fields( fields );
+
+    return PDM_OBJECT_OVERHEAD_BYTES + static_cast<qint64>( fields.size() ) * PDM_FIELD_OVERHEAD_BYTES;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Heap bytes of the string, the QString object itself is part of its owner
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::stringBytes( const QString& text )
+{
+    if ( text.isNull() ) return 0;
+
+    return QSTRING_HEADER_BYTES + ( static_cast<qint64>( text.capacity() ) + 1 ) * static_cast<qint64>( sizeof( QChar ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Heap bytes of the string, short strings are stored inside the std::string object
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMemoryUsage::stringBytes( const std::string& text )
+{
+    return text.capacity() > SMALL_STRING_CAPACITY ? static_cast<qint64>( text.capacity() ) + 1 : 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+#include <string>
+
+namespace Opm
+{
+class Deck;
+class DeckItem;
+} // namespace Opm
+
+namespace caf
+{
+class PdmObjectHandle;
+}
+
+class QTextDocument;
+
+//==================================================================================================
+/// Estimated bytes held by one RimDataDeck, broken down by owner.
+///
+/// The estimates add the object sizes and the heap blocks of strings and value arrays, they are not
+/// measured from the allocator. Allocator overhead and implicitly shared strings are not accounted
+/// for, so compare the numbers between decks and over time rather than with the process size.
+//==================================================================================================
+struct DataDeckMemoryUsage
+{
+    qint64 parsedDeckBytes     = 0; // Opm::Deck keywords, records and values
+    qint64 pdmObjectBytes      = 0; // Sections, keywords and items of the project tree
+    qint64 editorDocumentBytes = 0; // Text document, only while the deck is shown in the editor
+    qint64 includeDeckBytes    = 0; // Parsed decks and trees of the include files
+    qint64 cacheBytes          = 0; // Keyword hashes and text positions
+
+    qint64      totalBytes() const;
+    DataDeckMemoryUsage& operator+=( const DataDeckMemoryUsage& other );
+
+    QJsonObject toJson() const;
+    QString     toText() const;
+
+    static QString formatBytes( qint64 bytes );
+
+    // Estimates of the parts
+    static qint64 deckBytes( const Opm::Deck& deck );
+    static qint64 itemBytes( const Opm::DeckItem& item );
+    static qint64 documentBytes( const QTextDocument& document );
+    static qint64 pdmOverheadBytes( const caf::PdmObjectHandle& object );
+    static qint64 stringBytes( const QString& text );
+    static qint64 stringBytes( const std::string& text );
+};
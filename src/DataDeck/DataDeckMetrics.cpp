@@ -0,0 +1,94 @@
+#include "DataDeckMetrics.h"
+
+#include <QFutureWatcher>
+
+#include <memory>
+
+std::atomic<qint64> DataDeckMetrics::sm_lastParseNs( -1 );
+std::atomic<qint64> DataDeckMetrics::sm_lastHighlightPassNs( -1 );
+std::atomic<qint64> DataDeckMetrics::sm_lastKeystrokeLatencyNs( -1 );
+std::atomic<int>    DataDeckMetrics::sm_backgroundJobCount( 0 );
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckMetrics::recordParse( qint64 ns )
+{
+    sm_lastParseNs.store( ns, std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMetrics::lastParseNs()
+{
+    return sm_lastParseNs.load( std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckMetrics::recordHighlightPass( qint64 ns )
+{
+    sm_lastHighlightPassNs.store( ns, std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMetrics::lastHighlightPassNs()
+{
+    return sm_lastHighlightPassNs.load( std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckMetrics::recordKeystrokeLatency( qint64 ns )
+{
+    sm_lastKeystrokeLatencyNs.store( ns, std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckMetrics::lastKeystrokeLatencyNs()
+{
+    return sm_lastKeystrokeLatencyNs.load( std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Call before setting the future. A job whose result is discarded, like a canceled load, is counted
+/// until it completes since it still occupies the thread pool. A watcher deleted before its job
+/// finishes can no longer report it, so the job is uncounted then. Whichever comes first uncounts.
+//--------------------------------------------------------------------------------------------------
+void DataDeckMetrics::trackBackgroundJob( QFutureWatcherBase* watcher )
+{
+    sm_backgroundJobCount.fetch_add( 1, std::memory_order_relaxed );
+
+    auto isCounted = std::make_shared<bool>( true );
+    auto uncount   = [isCounted]()
+    {
+        if ( !*isCounted ) return;
+        *isCounted = false;
+        sm_backgroundJobCount.fetch_sub( 1, std::memory_order_relaxed );
+    };
+    QObject::connect( watcher, &QFutureWatcherBase::finished, uncount );
+    QObject::connect( watcher, &QObject::destroyed, uncount );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckMetrics::addQueuedJobs( int count )
+{
+    sm_backgroundJobCount.fetch_add( count, std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckMetrics::backgroundJobCount()
+{
+    return sm_backgroundJobCount.load( std::memory_order_relaxed );
+}
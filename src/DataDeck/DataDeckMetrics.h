@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+
+class QFutureWatcherBase;
+
+//==================================================================================================
+/// Latest timings of the load and edit pipeline and the number of background jobs, read by the
+/// performance HUD in the status bar. Values can be recorded from any thread, -1 if not measured yet.
+//==================================================================================================
+class DataDeckMetrics
+{
+public:
+    // Parse of a DATA file including its include files, by a load, a validation or a sync
+    static void   recordParse( qint64 ns );
+    static qint64 lastParseNs();
+
+    // Work time of a complete highlight pass over the document, summed over its time slices
+    static void   recordHighlightPass( qint64 ns );
+    static qint64 lastHighlightPassNs();
+
+    // Time from a key press in the editor to the repaint showing its result
+    static void   recordKeystrokeLatency( qint64 ns );
+    static qint64 lastKeystrokeLatencyNs();
+
+    // Counts the job from now until the watcher reports it finished or is deleted
+    static void trackBackgroundJob( QFutureWatcherBase* watcher );
+
+    // Jobs waiting in a queue of their own before they are submitted, negative when they leave it
+    static void addQueuedJobs( int count );
+
+    static int backgroundJobCount();
+
+private:
+    static std::atomic<qint64> sm_lastParseNs;
+    static std::atomic<qint64> sm_lastHighlightPassNs;
+    static std::atomic<qint64> sm_lastKeystrokeLatencyNs;
+    static std::atomic<int>    sm_backgroundJobCount;
+};
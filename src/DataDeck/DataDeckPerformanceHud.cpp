@@ -0,0 +1,135 @@
+#include "DataDeckPerformanceHud.h"
+#include "DataDeckMemoryUsage.h"
+#include "DataDeckMetrics.h"
+#include "RimDataDeck.h"
+#include "RimDataDeckTextEditor.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QContextMenuEvent>
+#include <QFileInfo>
+#include <QMenu>
+#include <QTimer>
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+/// "-" until the first measurement
+//--------------------------------------------------------------------------------------------------
+QString milliseconds( qint64 ns )
+{
+    if ( ns < 0 ) return "-";
+
+    const double ms = ns / 1.0e6;
+    return QString::number( ms, 'f', ms < 10.0 ? 1 : 0 ) + " ms";
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckPerformanceHud::DataDeckPerformanceHud( RimDataDeckTextEditor* textEditor, QWidget* parent )
+    : QLabel( parent )
+    , m_textEditor( textEditor )
+    , m_refreshTimer( nullptr )
+    , m_memoryBytes( -1 )
+    , m_ticksSinceMemoryUpdate( 0 )
+{
+    setToolTip( "Last parse, last highlight pass, keystroke-to-paint latency, estimated memory of the deck in the "
+                "editor and background jobs queued or running.\nRight-click to copy the numbers." );
+
+    m_refreshTimer = new QTimer( this );
+    m_refreshTimer->setInterval( REFRESH_MS );
+    connect( m_refreshTimer, &QTimer::timeout, this, &DataDeckPerformanceHud::refresh );
+
+    refresh();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckPerformanceHud::reportText() const
+{
+    QStringList lines;
+    if ( m_memoryDeck )
+    {
+        lines << QString( "Deck: %1" ).arg( QFileInfo( m_memoryDeck->filePath() ).fileName() );
+    }
+    lines << QString( "Last parse: %1" ).arg( milliseconds( DataDeckMetrics::lastParseNs() ) );
+    lines << QString( "Last highlight pass: %1" ).arg( milliseconds( DataDeckMetrics::lastHighlightPassNs() ) );
+    lines << QString( "Keystroke to paint: %1" ).arg( milliseconds( DataDeckMetrics::lastKeystrokeLatencyNs() ) );
+    lines << QString( "Deck memory: %1" ).arg( m_memoryBytes < 0 ? QString( "-" ) : DataDeckMemoryUsage::formatBytes( m_memoryBytes ) );
+    lines << QString( "Background jobs: %1" ).arg( DataDeckMetrics::backgroundJobCount() );
+    return lines.join( '\n' );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckPerformanceHud::refresh()
+{
+    RimDataDeck* dataDeck = m_textEditor ? m_textEditor->dataDeck() : nullptr;
+    if ( dataDeck != m_memoryDeck.p() || ++m_ticksSinceMemoryUpdate >= MEMORY_REFRESH_TICKS )
+    {
+        m_memoryDeck = dataDeck;
+        updateMemoryUsage();
+    }
+
+    setText( QString( "Parse %1 | Highlight %2 | Key to paint %3 | Deck %4 | Jobs %5" )
+                 .arg( milliseconds( DataDeckMetrics::lastParseNs() ) )
+                 .arg( milliseconds( DataDeckMetrics::lastHighlightPassNs() ) )
+                 .arg( milliseconds( DataDeckMetrics::lastKeystrokeLatencyNs() ) )
+                 .arg( m_memoryBytes < 0 ? QString( "-" ) : DataDeckMemoryUsage::formatBytes( m_memoryBytes ) )
+                 .arg( DataDeckMetrics::backgroundJobCount() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckPerformanceHud::copyToClipboard()
+{
+    refresh();
+    QApplication::clipboard()->setText( reportText() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckPerformanceHud::showEvent( QShowEvent* event )
+{
+    QLabel::showEvent( event );
+
+    m_ticksSinceMemoryUpdate = MEMORY_REFRESH_TICKS;
+    refresh();
+    m_refreshTimer->start();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckPerformanceHud::hideEvent( QHideEvent* event )
+{
+    m_refreshTimer->stop();
+
+    QLabel::hideEvent( event );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckPerformanceHud::contextMenuEvent( QContextMenuEvent* event )
+{
+    QMenu menu( this );
+    menu.addAction( "Copy Performance Numbers", this, &DataDeckPerformanceHud::copyToClipboard );
+    menu.exec( event->globalPos() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckPerformanceHud::updateMemoryUsage()
+{
+    m_ticksSinceMemoryUpdate = 0;
+    m_memoryBytes            = m_memoryDeck ? m_memoryDeck->memoryUsage().totalBytes() : -1;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "cafPdmPointer.h"
+
+#include <QLabel>
+
+class RimDataDeck;
+class RimDataDeckTextEditor;
+class QTimer;
+
+//==================================================================================================
+/// Status bar readout of the last parse, highlight pass and keystroke-to-paint latency, the memory
+/// of the deck in the editor and the number of background jobs. Refreshes only while visible, the
+/// numbers can be copied from the context menu for bug reports.
+//==================================================================================================
+class DataDeckPerformanceHud : public QLabel
+{
+    Q_OBJECT
+
+public:
+    explicit DataDeckPerformanceHud( RimDataDeckTextEditor* textEditor, QWidget* parent = nullptr );
+
+    QString reportText() const;
+
+public slots:
+    void refresh();
+    void copyToClipboard();
+
+protected:
+    void showEvent( QShowEvent* event ) override;
+    void hideEvent( QHideEvent* event ) override;
+    void contextMenuEvent( QContextMenuEvent* event ) override;
+
+private:
+    void updateMemoryUsage();
+
+private:
+    static constexpr int REFRESH_MS = 500;
+
+    // Estimating the memory walks the whole deck, so it is refreshed less often than the timings
+    static constexpr int MEMORY_REFRESH_TICKS = 10;
+
+    RimDataDeckTextEditor*       m_textEditor;
+    QTimer*                      m_refreshTimer;
+    caf::PdmPointer<RimDataDeck> m_memoryDeck;
+    qint64                       m_memoryBytes;
+    int                          m_ticksSinceMemoryUpdate;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+//==================================================================================================
+/// An error or warning found in a DATA file, located by file and line when known
+//==================================================================================================
+struct DataDeckProblem
+{
+    enum class Severity
+    {
+        ERROR,
+        WARNING,
+        INFO
+    };
+
+    Severity severity = Severity::ERROR;
+    QString  message;
+    QString  filePath;
+    int      line = -1; // 1-based, -1 if unknown
+    QString  keyword;
+    int      keywordIndex = -1; // Index in the parsed deck, -1 if not tied to a keyword
+
+    static QString severityToString( Severity severity )
+    {
+        switch ( severity )
+        {
+            case Severity::ERROR:
+                return "Error";
+            case Severity::WARNING:
+                return "Warning";
+            default:
+                return "Info";
+        }
+    }
+};
@@ -0,0 +1,139 @@
+#include "DataDeckProblemsWidget.h"
+
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLabel>
+#include <QStyle>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckProblemsWidget::DataDeckProblemsWidget( QWidget* parent )
+    : QWidget( parent )
+    , m_summaryLabel( nullptr )
+    , m_problemTree( nullptr )
+    , m_isValidating( false )
+{
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 4, 4, 4, 4 );
+    layout->setSpacing( 4 );
+
+    m_summaryLabel = new QLabel( this );
+    layout->addWidget( m_summaryLabel );
+
+    m_problemTree = new QTreeWidget( this );
+    m_problemTree->setRootIsDecorated( false );
+    m_problemTree->setUniformRowHeights( true );
+    m_problemTree->setSortingEnabled( true );
+    m_problemTree->setHeaderLabels( { "Severity", "Message", "File", "Line" } );
+    m_problemTree->header()->setSectionResizeMode( 1, QHeaderView::Stretch );
+    m_problemTree->header()->setStretchLastSection( false );
+    layout->addWidget( m_problemTree, 1 );
+
+    connect( m_problemTree, &QTreeWidget::itemActivated, this, &DataDeckProblemsWidget::onItemActivated );
+
+    updateSummary();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProblemsWidget::setProblems( const QList<DataDeckProblem>& problems )
+{
+    m_problems     = problems;
+    m_isValidating = false;
+
+    m_problemTree->setSortingEnabled( false );
+    m_problemTree->clear();
+
+    for ( int i = 0; i < m_problems.size(); ++i )
+    {
+        const DataDeckProblem& problem = m_problems[i];
+
+        QStyle::StandardPixmap icon = QStyle::SP_MessageBoxInformation;
+        if ( problem.severity == DataDeckProblem::Severity::ERROR )
+            icon = QStyle::SP_MessageBoxCritical;
+        else if ( problem.severity == DataDeckProblem::Severity::WARNING )
+            icon = QStyle::SP_MessageBoxWarning;
+
+        QTreeWidgetItem* item = new QTreeWidgetItem( m_problemTree );
+        item->setIcon( 0, style()->standardIcon( icon ) );
+        item->setText( 0, DataDeckProblem::severityToString( problem.severity ) );
+        item->setText( 1, problem.message );
+        item->setToolTip( 1, problem.message );
+        item->setText( 2, QFileInfo( problem.filePath ).fileName() );
+        item->setToolTip( 2, problem.filePath );
+        if ( problem.line > 0 )
+        {
+            item->setData( 3, Qt::DisplayRole, problem.line );
+        }
+        item->setData( 0, Qt::UserRole, i );
+    }
+
+    m_problemTree->setSortingEnabled( true );
+    m_problemTree->resizeColumnToContents( 0 );
+
+    updateSummary();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProblemsWidget::setValidating( bool validating )
+{
+    m_isValidating = validating;
+    updateSummary();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProblemsWidget::clearProblems()
+{
+    setProblems( {} );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckProblemsWidget::problemCount() const
+{
+    return static_cast<int>( m_problems.size() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProblemsWidget::onItemActivated( QTreeWidgetItem* item, int /* column */ )
+{
+    int index = item->data( 0, Qt::UserRole ).toInt();
+    if ( index >= 0 && index < m_problems.size() )
+    {
+        emit problemActivated( m_problems[index].filePath, m_problems[index].line );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProblemsWidget::updateSummary()
+{
+    int errors   = 0;
+    int warnings = 0;
+    for ( const DataDeckProblem& problem : m_problems )
+    {
+        if ( problem.severity == DataDeckProblem::Severity::ERROR )
+            ++errors;
+        else if ( problem.severity == DataDeckProblem::Severity::WARNING )
+            ++warnings;
+    }
+
+    QString summary = QString( "%1 error(s), %2 warning(s)" ).arg( errors ).arg( warnings );
+    if ( m_isValidating )
+    {
+        summary += " - validating...";
+    }
+    m_summaryLabel->setText( summary );
+}
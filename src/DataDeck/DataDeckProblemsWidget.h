@@ -0,0 +1,40 @@
+#pragma once
+
+#include "DataDeckProblem.h"
+
+#include <QWidget>
+
+class QLabel;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+//==================================================================================================
+/// List of the errors and warnings found in the current DATA file
+//==================================================================================================
+class DataDeckProblemsWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DataDeckProblemsWidget( QWidget* parent = nullptr );
+
+    void setProblems( const QList<DataDeckProblem>& problems );
+    void setValidating( bool validating );
+    void clearProblems();
+    int  problemCount() const;
+
+signals:
+    void problemActivated( const QString& filePath, int line );
+
+private slots:
+    void onItemActivated( QTreeWidgetItem* item, int column );
+
+private:
+    void updateSummary();
+
+private:
+    QLabel*                m_summaryLabel;
+    QTreeWidget*           m_problemTree;
+    QList<DataDeckProblem> m_problems;
+    bool                   m_isValidating;
+};
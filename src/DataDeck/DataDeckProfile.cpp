@@ -0,0 +1,81 @@
+#include "DataDeckProfile.h"
+
+#include <QFile>
+#include <QStringList>
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString csvField( const QString& text )
+{
+    if ( !text.contains( ',' ) && !text.contains( '"' ) && !text.contains( '\n' ) )
+    {
+        return text;
+    }
+
+    QString quoted = text;
+    quoted.replace( '"', "\"\"" );
+    return '"' + quoted + '"';
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Empty when not measured
+//--------------------------------------------------------------------------------------------------
+QString milliseconds( qint64 ns )
+{
+    return ns < 0 ? QString() : QString::number( ns / 1.0e6, 'f', 3 );
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckProfile::typeName( DataDeckProfileEntry::Type type )
+{
+    return type == DataDeckProfileEntry::Type::INCLUDE_FILE ? "Include" : "Keyword";
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckProfile::toCsv( const QList<DataDeckProfileEntry>& entries )
+{
+    QStringList lines;
+    lines << "type,name,file,line,bytes,records,values,parse_ms,parse_estimated,build_ms";
+
+    for ( const DataDeckProfileEntry& entry : entries )
+    {
+        QStringList fields;
+        fields << typeName( entry.type ) << csvField( entry.name ) << csvField( entry.filePath )
+               << ( entry.line > 0 ? QString::number( entry.line ) : QString() ) << ( entry.bytes >= 0 ? QString::number( entry.bytes ) : QString() )
+               << QString::number( entry.recordCount ) << QString::number( entry.valueCount ) << milliseconds( entry.parseTimeNs )
+               << ( entry.isParseTimeEstimated() ? "yes" : "no" ) << milliseconds( entry.buildTimeNs );
+        lines << fields.join( ',' );
+    }
+
+    return lines.join( '\n' ) + '\n';
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckProfile::writeCsv( const QString& filePath, const QList<DataDeckProfileEntry>& entries, QString* errorMessage )
+{
+    QFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+    {
+        *errorMessage = QString( "Could not write %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    if ( file.write( toCsv( entries ).toUtf8() ) < 0 )
+    {
+        *errorMessage = QString( "Could not write %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+//==================================================================================================
+/// Size and load time of one keyword or include file of a deck, collected while the deck is loaded
+//==================================================================================================
+struct DataDeckProfileEntry
+{
+    enum class Type
+    {
+        KEYWORD,
+        INCLUDE_FILE
+    };
+
+    Type    type = Type::KEYWORD;
+    QString name; // Keyword name or include path as written in the deck
+    QString filePath; // File holding the keyword, or the resolved include file
+    int     line        = -1; // First line of the keyword in the editor text of the profiled deck
+    qint64  bytes       = 0; // UTF-8 keyword text in the editor or include file size, -1 for keywords of include files
+    qint64  recordCount = 0;
+    qint64  valueCount  = 0;
+    qint64  parseTimeNs = -1; // -1 if not measured
+    qint64  buildTimeNs = -1; // -1 if the node was reused by an update and not built again
+
+    // opm-common parses a file as a whole, so the parse time of a keyword is the file's parse time
+    // shared by bytes
+    bool isParseTimeEstimated() const { return type == Type::KEYWORD; }
+};
+
+//==================================================================================================
+/// CSV export of the profile entries, times in milliseconds
+//==================================================================================================
+class DataDeckProfile
+{
+public:
+    static QString typeName( DataDeckProfileEntry::Type type );
+
+    static QString toCsv( const QList<DataDeckProfileEntry>& entries );
+    static bool    writeCsv( const QString& filePath, const QList<DataDeckProfileEntry>& entries, QString* errorMessage );
+};
@@ -0,0 +1,204 @@
+#include "DataDeckProfileWidget.h"
+
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+enum Column
+{
+    TYPE_COLUMN,
+    NAME_COLUMN,
+    FILE_COLUMN,
+    LINE_COLUMN,
+    BYTES_COLUMN,
+    RECORDS_COLUMN,
+    VALUES_COLUMN,
+    PARSE_COLUMN,
+    BUILD_COLUMN
+};
+
+//--------------------------------------------------------------------------------------------------
+/// Numbers are stored as display data, so the columns sort numerically
+//--------------------------------------------------------------------------------------------------
+void setMilliseconds( QTreeWidgetItem* item, int column, qint64 ns )
+{
+    if ( ns >= 0 )
+    {
+        item->setData( column, Qt::DisplayRole, std::round( ns / 1000.0 ) / 1000.0 );
+    }
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckProfileWidget::DataDeckProfileWidget( QWidget* parent )
+    : QWidget( parent )
+    , m_summaryLabel( nullptr )
+    , m_exportButton( nullptr )
+    , m_profileTree( nullptr )
+{
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 4, 4, 4, 4 );
+    layout->setSpacing( 4 );
+
+    QHBoxLayout* headerLayout = new QHBoxLayout();
+    m_summaryLabel            = new QLabel( this );
+    headerLayout->addWidget( m_summaryLabel, 1 );
+
+    m_exportButton = new QPushButton( "Export CSV...", this );
+    headerLayout->addWidget( m_exportButton );
+    layout->addLayout( headerLayout );
+
+    m_profileTree = new QTreeWidget( this );
+    m_profileTree->setRootIsDecorated( false );
+    m_profileTree->setUniformRowHeights( true );
+    m_profileTree->setSortingEnabled( true );
+    m_profileTree->setHeaderLabels( { "Type", "Name", "File", "Line", "Bytes", "Records", "Values", "Parse ms", "Build ms" } );
+    m_profileTree->headerItem()->setToolTip( PARSE_COLUMN,
+                                             "Include files are timed when parsed. A keyword is given the parse time of its file "
+                                             "in proportion to its size." );
+    m_profileTree->headerItem()->setToolTip( BUILD_COLUMN, "Time to build the tree nodes, empty for nodes reused after an edit" );
+    m_profileTree->header()->setSectionResizeMode( NAME_COLUMN, QHeaderView::Stretch );
+    m_profileTree->header()->setStretchLastSection( false );
+    layout->addWidget( m_profileTree, 1 );
+
+    connect( m_profileTree, &QTreeWidget::itemActivated, this, &DataDeckProfileWidget::onItemActivated );
+    connect( m_exportButton, &QPushButton::clicked, this, &DataDeckProfileWidget::exportCsv );
+
+    updateSummary();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProfileWidget::setProfile( const QString& deckFilePath, const QList<DataDeckProfileEntry>& entries )
+{
+    m_deckFilePath = deckFilePath;
+    m_entries      = entries;
+
+    m_profileTree->setSortingEnabled( false );
+    m_profileTree->clear();
+
+    for ( int i = 0; i < m_entries.size(); ++i )
+    {
+        const DataDeckProfileEntry& entry = m_entries[i];
+
+        QTreeWidgetItem* item = new QTreeWidgetItem( m_profileTree );
+        item->setText( TYPE_COLUMN, DataDeckProfile::typeName( entry.type ) );
+        item->setText( NAME_COLUMN, entry.name );
+        item->setText( FILE_COLUMN, QFileInfo( entry.filePath ).fileName() );
+        item->setToolTip( FILE_COLUMN, entry.filePath );
+        if ( entry.line > 0 )
+        {
+            item->setData( LINE_COLUMN, Qt::DisplayRole, entry.line );
+        }
+        if ( entry.bytes >= 0 )
+        {
+            item->setData( BYTES_COLUMN, Qt::DisplayRole, entry.bytes );
+        }
+        item->setData( RECORDS_COLUMN, Qt::DisplayRole, entry.recordCount );
+        item->setData( VALUES_COLUMN, Qt::DisplayRole, entry.valueCount );
+        setMilliseconds( item, PARSE_COLUMN, entry.parseTimeNs );
+        setMilliseconds( item, BUILD_COLUMN, entry.buildTimeNs );
+        if ( entry.isParseTimeEstimated() )
+        {
+            item->setToolTip( PARSE_COLUMN, "Estimated from the share of the file" );
+        }
+        item->setData( TYPE_COLUMN, Qt::UserRole, i );
+    }
+
+    m_profileTree->setSortingEnabled( true );
+    m_profileTree->resizeColumnToContents( TYPE_COLUMN );
+
+    updateSummary();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProfileWidget::clearProfile()
+{
+    setProfile( QString(), {} );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProfileWidget::onItemActivated( QTreeWidgetItem* item, int /* column */ )
+{
+    int index = item->data( TYPE_COLUMN, Qt::UserRole ).toInt();
+    if ( index >= 0 && index < m_entries.size() && m_entries[index].type == DataDeckProfileEntry::Type::KEYWORD )
+    {
+        emit entryActivated( m_deckFilePath, m_entries[index].line );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProfileWidget::exportCsv()
+{
+    const QString suggestedPath = m_deckFilePath.isEmpty() ? QString( "profile.csv" )
+                                                           : QFileInfo( m_deckFilePath ).completeBaseName() + "_profile.csv";
+
+    const QString filePath = QFileDialog::getSaveFileName( this, "Export Deck Profile", suggestedPath, "CSV Files (*.csv);;All Files (*)" );
+    if ( filePath.isEmpty() )
+    {
+        return;
+    }
+
+    QString errorMessage;
+    if ( !DataDeckProfile::writeCsv( filePath, m_entries, &errorMessage ) )
+    {
+        QMessageBox::warning( this, "Export Deck Profile", errorMessage );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckProfileWidget::updateSummary()
+{
+    int    keywordCount = 0;
+    int    includeCount = 0;
+    qint64 bytes        = 0;
+    for ( const DataDeckProfileEntry& entry : m_entries )
+    {
+        if ( entry.type == DataDeckProfileEntry::Type::KEYWORD )
+        {
+            ++keywordCount;
+            bytes += std::max<qint64>( entry.bytes, 0 );
+        }
+        else
+        {
+            ++includeCount;
+        }
+    }
+
+    if ( m_deckFilePath.isEmpty() )
+    {
+        m_summaryLabel->setText( "Select a DATA file to see its profile" );
+    }
+    else
+    {
+        m_summaryLabel->setText( QString( "%1: %2 keyword(s), %3 include file(s), %4 bytes of keyword text" )
+                                     .arg( QFileInfo( m_deckFilePath ).fileName() )
+                                     .arg( keywordCount )
+                                     .arg( includeCount )
+                                     .arg( bytes ) );
+    }
+    m_exportButton->setEnabled( !m_entries.isEmpty() );
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "DataDeckProfile.h"
+
+#include <QWidget>
+
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+//==================================================================================================
+/// Sortable list of the keywords and include files of a deck with their size and load times
+//==================================================================================================
+class DataDeckProfileWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DataDeckProfileWidget( QWidget* parent = nullptr );
+
+    void setProfile( const QString& deckFilePath, const QList<DataDeckProfileEntry>& entries );
+    void clearProfile();
+
+signals:
+    void entryActivated( const QString& deckFilePath, int line );
+
+private slots:
+    void onItemActivated( QTreeWidgetItem* item, int column );
+    void exportCsv();
+
+private:
+    void updateSummary();
+
+private:
+    QLabel*                     m_summaryLabel;
+    QPushButton*                m_exportButton;
+    QTreeWidget*                m_profileTree;
+    QString                     m_deckFilePath;
+    QList<DataDeckProfileEntry> m_entries;
+};
@@ -0,0 +1,389 @@
+#include "DataDeckRangeChecker.h"
+#include "DataDeckLogging.h"
+#include "DataArrayKernels.h"
+#include "DataDeckGridChecker.h"
+
+#include "opm/common/OpmLog/KeywordLocation.hpp"
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Values per parallel work item, large enough to keep scheduling overhead small
+constexpr size_t CHUNK_SIZE = size_t( 1 ) << 20;
+
+constexpr size_t FIRST_OFFENDING_COUNT = DataDeckRangeChecker::FIRST_OFFENDING_CELL_COUNT;
+
+struct ScanTarget
+{
+    size_t        arrayIndex = 0;
+    int           ruleIndex  = 0;
+    const double* doubles    = nullptr;
+    const int*    ints       = nullptr;
+    size_t        count      = 0;
+};
+
+struct ScanChunk
+{
+    size_t targetIndex = 0;
+    size_t begin       = 0;
+    size_t end         = 0;
+};
+
+struct ChunkResult
+{
+    DataArrayKernels::RangeCounts counts;
+    std::vector<qint64>           offsets; // Offsets in the whole array
+};
+
+//--------------------------------------------------------------------------------------------------
+/// Integer bounds of a double range, clamped to the int range
+//--------------------------------------------------------------------------------------------------
+int intBound( double value, bool isMin )
+{
+    const double bounded = isMin ? std::ceil( value ) : std::floor( value );
+    return static_cast<int>( std::clamp( bounded, double( std::numeric_limits<int>::min() ), double( std::numeric_limits<int>::max() ) ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+ChunkResult scanChunk( const ScanTarget& target, const DataDeckRangeChecker::Rule& rule, const ScanChunk& chunk )
+{
+    ChunkResult result;
+    qint64      offsets[FIRST_OFFENDING_COUNT];
+    size_t      found = 0;
+
+    const size_t count = chunk.end - chunk.begin;
+
+    if ( target.doubles )
+    {
+        const double* values = target.doubles + chunk.begin;
+        result.counts        = DataArrayKernels::countOutOfRange( values, count, rule.minValue, rule.maxValue );
+        if ( rule.allowNonFinite ) result.counts.nonFinite = 0;
+
+        // The slow scan for locations only runs on chunks with hits
+        if ( result.counts.total() > 0 )
+        {
+            found = DataArrayKernels::findOutOfRange( values, count, rule.minValue, rule.maxValue, offsets, FIRST_OFFENDING_COUNT );
+        }
+    }
+    else
+    {
+        const int* values   = target.ints + chunk.begin;
+        const int  minValue = intBound( rule.minValue, true );
+        const int  maxValue = intBound( rule.maxValue, false );
+        result.counts       = DataArrayKernels::countOutOfRange( values, count, minValue, maxValue );
+        if ( result.counts.total() > 0 )
+        {
+            found = DataArrayKernels::findOutOfRange( values, count, minValue, maxValue, offsets, FIRST_OFFENDING_COUNT );
+        }
+    }
+
+    for ( size_t i = 0; i < found; ++i )
+    {
+        // Non-finite values are not offending when the rule allows them
+        if ( target.doubles && rule.allowNonFinite && !std::isfinite( target.doubles[chunk.begin + offsets[i]] ) ) continue;
+
+        result.offsets.push_back( static_cast<qint64>( chunk.begin ) + offsets[i] );
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckProblem::Severity severityFromString( const QString& text, DataDeckProblem::Severity fallback )
+{
+    const QString lower = text.toLower();
+    if ( lower == "error" ) return DataDeckProblem::Severity::ERROR;
+    if ( lower == "warning" ) return DataDeckProblem::Severity::WARNING;
+    if ( lower == "info" ) return DataDeckProblem::Severity::INFO;
+    return fallback;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckRangeChecker::Rule::rangeText() const
+{
+    const bool hasMin = std::isfinite( minValue );
+    const bool hasMax = std::isfinite( maxValue );
+
+    if ( hasMin && hasMax ) return QString( "[%1, %2]" ).arg( minValue ).arg( maxValue );
+    if ( hasMin ) return QString( ">= %1" ).arg( minValue );
+    if ( hasMax ) return QString( "<= %1" ).arg( maxValue );
+    return "finite";
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckRangeChecker::check( const Opm::Deck& deck, const QList<Rule>& rules )
+{
+    QHash<QString, int> ruleForKeyword;
+    for ( int i = 0; i < rules.size(); ++i )
+    {
+        for ( const QString& keyword : rules[i].keywords )
+        {
+            ruleForKeyword.insert( keyword, i );
+        }
+    }
+
+    if ( ruleForKeyword.isEmpty() )
+    {
+        return {};
+    }
+
+    const std::vector<DataDeckGridChecker::GridArray> arrays = DataDeckGridChecker::collectGridArrays( deck );
+
+    std::vector<ScanTarget> targets;
+    std::vector<ScanChunk>  chunks;
+
+    for ( size_t i = 0; i < arrays.size(); ++i )
+    {
+        const Opm::DeckKeyword& keyword = deck[arrays[i].keywordIndex];
+
+        auto rule = ruleForKeyword.constFind( QString::fromStdString( keyword.name() ) );
+        if ( rule == ruleForKeyword.constEnd() ) continue;
+
+        const Opm::DeckItem& item = keyword.getDataRecord().getDataItem();
+
+        ScanTarget target;
+        target.arrayIndex = i;
+        target.ruleIndex  = rule.value();
+        if ( item.getType() == Opm::type_tag::fdouble )
+        {
+            const std::vector<double>& values = item.getData<double>();
+            target.doubles                    = values.data();
+            target.count                      = values.size();
+        }
+        else
+        {
+            const std::vector<int>& values = item.getData<int>();
+            target.ints                    = values.data();
+            target.count                   = values.size();
+        }
+
+        for ( size_t begin = 0; begin < target.count; begin += CHUNK_SIZE )
+        {
+            chunks.push_back( { targets.size(), begin, std::min( begin + CHUNK_SIZE, target.count ) } );
+        }
+        targets.push_back( target );
+    }
+
+    auto scanOne = [&targets, &rules]( const ScanChunk& chunk ) -> ChunkResult
+    {
+        const ScanTarget& target = targets[chunk.targetIndex];
+        return scanChunk( target, rules[target.ruleIndex], chunk );
+    };
+
+    const std::vector<ChunkResult> results = QtConcurrent::blockingMapped<std::vector<ChunkResult>>( chunks, scanOne );
+
+    // Merge the chunks per array, they are in array order
+    std::vector<ChunkResult> merged( targets.size() );
+    for ( size_t i = 0; i < chunks.size(); ++i )
+    {
+        ChunkResult& total = merged[chunks[i].targetIndex];
+        total.counts += results[i].counts;
+        for ( qint64 offset : results[i].offsets )
+        {
+            if ( total.offsets.size() >= FIRST_OFFENDING_CELL_COUNT ) break;
+            total.offsets.push_back( offset );
+        }
+    }
+
+    QList<DataDeckProblem> problems;
+    for ( size_t i = 0; i < targets.size(); ++i )
+    {
+        const DataArrayKernels::RangeCounts& counts = merged[i].counts;
+        if ( counts.total() == 0 ) continue;
+
+        const DataDeckGridChecker::GridArray& array   = arrays[targets[i].arrayIndex];
+        const Opm::DeckKeyword&               keyword = deck[array.keywordIndex];
+        const Rule&                           rule    = rules[targets[i].ruleIndex];
+        const QString                         name    = QString::fromStdString( keyword.name() );
+
+        // Corner point arrays are not one value per cell, locate by value number instead
+        const bool  isCellArray = name != "COORD" && name != "ZCORN";
+        QStringList locations;
+        for ( qint64 offset : merged[i].offsets )
+        {
+            if ( isCellArray && offset < array.nx * qint64( array.ny ) * array.nz )
+            {
+                locations.append( array.cellText( offset ) );
+            }
+            else
+            {
+                locations.append( QString( "value %1" ).arg( offset + 1 ) );
+            }
+        }
+
+        QStringList parts;
+        if ( counts.below > 0 ) parts.append( QString( "%1 below" ).arg( counts.below ) );
+        if ( counts.above > 0 ) parts.append( QString( "%1 above" ).arg( counts.above ) );
+        if ( counts.nonFinite > 0 ) parts.append( QString( "%1 NaN or Inf" ).arg( counts.nonFinite ) );
+
+        QString message = QString( "%1 has %2 value(s) outside %3 (%4)" ).arg( name ).arg( counts.total() ).arg( rule.rangeText() ).arg( parts.join( ", " ) );
+        if ( !locations.isEmpty() )
+        {
+            message += QString( ", first at %1" ).arg( locations.join( " " ) );
+        }
+
+        const auto& location = keyword.location();
+
+        DataDeckProblem problem;
+        problem.severity     = rule.severity;
+        problem.message      = message;
+        problem.filePath     = QString::fromStdString( location.filename );
+        problem.line         = static_cast<int>( location.lineno );
+        problem.keyword      = name;
+        problem.keywordIndex = static_cast<int>( array.keywordIndex );
+        problems.append( problem );
+    }
+
+    return problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+const QList<DataDeckRangeChecker::Rule>& DataDeckRangeChecker::activeRules()
+{
+    static const QList<Rule> rules = []()
+    {
+        QList<Rule> combined = defaultRules();
+
+        const QString filePath = userRulesFilePath();
+        if ( !QFile::exists( filePath ) )
+        {
+            return combined;
+        }
+
+        QString           errorMessage;
+        const QList<Rule> userRules = loadRules( filePath, &errorMessage );
+        if ( !errorMessage.isEmpty() )
+        {
+            qCWarning( logValidation ) << "Range rules not loaded:" << errorMessage;
+            return combined;
+        }
+
+        // A user rule replaces the built-in rule for its keywords
+        for ( const Rule& userRule : userRules )
+        {
+            for ( Rule& rule : combined )
+            {
+                for ( const QString& keyword : userRule.keywords )
+                {
+                    rule.keywords.removeAll( keyword );
+                }
+            }
+        }
+        combined.append( userRules );
+        return combined;
+    }();
+
+    return rules;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckRangeChecker::Rule> DataDeckRangeChecker::defaultRules()
+{
+    auto makeRule = []( const QStringList& keywords, double minValue, double maxValue, DataDeckProblem::Severity severity )
+    {
+        Rule rule;
+        rule.keywords = keywords;
+        rule.minValue = minValue;
+        rule.maxValue = maxValue;
+        rule.severity = severity;
+        return rule;
+    };
+
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    QList<Rule> rules;
+    rules << makeRule( { "PORO", "NTG" }, 0.0, 1.0, DataDeckProblem::Severity::ERROR );
+    rules << makeRule( { "PERMX", "PERMY", "PERMZ" }, 0.0, infinity, DataDeckProblem::Severity::ERROR );
+    rules << makeRule( { "DX", "DY", "DZ" }, 0.0, infinity, DataDeckProblem::Severity::ERROR );
+    rules << makeRule( { "MULTX", "MULTY", "MULTZ", "MULTX-", "MULTY-", "MULTZ-", "MULTPV" }, 0.0, infinity, DataDeckProblem::Severity::ERROR );
+    rules << makeRule( { "SWL", "SWCR", "SWU", "SGL", "SGCR", "SGU", "SOWCR", "SOGCR", "SWATINIT" }, 0.0, 1.0, DataDeckProblem::Severity::ERROR );
+    rules << makeRule( { "SATNUM", "PVTNUM", "EQLNUM", "FIPNUM", "IMBNUM", "ROCKNUM" }, 1.0, infinity, DataDeckProblem::Severity::ERROR );
+    rules << makeRule( { "COORD", "ZCORN", "TOPS" }, -infinity, infinity, DataDeckProblem::Severity::ERROR );
+    return rules;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckRangeChecker::Rule> DataDeckRangeChecker::loadRules( const QString& filePath, QString* errorMessage )
+{
+    QList<Rule> rules;
+
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        if ( errorMessage ) *errorMessage = QString( "Cannot open %1" ).arg( filePath );
+        return rules;
+    }
+
+    QJsonParseError     parseError;
+    const QJsonDocument document = QJsonDocument::fromJson( file.readAll(), &parseError );
+    if ( parseError.error != QJsonParseError::NoError )
+    {
+        if ( errorMessage ) *errorMessage = QString( "%1: %2" ).arg( filePath ).arg( parseError.errorString() );
+        return rules;
+    }
+
+    const QJsonArray ruleArray = document.object()["rules"].toArray();
+    for ( const QJsonValue& value : ruleArray )
+    {
+        const QJsonObject json = value.toObject();
+
+        Rule rule;
+        if ( json.contains( "keyword" ) )
+        {
+            rule.keywords.append( json["keyword"].toString().toUpper() );
+        }
+        for ( const QJsonValue& keyword : json["keywords"].toArray() )
+        {
+            rule.keywords.append( keyword.toString().toUpper() );
+        }
+        if ( json.contains( "min" ) ) rule.minValue = json["min"].toDouble();
+        if ( json.contains( "max" ) ) rule.maxValue = json["max"].toDouble();
+        rule.allowNonFinite = json["allowNonFinite"].toBool( false );
+        rule.severity       = severityFromString( json["severity"].toString(), rule.severity );
+
+        if ( !rule.keywords.isEmpty() )
+        {
+            rules.append( rule );
+        }
+    }
+
+    return rules;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckRangeChecker::userRulesFilePath()
+{
+    return QStandardPaths::writableLocation( QStandardPaths::AppConfigLocation ) + "/range_rules.json";
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "DataDeckProblem.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <limits>
+
+namespace Opm
+{
+class Deck;
+}
+
+//==================================================================================================
+/// Checks the values of grid arrays against range rules per keyword, like PORO within [0, 1] or no
+/// NaN or Inf in ZCORN.
+///
+/// The built-in rules can be extended or overridden by a JSON file:
+///
+///   { "rules": [ { "keywords": ["PERMX", "PERMY", "PERMZ"], "min": 0, "severity": "error" },
+///                { "keyword": "NTG", "min": 0, "max": 1 } ] }
+///
+/// Arrays are split into chunks that are scanned in parallel with the DataArrayKernels. The problem
+/// for a keyword has the counts and the (I,J,K) of the first offending cells.
+//==================================================================================================
+class DataDeckRangeChecker
+{
+public:
+    struct Rule
+    {
+        QStringList               keywords;
+        double                    minValue       = -std::numeric_limits<double>::infinity();
+        double                    maxValue       = std::numeric_limits<double>::infinity();
+        bool                      allowNonFinite = false;
+        DataDeckProblem::Severity severity       = DataDeckProblem::Severity::WARNING;
+
+        QString rangeText() const;
+    };
+
+    static constexpr int FIRST_OFFENDING_CELL_COUNT = 5;
+
+    static QList<DataDeckProblem> check( const Opm::Deck& deck, const QList<Rule>& rules );
+
+    // The built-in rules combined with the user rules file, loaded once
+    static const QList<Rule>& activeRules();
+
+    static QList<Rule> defaultRules();
+    static QList<Rule> loadRules( const QString& filePath, QString* errorMessage = nullptr );
+    static QString     userRulesFilePath();
+};
@@ -0,0 +1,252 @@
+#include "DataDeckRestoreQueue.h"
+#include "DataDeckMetrics.h"
+#include "DataDeckTrace.h"
+#include "RimDataDeck.h"
+#include "RimIncludeFile.h"
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace
+{
+const char* CANCELED_PROPERTY = "restoreCanceled";
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckRestoreQueue::DataDeckRestoreQueue( QObject* parent )
+    : QObject( parent )
+    , m_memoryBudget( DEFAULT_MEMORY_BUDGET )
+    , m_estimateWatcher( nullptr )
+    , m_runningBytes( 0 )
+    , m_activeJobCount( 0 )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Parses still running complete on their own, their results are dropped together with the watchers
+//--------------------------------------------------------------------------------------------------
+DataDeckRestoreQueue::~DataDeckRestoreQueue()
+{
+    cancel();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckRestoreQueue::enqueue( const QStringList& filePaths )
+{
+    m_queuedFilePaths.append( filePaths );
+    DataDeckMetrics::addQueuedJobs( filePaths.size() );
+
+    startJobs();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckRestoreQueue::prioritize( const QString& filePath )
+{
+    const int index = m_queuedFilePaths.indexOf( filePath );
+    if ( index < 0 )
+    {
+        return false;
+    }
+
+    m_queuedFilePaths.move( index, 0 );
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Drop the queued decks and detach from the running parses
+//--------------------------------------------------------------------------------------------------
+void DataDeckRestoreQueue::cancel()
+{
+    DataDeckMetrics::addQueuedJobs( -m_queuedFilePaths.size() );
+    m_queuedFilePaths.clear();
+    m_estimatedBytes.clear();
+    m_estimateWatcher = nullptr; // A running estimate completes on its own and is dropped
+
+    for ( auto it = m_runningJobs.begin(); it != m_runningJobs.end(); ++it )
+    {
+        it.key()->setProperty( CANCELED_PROPERTY, true );
+    }
+    m_activeJobCount = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckRestoreQueue::isRunning() const
+{
+    return pendingCount() > 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckRestoreQueue::pendingCount() const
+{
+    return m_queuedFilePaths.size() + m_activeJobCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckRestoreQueue::setMemoryBudget( qint64 bytes )
+{
+    m_memoryBudget = bytes;
+    startJobs();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckRestoreQueue::memoryBudget() const
+{
+    return m_memoryBudget;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The include files are found as the loader finds them
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckRestoreQueue::estimateParseBytes( const QString& filePath )
+{
+    DATADECK_TRACE_SCOPE_DETAIL( "restore", "DataDeckRestoreQueue::estimateParseBytes", filePath );
+
+    qint64        fileBytes = QFileInfo( filePath ).size();
+    QStringList   pendingFiles{ filePath };
+    QSet<QString> visitedFiles{ QFileInfo( filePath ).absoluteFilePath() };
+
+    while ( !pendingFiles.isEmpty() )
+    {
+        const QString currentFile = pendingFiles.takeFirst();
+        const QString basePath    = QFileInfo( currentFile ).absolutePath();
+
+        for ( const QString& includePath : RimDataDeck::scanIncludePaths( currentFile ) )
+        {
+            const QString resolvedPath = RimIncludeFile::resolveAbsolutePath( includePath, basePath );
+            if ( visitedFiles.contains( resolvedPath ) ) continue;
+            visitedFiles.insert( resolvedPath );
+
+            const QFileInfo info( resolvedPath );
+            if ( !info.isFile() ) continue;
+
+            fileBytes += info.size();
+            pendingFiles.append( resolvedPath );
+        }
+    }
+
+    return fileBytes * PARSED_BYTES_PER_FILE_BYTE;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// One estimate runs at a time. When it completes the queue is started again, which estimates the
+/// deck then at the front if it is another one.
+//--------------------------------------------------------------------------------------------------
+void DataDeckRestoreQueue::startEstimate( const QString& filePath )
+{
+    if ( m_estimateWatcher )
+    {
+        return;
+    }
+
+    auto* watcher = new QFutureWatcher<qint64>( this );
+    connect( watcher, &QFutureWatcher<qint64>::finished, this, [this, watcher, filePath]() {
+        watcher->deleteLater();
+
+        // The queue was canceled while estimating
+        if ( watcher != m_estimateWatcher )
+        {
+            return;
+        }
+
+        m_estimateWatcher = nullptr;
+        m_estimatedBytes.insert( filePath, watcher->result() );
+        startJobs();
+    } );
+
+    m_estimateWatcher = watcher;
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( &DataDeckRestoreQueue::estimateParseBytes, filePath ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Start queued decks in order until the budget or the thread count is reached
+//--------------------------------------------------------------------------------------------------
+void DataDeckRestoreQueue::startJobs()
+{
+    while ( !m_queuedFilePaths.isEmpty() && m_runningJobs.size() < QThreadPool::globalInstance()->maxThreadCount() )
+    {
+        const QString filePath = m_queuedFilePaths.first();
+
+        auto estimate = m_estimatedBytes.constFind( filePath );
+        if ( estimate == m_estimatedBytes.constEnd() )
+        {
+            startEstimate( filePath );
+            break;
+        }
+
+        const qint64 estimatedBytes = estimate.value();
+        if ( !m_runningJobs.isEmpty() && m_runningBytes + estimatedBytes > m_memoryBudget )
+        {
+            break;
+        }
+
+        DATADECK_TRACE_SCOPE_DETAIL( "restore", "DataDeckRestoreQueue::startJob", filePath );
+
+        m_queuedFilePaths.removeFirst();
+        m_estimatedBytes.remove( filePath );
+        DataDeckMetrics::addQueuedJobs( -1 );
+
+        auto* watcher = new QFutureWatcher<DataDeckLoadResult>( this );
+        connect( watcher, &QFutureWatcher<DataDeckLoadResult>::finished, this, [this, watcher]() { onJobFinished( watcher ); } );
+
+        m_runningJobs.insert( watcher, estimatedBytes );
+        m_runningBytes += estimatedBytes;
+        ++m_activeJobCount;
+
+        DataDeckMetrics::trackBackgroundJob( watcher );
+        watcher->setFuture( QtConcurrent::run( &DataDeckLoader::parseDeckWithIncludes, filePath ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckRestoreQueue::onJobFinished( QFutureWatcher<DataDeckLoadResult>* watcher )
+{
+    watcher->deleteLater();
+
+    const qint64 estimatedBytes = m_runningJobs.take( watcher );
+
+    if ( watcher->property( CANCELED_PROPERTY ).toBool() )
+    {
+        // Canceled, the freed budget may let queued decks of a later restore start
+        m_runningBytes -= estimatedBytes;
+        startJobs();
+        return;
+    }
+
+    --m_activeJobCount;
+
+    // Keep the workers busy while the receiver builds the tree of this deck. The parsed deck and the
+    // tree are both in memory during the build, so the deck stays in the estimate until it is done.
+    startJobs();
+
+    const DataDeckLoadResult result = watcher->result();
+    DataDeckMetrics::recordParse( result.totalParseTimeNs() );
+    emit deckLoaded( result );
+
+    m_runningBytes -= estimatedBytes;
+    startJobs();
+
+    if ( pendingCount() == 0 )
+    {
+        emit finished();
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DataDeckLoader.h"
+
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+
+template <typename T>
+class QFutureWatcher;
+
+//==================================================================================================
+/// Parses the decks of a restored project in the global thread pool. Each finished deck is
+/// reported on its own so it can be added to the tree while the others are still parsing.
+///
+/// Jobs start in queue order while the estimated memory of the parses in flight stays within the
+/// budget. The estimate reads the deck to find its include files, so it is made on a worker thread
+/// for the deck at the front of the queue, while the decks before it parse. A finished deck stays in
+/// the estimate until the receiver of deckLoaded() has built its tree. One job always runs, so a deck larger than the budget is still loaded. A deck can be moved
+/// to the front of the queue, typically the one the user selects.
+//==================================================================================================
+class DataDeckRestoreQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DataDeckRestoreQueue( QObject* parent = nullptr );
+    ~DataDeckRestoreQueue() override;
+
+    void enqueue( const QStringList& filePaths );
+    bool prioritize( const QString& filePath ); // False if the deck is not waiting in the queue
+    void cancel();
+
+    bool isRunning() const;
+    int  pendingCount() const; // Waiting or parsing
+
+    void   setMemoryBudget( qint64 bytes );
+    qint64 memoryBudget() const;
+
+    // Reads the deck and the include files it reaches, call from a worker thread
+    static qint64 estimateParseBytes( const QString& filePath );
+
+    // Parsed decks take a few times the size of their text, mostly for the item values and their
+    // value status. The text is the DATA file and the include files it reaches.
+    static constexpr qint64 PARSED_BYTES_PER_FILE_BYTE = 6;
+    static constexpr qint64 DEFAULT_MEMORY_BUDGET      = 2LL * 1024 * 1024 * 1024;
+
+signals:
+    void deckLoaded( const DataDeckLoadResult& result ); // Connect directly, the tree is built in the slot
+    void finished();
+
+private:
+    void startJobs();
+    void startEstimate( const QString& filePath );
+    void onJobFinished( QFutureWatcher<DataDeckLoadResult>* watcher );
+
+private:
+    QStringList           m_queuedFilePaths;
+    qint64                m_memoryBudget;
+    QMap<QString, qint64> m_estimatedBytes; // Keyed by file path
+
+    QFutureWatcher<qint64>* m_estimateWatcher; // Estimate of the deck at the front of the queue
+
+    // Running jobs with their estimated bytes. Canceled jobs keep their bytes until they complete,
+    // the parse cannot be interrupted.
+    QMap<QFutureWatcher<DataDeckLoadResult>*, qint64> m_runningJobs;
+    qint64                                            m_runningBytes;
+    int                                               m_activeJobCount; // Running jobs whose result is wanted
+};
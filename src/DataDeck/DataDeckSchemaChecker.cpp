@@ -0,0 +1,201 @@
+#include "DataDeckSchemaChecker.h"
+#include "DeckKeywordHash.h"
+#include "KeywordDatabase.h"
+
+#include "opm/common/OpmLog/KeywordLocation.hpp"
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+
+#include <QMutexLocker>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+struct KeywordCheckResult
+{
+    size_t                 hash = 0;
+    bool                   hasSchema = true; // Keywords without an item schema are not hashed or cached
+    bool                   fromCache = false;
+    QList<DataDeckProblem> problems;
+};
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckSchemaChecker::DataDeckSchemaChecker()
+    : m_lastCheckedKeywordCount( 0 )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckSchemaChecker::check( const Opm::Deck& deck )
+{
+    KeywordDatabase* database = KeywordDatabase::instance();
+
+    QHash<size_t, QList<DataDeckProblem>> previousCache;
+    {
+        QMutexLocker lock( &m_mutex );
+        previousCache = m_cache;
+    }
+
+    std::vector<size_t> keywordIndices( deck.size() );
+    std::iota( keywordIndices.begin(), keywordIndices.end(), size_t( 0 ) );
+
+    // Hash and check keywords in parallel, the cache copy is only read
+    auto checkOne = [&deck, &previousCache, database]( size_t index ) -> KeywordCheckResult
+    {
+        const Opm::DeckKeyword& keyword = deck[index];
+        const KeywordInfo       info    = database->getKeywordInfo( QString::fromStdString( keyword.name() ) );
+
+        // Nothing to check, and hashing the values of a large data array costs more than the check
+        KeywordCheckResult result;
+        if ( info.name.isEmpty() || info.parameterNames.isEmpty() )
+        {
+            result.hasSchema = false;
+            return result;
+        }
+
+        result.hash = DeckKeywordHash::keywordHash( keyword );
+
+        auto cached = previousCache.constFind( result.hash );
+        if ( cached != previousCache.constEnd() )
+        {
+            result.problems  = cached.value();
+            result.fromCache = true;
+        }
+        else
+        {
+            result.problems = checkKeyword( keyword, info );
+        }
+        return result;
+    };
+
+    std::vector<KeywordCheckResult> results = QtConcurrent::blockingMapped<std::vector<KeywordCheckResult>>( keywordIndices, checkOne );
+
+    QHash<size_t, QList<DataDeckProblem>> newCache;
+    QList<DataDeckProblem>                problems;
+    QString                               currentSection;
+    int                                   checkedCount = 0;
+
+    for ( size_t i = 0; i < results.size(); ++i )
+    {
+        const Opm::DeckKeyword&   keyword  = deck[i];
+        const KeywordCheckResult& result   = results[i];
+        const QString             name     = QString::fromStdString( keyword.name() );
+        const auto&               location = keyword.location();
+
+        if ( result.hasSchema )
+        {
+            newCache.insert( result.hash, result.problems );
+            if ( !result.fromCache ) ++checkedCount;
+        }
+
+        // Section placement depends on the keywords before, so it is not cached
+        QList<DataDeckProblem> keywordProblems = result.problems;
+        if ( database->isSection( name ) )
+        {
+            currentSection = name;
+        }
+        else if ( !currentSection.isEmpty() && database->hasKeyword( name ) &&
+                  !database->getKeywordInfo( name ).isValidInSection( currentSection ) )
+        {
+            DataDeckProblem problem;
+            problem.severity = DataDeckProblem::Severity::WARNING;
+            problem.message  = QString( "%1 is not valid in the %2 section" ).arg( name ).arg( currentSection );
+            keywordProblems.append( problem );
+        }
+
+        for ( DataDeckProblem& problem : keywordProblems )
+        {
+            problem.filePath     = QString::fromStdString( location.filename );
+            problem.line         = static_cast<int>( location.lineno );
+            problem.keyword      = name;
+            problem.keywordIndex = static_cast<int>( i );
+            problems.append( problem );
+        }
+    }
+
+    {
+        QMutexLocker lock( &m_mutex );
+        m_cache                   = newCache;
+        m_lastCheckedKeywordCount = checkedCount;
+    }
+
+    return problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataDeckSchemaChecker::cachedKeywordCount() const
+{
+    QMutexLocker lock( &m_mutex );
+    return static_cast<int>( m_cache.size() );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Number of keywords with an item schema that were not found in the cache during the last check
+//--------------------------------------------------------------------------------------------------
+int DataDeckSchemaChecker::lastCheckedKeywordCount() const
+{
+    QMutexLocker lock( &m_mutex );
+    return m_lastCheckedKeywordCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckSchemaChecker::clearCache()
+{
+    QMutexLocker lock( &m_mutex );
+    m_cache.clear();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Check one keyword against its schema. The problems have no location, it is added by the caller.
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckSchemaChecker::checkKeyword( const Opm::DeckKeyword& keyword, const KeywordInfo& info )
+{
+    QList<DataDeckProblem> problems;
+
+    // Unknown keywords are reported by the parser, data arrays have no item schema
+    if ( info.name.isEmpty() || info.parameterNames.isEmpty() )
+    {
+        return problems;
+    }
+
+    const int schemaItemCount = static_cast<int>( info.parameterNames.size() );
+
+    for ( size_t recordIndex = 0; recordIndex < keyword.size(); ++recordIndex )
+    {
+        const Opm::DeckRecord& record = keyword.getRecord( recordIndex );
+        const QString          prefix = keyword.size() > 1 ? QString( "Record %1: " ).arg( recordIndex + 1 ) : QString();
+
+        const int itemCount = std::min( static_cast<int>( record.size() ), schemaItemCount );
+        for ( int itemIndex = 0; itemIndex < itemCount; ++itemIndex )
+        {
+            const Opm::DeckItem& item     = record.getItem( itemIndex );
+            const QString        itemName = info.parameterNames[itemIndex];
+
+            // The parser accepts a defaulted item without a default, it fails only when the value is used
+            if ( item.data_size() > 0 && item.defaultApplied( 0 ) && !item.hasValue( 0 ) &&
+                 info.parameterDefaults.value( itemIndex ).isEmpty() )
+            {
+                DataDeckProblem problem;
+                problem.severity = DataDeckProblem::Severity::WARNING;
+                problem.message  = prefix + QString( "Item %1 (%2) is defaulted but has no default value" ).arg( itemIndex + 1 ).arg( itemName );
+                problems.append( problem );
+            }
+        }
+    }
+
+    return problems;
+}
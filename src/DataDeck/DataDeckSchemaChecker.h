@@ -0,0 +1,42 @@
+#pragma once
+
+#include "DataDeckProblem.h"
+
+#include <QHash>
+#include <QMutex>
+
+namespace Opm
+{
+class Deck;
+class DeckKeyword;
+} // namespace Opm
+
+struct KeywordInfo;
+
+//==================================================================================================
+/// Checks the records of a parsed deck against the keyword schema in KeywordDatabase, for what the
+/// parser accepts: defaulted items without a default value, and the sections a keyword is allowed in.
+/// Item counts and item types are not checked, the parser reads the records by the same schema.
+///
+/// Keywords are checked in parallel. Results are cached by keyword content hash, so after an edit
+/// only keywords whose content changed are checked again. The cache only keeps the entries used by
+/// the latest check. Keywords without an item schema, such as grid data arrays, are skipped.
+//==================================================================================================
+class DataDeckSchemaChecker
+{
+public:
+    DataDeckSchemaChecker();
+
+    QList<DataDeckProblem> check( const Opm::Deck& deck );
+
+    int  cachedKeywordCount() const;
+    int  lastCheckedKeywordCount() const;
+    void clearCache();
+
+    static QList<DataDeckProblem> checkKeyword( const Opm::DeckKeyword& keyword, const KeywordInfo& info );
+
+private:
+    mutable QMutex                        m_mutex;
+    QHash<size_t, QList<DataDeckProblem>> m_cache; // Location free problems, keyed by keyword hash
+    int                                   m_lastCheckedKeywordCount;
+};
@@ -0,0 +1,257 @@
+#include "DataDeckSizeChecker.h"
+#include "KeywordDatabase.h"
+
+#include "opm/common/OpmLog/KeywordLocation.hpp"
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+namespace
+{
+struct TableRowLimit
+{
+    const char* keyword;
+    int         columnCount;
+    const char* dimsItem; // TABDIMS item with the maximum rows per table
+};
+
+const TableRowLimit TABLE_ROW_LIMITS[] = { { "SWOF", 4, "NSSFUN" },  { "SGOF", 4, "NSSFUN" }, { "SLGOF", 4, "NSSFUN" },
+                                           { "SWFN", 3, "NSSFUN" },  { "SGFN", 3, "NSSFUN" }, { "SOF2", 2, "NSSFUN" },
+                                           { "SOF3", 3, "NSSFUN" },  { "SGWFN", 4, "NSSFUN" }, { "PVDG", 3, "NPPVT" },
+                                           { "PVDO", 3, "NPPVT" } };
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckSizeChecker::check( const Opm::Deck& deck )
+{
+    DataDeckSizeChecker checker;
+    for ( size_t i = 0; i < deck.size(); ++i )
+    {
+        checker.visit( deck[i], static_cast<int>( i ) );
+    }
+    return checker.m_problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckSizeChecker::visit( const Opm::DeckKeyword& keyword, int keywordIndex )
+{
+    m_keywordIndex = keywordIndex;
+
+    const QString name = QString::fromStdString( keyword.name() );
+
+    // A repeated dimension keyword replaces the earlier values
+    if ( m_latestKeywords.contains( name ) )
+    {
+        for ( auto it = m_resolvedSizes.begin(); it != m_resolvedSizes.end(); )
+        {
+            it = it.key().startsWith( name + ":" ) ? m_resolvedSizes.erase( it ) : std::next( it );
+        }
+    }
+    m_latestKeywords[name] = &keyword;
+
+    checkTableRows( keyword );
+
+    if ( name == "WELSPECS" || name == "COMPDAT" )
+    {
+        checkWellLimits( keyword );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Value of an item in a dimension keyword, or its schema default if the keyword is not in the deck.
+/// Returns -1 if the value cannot be determined.
+//--------------------------------------------------------------------------------------------------
+int DataDeckSizeChecker::resolveSize( const QString& dimsKeyword, const QString& item ) const
+{
+    const QString key = dimsKeyword + ":" + item;
+
+    auto resolved = m_resolvedSizes.constFind( key );
+    if ( resolved != m_resolvedSizes.constEnd() )
+    {
+        return resolved.value();
+    }
+
+    int value = -1;
+
+    auto deckKeyword = m_latestKeywords.constFind( dimsKeyword );
+    if ( deckKeyword != m_latestKeywords.constEnd() && deckKeyword.value()->size() > 0 )
+    {
+        const Opm::DeckRecord& record = deckKeyword.value()->getRecord( 0 );
+        if ( record.hasItem( item.toStdString() ) )
+        {
+            const Opm::DeckItem& deckItem = record.getItem( item.toStdString() );
+            if ( deckItem.getType() == Opm::type_tag::integer && deckItem.hasValue( 0 ) )
+            {
+                value = deckItem.get<int>( 0 );
+            }
+        }
+    }
+    else
+    {
+        KeywordInfo info         = KeywordDatabase::instance()->getKeywordInfo( dimsKeyword );
+        int         index        = static_cast<int>( info.parameterNames.indexOf( item ) );
+        bool        ok           = false;
+        int         defaultValue = info.parameterDefaults.value( index ).toInt( &ok );
+        if ( index >= 0 && ok )
+        {
+            value = defaultValue;
+        }
+    }
+
+    m_resolvedSizes.insert( key, value );
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Each record of a table keyword is one table, its values are the rows one after the other
+//--------------------------------------------------------------------------------------------------
+void DataDeckSizeChecker::checkTableRows( const Opm::DeckKeyword& keyword )
+{
+    auto limit = std::find_if( std::begin( TABLE_ROW_LIMITS ),
+                               std::end( TABLE_ROW_LIMITS ),
+                               [&keyword]( const TableRowLimit& tableLimit ) { return keyword.name() == tableLimit.keyword; } );
+    if ( limit == std::end( TABLE_ROW_LIMITS ) )
+    {
+        return;
+    }
+
+    const int maxRows = resolveSize( "TABDIMS", limit->dimsItem );
+    if ( maxRows < 0 )
+    {
+        return;
+    }
+
+    const QString source = m_latestKeywords.contains( "TABDIMS" ) ? "TABDIMS" : "TABDIMS default";
+    for ( size_t tableIndex = 0; tableIndex < keyword.size(); ++tableIndex )
+    {
+        const Opm::DeckRecord& record = keyword.getRecord( tableIndex );
+        if ( record.size() == 0 )
+        {
+            continue;
+        }
+
+        const int rowCount = static_cast<int>( record.getItem( 0 ).data_size() ) / limit->columnCount;
+        if ( rowCount > maxRows )
+        {
+            addProblem( keyword,
+                        DataDeckProblem::Severity::ERROR,
+                        QString( "%1 table %2 has %3 rows, %4 item %5 allows %6" )
+                            .arg( limit->keyword )
+                            .arg( tableIndex + 1 )
+                            .arg( rowCount )
+                            .arg( source )
+                            .arg( limit->dimsItem )
+                            .arg( maxRows ) );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Well, group and connection counts against WELLDIMS. Only checked when WELLDIMS is in the deck.
+//--------------------------------------------------------------------------------------------------
+void DataDeckSizeChecker::checkWellLimits( const Opm::DeckKeyword& keyword )
+{
+    if ( !m_latestKeywords.contains( "WELLDIMS" ) )
+    {
+        return;
+    }
+
+    const int maxWells       = resolveSize( "WELLDIMS", "MAXWELLS" );
+    const int maxConnections = resolveSize( "WELLDIMS", "MAXCONN" );
+    const int maxGroups      = resolveSize( "WELLDIMS", "MAXGROUPS" );
+
+    auto stringValue = []( const Opm::DeckRecord& record, const char* itemName ) -> QString
+    {
+        if ( !record.hasItem( itemName ) ) return QString();
+        const Opm::DeckItem& item = record.getItem( itemName );
+        return item.hasValue( 0 ) ? QString::fromStdString( item.get<std::string>( 0 ) ) : QString();
+    };
+
+    const bool isWelspecs = keyword.name() == "WELSPECS";
+
+    for ( size_t i = 0; i < keyword.size(); ++i )
+    {
+        const Opm::DeckRecord& record = keyword.getRecord( i );
+
+        QString well = stringValue( record, "WELL" );
+        if ( well.isEmpty() || well.contains( '*' ) || well.contains( '?' ) )
+        {
+            continue;
+        }
+
+        if ( isWelspecs )
+        {
+            m_wells.insert( well );
+
+            QString group = stringValue( record, "GROUP" );
+            if ( !group.isEmpty() && group != "FIELD" )
+            {
+                m_groups.insert( group );
+            }
+        }
+        else
+        {
+            int connections = 1;
+            if ( record.hasItem( "K1" ) && record.hasItem( "K2" ) )
+            {
+                const Opm::DeckItem& k1 = record.getItem( "K1" );
+                const Opm::DeckItem& k2 = record.getItem( "K2" );
+                if ( k1.hasValue( 0 ) && k2.hasValue( 0 ) )
+                {
+                    connections = std::max( 1, k2.get<int>( 0 ) - k1.get<int>( 0 ) + 1 );
+                }
+            }
+            m_wellConnections[well] += connections;
+
+            if ( maxConnections > 0 && m_wellConnections[well] > maxConnections && !m_connectionLimitReported )
+            {
+                m_connectionLimitReported = true;
+                addProblem( keyword,
+                            DataDeckProblem::Severity::WARNING,
+                            QString( "Well %1 has more than %2 connections (WELLDIMS item MAXCONN)" ).arg( well ).arg( maxConnections ) );
+            }
+        }
+    }
+
+    if ( maxWells >= 0 && m_wells.size() > maxWells && !m_wellLimitReported )
+    {
+        m_wellLimitReported = true;
+        addProblem( keyword,
+                    DataDeckProblem::Severity::WARNING,
+                    QString( "%1 wells defined, WELLDIMS item MAXWELLS allows %2" ).arg( m_wells.size() ).arg( maxWells ) );
+    }
+
+    if ( maxGroups >= 0 && m_groups.size() > maxGroups && !m_groupLimitReported )
+    {
+        m_groupLimitReported = true;
+        addProblem( keyword,
+                    DataDeckProblem::Severity::WARNING,
+                    QString( "%1 groups defined, WELLDIMS item MAXGROUPS allows %2" ).arg( m_groups.size() ).arg( maxGroups ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckSizeChecker::addProblem( const Opm::DeckKeyword& keyword, DataDeckProblem::Severity severity, const QString& message )
+{
+    const auto& location = keyword.location();
+
+    DataDeckProblem problem;
+    problem.severity     = severity;
+    problem.message      = message;
+    problem.filePath     = QString::fromStdString( location.filename );
+    problem.line         = static_cast<int>( location.lineno );
+    problem.keyword      = QString::fromStdString( keyword.name() );
+    problem.keywordIndex = m_keywordIndex;
+    m_problems.append( problem );
+}
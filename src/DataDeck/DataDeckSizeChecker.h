@@ -0,0 +1,51 @@
+#pragma once
+
+#include "DataDeckProblem.h"
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+namespace Opm
+{
+class Deck;
+class DeckKeyword;
+} // namespace Opm
+
+//==================================================================================================
+/// Checks the limits of dimension keywords that the parser does not check: the rows of each
+/// saturation and PVT table against TABDIMS, and the well, group and connection limits of WELLDIMS.
+/// Record counts, like the number of SWOF tables, are not checked. The parser reads exactly the
+/// number of records the dimension keywords give.
+///
+/// The deck is visited once. Dimension keywords are evaluated when they are seen, keywords that are
+/// sized before any dimension keyword use the defaults from the keyword schema.
+//==================================================================================================
+class DataDeckSizeChecker
+{
+public:
+    static QList<DataDeckProblem> check( const Opm::Deck& deck );
+
+private:
+    DataDeckSizeChecker() = default;
+
+    void visit( const Opm::DeckKeyword& keyword, int keywordIndex );
+    int  resolveSize( const QString& dimsKeyword, const QString& item ) const;
+    void checkTableRows( const Opm::DeckKeyword& keyword );
+    void checkWellLimits( const Opm::DeckKeyword& keyword );
+    void addProblem( const Opm::DeckKeyword& keyword, DataDeckProblem::Severity severity, const QString& message );
+
+private:
+    QHash<QString, const Opm::DeckKeyword*> m_latestKeywords; // Latest occurrence of each keyword seen so far
+    mutable QHash<QString, int>             m_resolvedSizes;  // "KEYWORD:ITEM" to value, evaluated once
+
+    QHash<QString, int> m_wellConnections; // Connection count per well
+    QSet<QString>       m_wells;
+    QSet<QString>       m_groups;
+    bool                m_wellLimitReported       = false;
+    bool                m_groupLimitReported      = false;
+    bool                m_connectionLimitReported = false;
+
+    int                    m_keywordIndex = -1; // Index of the keyword being visited
+    QList<DataDeckProblem> m_problems;
+};
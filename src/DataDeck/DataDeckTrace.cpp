@@ -0,0 +1,303 @@
+#include "DataDeckTrace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// Bounds the memory of a long trace, later events of the thread are counted as dropped
+constexpr size_t MAX_EVENTS_PER_THREAD = 2000000;
+
+const char* TRACE_ENVIRONMENT_VARIABLE = "DATA_OBJECT_EDITOR_TRACE";
+
+const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+struct TraceEvent
+{
+    const char* category;
+    const char* name;
+    qint64      startNs;
+    qint64      endNs;
+    QString     detail;
+};
+
+//==================================================================================================
+/// Events of one thread. The mutex is only contended while the trace is written.
+//==================================================================================================
+struct ThreadBuffer
+{
+    std::mutex              mutex;
+    int                     threadId = 0;
+    QString                 threadName;
+    std::vector<TraceEvent> events;
+    qint64                  droppedCount = 0;
+};
+
+std::mutex                                 registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+int                                        nextThreadId = 1;
+
+//--------------------------------------------------------------------------------------------------
+/// The buffer stays in the registry after the thread ends, so events of finished workers are kept
+/// until the next trace starts
+//--------------------------------------------------------------------------------------------------
+ThreadBuffer& currentThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if ( !buffer )
+    {
+        buffer = std::make_shared<ThreadBuffer>();
+
+        QThread* thread = QThread::currentThread();
+        if ( QCoreApplication::instance() && thread == QCoreApplication::instance()->thread() )
+        {
+            buffer->threadName = "GUI";
+        }
+        else
+        {
+            buffer->threadName = thread && !thread->objectName().isEmpty() ? thread->objectName() : QString( "Worker" );
+        }
+
+        std::lock_guard<std::mutex> lock( registryMutex );
+        buffer->threadId = nextThreadId++;
+        buffer->threadName += QString( " %1" ).arg( buffer->threadId );
+        registry.push_back( buffer );
+    }
+    return *buffer;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void appendJsonString( QByteArray& out, const QString& text )
+{
+    out += '"';
+    for ( const char c : text.toUtf8() )
+    {
+        switch ( c )
+        {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if ( static_cast<unsigned char>( c ) < 0x20 )
+                {
+                    out += QByteArray( "\\u00" ) + QByteArray::number( static_cast<unsigned char>( c ), 16 ).rightJustified( 2, '0' );
+                }
+                else
+                {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Chrome trace timestamps are in microseconds
+//--------------------------------------------------------------------------------------------------
+QByteArray microseconds( qint64 ns )
+{
+    return QByteArray::number( ns / 1000.0, 'f', 3 );
+}
+
+} // namespace
+
+std::atomic<bool> DataDeckTrace::sm_isEnabled( false );
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckTrace::start()
+{
+    {
+        std::lock_guard<std::mutex> registryLock( registryMutex );
+
+        // Only the registry holds the buffer of a finished thread, its events belong to the previous trace
+        registry.erase( std::remove_if( registry.begin(),
+                                        registry.end(),
+                                        []( const std::shared_ptr<ThreadBuffer>& buffer ) { return buffer.use_count() == 1; } ),
+                        registry.end() );
+
+        for ( const auto& buffer : registry )
+        {
+            std::lock_guard<std::mutex> lock( buffer->mutex );
+            std::vector<TraceEvent>().swap( buffer->events ); // Release the memory of the previous trace
+            buffer->droppedCount = 0;
+        }
+    }
+
+    sm_isEnabled.store( true, std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckTrace::stop()
+{
+    sm_isEnabled.store( false, std::memory_order_relaxed );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckTrace::eventCount()
+{
+    qint64 count = 0;
+
+    std::lock_guard<std::mutex> registryLock( registryMutex );
+    for ( const auto& buffer : registry )
+    {
+        std::lock_guard<std::mutex> lock( buffer->mutex );
+        count += static_cast<qint64>( buffer->events.size() );
+    }
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataDeckTrace::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - traceEpoch ).count();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckTrace::addEvent( const char* category, const char* name, qint64 startNs, qint64 endNs, const QString& detail )
+{
+    ThreadBuffer& buffer = currentThreadBuffer();
+
+    std::lock_guard<std::mutex> lock( buffer.mutex );
+    if ( buffer.events.size() >= MAX_EVENTS_PER_THREAD )
+    {
+        buffer.droppedCount++;
+        return;
+    }
+    buffer.events.push_back( TraceEvent{ category, name, startNs, endNs, detail } );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Write the events in the Chrome trace event format, one complete ("X") event per scope and the
+/// thread names as metadata
+//--------------------------------------------------------------------------------------------------
+bool DataDeckTrace::writeChromeTrace( const QString& filePath, QString* errorMessage )
+{
+    QFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        *errorMessage = QString( "Could not write the trace %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    const QByteArray processId = QByteArray::number( QCoreApplication::applicationPid() );
+
+    QByteArray out;
+    out.reserve( 1 << 20 );
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool   isFirst      = true;
+    bool   isWriteOk    = true;
+    qint64 droppedCount = 0;
+
+    auto flush = [&file, &out, &isWriteOk]()
+    {
+        isWriteOk = isWriteOk && file.write( out ) == out.size();
+        out.resize( 0 );
+    };
+
+    std::lock_guard<std::mutex> registryLock( registryMutex );
+    for ( const auto& buffer : registry )
+    {
+        std::lock_guard<std::mutex> lock( buffer->mutex );
+        droppedCount += buffer->droppedCount;
+
+        const QByteArray threadId = QByteArray::number( buffer->threadId );
+
+        if ( !isFirst ) out += ",\n";
+        isFirst = false;
+        out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + processId + ",\"tid\":" + threadId + ",\"args\":{\"name\":";
+        appendJsonString( out, buffer->threadName );
+        out += "}}";
+
+        for ( const TraceEvent& event : buffer->events )
+        {
+            out += ",\n{\"ph\":\"X\",\"cat\":\"";
+            out += event.category;
+            out += "\",\"name\":\"";
+            out += event.name;
+            out += "\",\"pid\":" + processId + ",\"tid\":" + threadId;
+            out += ",\"ts\":" + microseconds( event.startNs );
+            out += ",\"dur\":" + microseconds( event.endNs - event.startNs );
+            if ( !event.detail.isEmpty() )
+            {
+                out += ",\"args\":{\"detail\":";
+                appendJsonString( out, event.detail );
+                out += "}";
+            }
+            out += "}";
+
+            if ( out.size() > ( 1 << 20 ) ) flush();
+        }
+    }
+
+    out += "\n],\"otherData\":{\"droppedEvents\":" + QByteArray::number( droppedCount ) + "}}\n";
+    flush();
+
+    if ( !isWriteOk )
+    {
+        *errorMessage = QString( "Could not write the trace %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Start tracing when DATA_OBJECT_EDITOR_TRACE names an output file
+//--------------------------------------------------------------------------------------------------
+void DataDeckTrace::startFromEnvironment()
+{
+    if ( !qEnvironmentVariableIsEmpty( TRACE_ENVIRONMENT_VARIABLE ) )
+    {
+        start();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Write the trace started by startFromEnvironment()
+//--------------------------------------------------------------------------------------------------
+void DataDeckTrace::finishFromEnvironment()
+{
+    const QString filePath = qEnvironmentVariable( TRACE_ENVIRONMENT_VARIABLE );
+    if ( filePath.isEmpty() )
+    {
+        return;
+    }
+
+    stop();
+
+    QString errorMessage;
+    if ( !writeChromeTrace( filePath, &errorMessage ) )
+    {
+        std::fprintf( stderr, "%s\n", qPrintable( errorMessage ) );
+    }
+}
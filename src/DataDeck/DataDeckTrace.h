@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+
+//==================================================================================================
+/// Scoped tracing of the load and edit pipeline, written as Chrome trace JSON that chrome://tracing
+/// and Perfetto open.
+///
+/// Each scope records one complete event with its thread, start and duration. Events are buffered
+/// per thread and merged when the trace is written. While tracing is off a scope costs one relaxed
+/// atomic load, and with DATA_OBJECT_EDITOR_ENABLE_TRACING=OFF the scopes are compiled out.
+///
+/// Tracing is started from Tools > Record Trace, or for a whole run by setting the environment
+/// variable DATA_OBJECT_EDITOR_TRACE to the output file.
+//==================================================================================================
+class DataDeckTrace
+{
+public:
+    static void start(); // Discards the events of the previous trace
+    static void stop();
+    static bool isEnabled() { return sm_isEnabled.load( std::memory_order_relaxed ); }
+
+    static qint64 eventCount();
+    static bool   writeChromeTrace( const QString& filePath, QString* errorMessage );
+
+    static void startFromEnvironment();
+    static void finishFromEnvironment();
+
+    static qint64 nowNs();
+    static void   addEvent( const char* category, const char* name, qint64 startNs, qint64 endNs, const QString& detail );
+
+private:
+    static std::atomic<bool> sm_isEnabled;
+};
+
+//==================================================================================================
+/// Records the lifetime of the scope as one trace event. Use the DATADECK_TRACE_SCOPE macros, the
+/// category and name must be string literals.
+//==================================================================================================
+class DataDeckTraceScope
+{
+public:
+    DataDeckTraceScope( const char* category, const char* name )
+        : m_category( category )
+        , m_name( name )
+        , m_startNs( DataDeckTrace::isEnabled() ? DataDeckTrace::nowNs() : -1 )
+    {
+    }
+
+    ~DataDeckTraceScope()
+    {
+        if ( m_startNs >= 0 )
+        {
+            DataDeckTrace::addEvent( m_category, m_name, m_startNs, DataDeckTrace::nowNs(), m_detail );
+        }
+    }
+
+    DataDeckTraceScope( const DataDeckTraceScope& )            = delete;
+    DataDeckTraceScope& operator=( const DataDeckTraceScope& ) = delete;
+
+    bool isActive() const { return m_startNs >= 0; }
+    void setDetail( const QString& detail ) { m_detail = detail; }
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64      m_startNs;
+    QString     m_detail;
+};
+
+#define DATADECK_TRACE_CONCAT_INNER( a, b ) a##b
+#define DATADECK_TRACE_CONCAT( a, b ) DATADECK_TRACE_CONCAT_INNER( a, b )
+
+#ifdef DATA_OBJECT_EDITOR_TRACING
+
+#define DATADECK_TRACE_SCOPE( category, name ) \
+    DataDeckTraceScope DATADECK_TRACE_CONCAT( dataDeckTraceScope, __LINE__ )( category, name )
+
+// The detail expression, like a file name, is only evaluated while tracing
+#define DATADECK_TRACE_SCOPE_DETAIL( category, name, detail )                                         \
+    DataDeckTraceScope DATADECK_TRACE_CONCAT( dataDeckTraceScope, __LINE__ )( category, name );      \
+    if ( DATADECK_TRACE_CONCAT( dataDeckTraceScope, __LINE__ ).isActive() )                          \
+    DATADECK_TRACE_CONCAT( dataDeckTraceScope, __LINE__ ).setDetail( detail )
+
+#else
+
+#define DATADECK_TRACE_SCOPE( category, name ) ( (void)0 )
+#define DATADECK_TRACE_SCOPE_DETAIL( category, name, detail ) ( (void)0 )
+
+#endif
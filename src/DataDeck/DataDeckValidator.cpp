@@ -0,0 +1,535 @@
+#include "DataDeckValidator.h"
+#include "DataDeckGridChecker.h"
+#include "DataDeckKeywordScanner.h"
+#include "DataDeckLogging.h"
+#include "DataDeckMetrics.h"
+#include "DataDeckRangeChecker.h"
+#include "DataDeckSchemaChecker.h"
+#include "DataDeckSizeChecker.h"
+#include "RimDataDeck.h"
+
+#include "opm/common/OpmLog/LogBackend.hpp"
+#include "opm/common/OpmLog/LogUtil.hpp"
+#include "opm/common/OpmLog/OpmLog.hpp"
+#include "opm/input/eclipse/Deck/Deck.hpp"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QRegularExpression>
+#include <QTemporaryFile>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+//==================================================================================================
+/// OpmLog backend forwarding parser messages to the problem list of the parse running on the
+/// calling thread. Messages from threads that are not collecting are ignored. The backend holds no
+/// state shared between threads, it filters on the mask only and skips the message limiter, so
+/// parses on several threads can log through it at the same time.
+//==================================================================================================
+class ProblemCollectorLogBackend : public Opm::LogBackend
+{
+public:
+    ProblemCollectorLogBackend()
+        : Opm::LogBackend( Opm::Log::MessageType::Warning | Opm::Log::MessageType::Error | Opm::Log::MessageType::Problem |
+                           Opm::Log::MessageType::Bug )
+    {
+    }
+
+    void addTaggedMessage( int64_t messageType, const std::string& messageTag, const std::string& message ) override
+    {
+        if ( !threadProblems || ( messageType & getMask() ) == 0 )
+        {
+            return;
+        }
+
+        auto severity = messageType == Opm::Log::MessageType::Warning ? DataDeckProblem::Severity::WARNING
+                                                                       : DataDeckProblem::Severity::ERROR;
+        threadProblems->append( DataDeckValidator::problemFromMessage( severity, QString::fromStdString( message ) ) );
+    }
+
+    static thread_local QList<DataDeckProblem>* threadProblems;
+};
+
+thread_local QList<DataDeckProblem>* ProblemCollectorLogBackend::threadProblems = nullptr;
+
+namespace
+{
+//--------------------------------------------------------------------------------------------------
+/// Replace a relative path in the given item of a record line with the quoted absolute path. Paths
+/// starting with a PATHS alias are left as they are.
+//--------------------------------------------------------------------------------------------------
+QString withAbsolutePathItem( const QString& line, int pathItemIndex, const QString& basePath )
+{
+    int itemIndex = 0;
+    int position  = 0;
+    while ( position < line.size() )
+    {
+        if ( line[position].isSpace() )
+        {
+            ++position;
+            continue;
+        }
+        if ( line[position] == '/' || line.mid( position, 2 ) == "--" )
+        {
+            break;
+        }
+
+        const bool isQuoted = line[position] == '\'';
+        int        itemEnd  = position + 1;
+        if ( isQuoted )
+        {
+            itemEnd = line.indexOf( '\'', position + 1 );
+            if ( itemEnd < 0 ) break;
+            ++itemEnd;
+        }
+        else
+        {
+            while ( itemEnd < line.size() && !line[itemEnd].isSpace() && line[itemEnd] != '/' )
+            {
+                ++itemEnd;
+            }
+        }
+
+        if ( itemIndex == pathItemIndex )
+        {
+            const QString path = isQuoted ? line.mid( position + 1, itemEnd - position - 2 ) : line.mid( position, itemEnd - position );
+            if ( path.startsWith( '$' ) || QDir::isAbsolutePath( path ) )
+            {
+                return line;
+            }
+            return line.left( position ) + '\'' + QDir::cleanPath( QDir( basePath ).absoluteFilePath( path ) ) + '\'' + line.mid( itemEnd );
+        }
+
+        ++itemIndex;
+        position = itemEnd;
+    }
+    return line;
+}
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckValidator::DataDeckValidator( QObject* parent )
+    : QObject( parent )
+    , m_debounceTimer( nullptr )
+    , m_activeWatcher( nullptr )
+    , m_rerunWhenFinished( false )
+    , m_textLength( 0 )
+    , m_needsValidation( false )
+    , m_schemaChecker( std::make_shared<DataDeckSchemaChecker>() )
+{
+    m_debounceTimer = new QTimer( this );
+    m_debounceTimer->setSingleShot( true );
+    m_debounceTimer->setInterval( DEBOUNCE_MS );
+    connect( m_debounceTimer, &QTimer::timeout, this, &DataDeckValidator::startValidation );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataDeckValidator::~DataDeckValidator()
+{
+    // A running job completes on its own, its result is dropped together with the watcher
+    m_activeWatcher = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Validate the text of the document whenever it changes. The document is validated right away.
+/// Pass nullptr to stop validating, for instance while new text is being loaded.
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::setDocument( QTextDocument* document, const QString& deckFilePath, const QString& text )
+{
+    if ( m_document )
+    {
+        disconnect( m_document, nullptr, this, nullptr );
+    }
+
+    m_debounceTimer->stop();
+    m_activeWatcher     = nullptr;
+    m_rerunWhenFinished = false;
+    m_pendingChanges.clear();
+    m_baseText.clear();
+    m_textLength      = 0;
+    m_needsValidation = false;
+
+    if ( deckFilePath != m_deckFilePath )
+    {
+        m_schemaChecker->clearCache();
+    }
+
+    m_document     = document;
+    m_deckFilePath = deckFilePath;
+
+    if ( m_document )
+    {
+        m_baseText        = text.isNull() ? m_document->toPlainText() : text;
+        m_textLength      = m_baseText.size();
+        m_needsValidation = true;
+
+        connect( m_document, &QTextDocument::contentsChange, this, &DataDeckValidator::onContentsChange );
+        validateNow();
+    }
+    else if ( !m_problems.isEmpty() )
+    {
+        m_problems.clear();
+        emit validationFinished( m_problems );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataDeckValidator::deckFilePath() const
+{
+    return m_deckFilePath;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::validateNow()
+{
+    m_debounceTimer->stop();
+    startValidation();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataDeckValidator::isRunning() const
+{
+    return m_activeWatcher != nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckValidator::problems() const
+{
+    return m_problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::startValidation()
+{
+    if ( !m_document )
+    {
+        return;
+    }
+
+    if ( m_activeWatcher )
+    {
+        m_rerunWhenFinished = true;
+        return;
+    }
+
+    if ( !m_needsValidation )
+    {
+        return;
+    }
+
+    // The recorded edits must add up to the document, read it again if they do not
+    if ( m_textLength != m_document->characterCount() - 1 )
+    {
+        qCWarning( logValidation ) << "Edits since the last validation do not match the document, reading the whole text";
+
+        m_baseText   = m_document->toPlainText();
+        m_textLength = m_baseText.size();
+        m_pendingChanges.clear();
+    }
+
+    m_needsValidation = false;
+
+    auto* watcher = new QFutureWatcher<JobResult>( this );
+    connect( watcher, &QFutureWatcher<JobResult>::finished, this, [this, watcher]() { onJobFinished( watcher ); } );
+
+    m_activeWatcher = watcher;
+    DataDeckMetrics::trackBackgroundJob( watcher );
+
+    // The job owns the base text until it returns the edited text
+    watcher->setFuture( QtConcurrent::run(
+        []( QString text, const QList<TextChange>& changes, const QString& deckFilePath, std::shared_ptr<DataDeckSchemaChecker> schemaChecker )
+        {
+            applyChanges( text, changes );
+
+            JobResult result;
+            result.problems = validateText( text, deckFilePath, schemaChecker );
+            result.text     = std::move( text );
+            return result;
+        },
+        std::exchange( m_baseText, QString() ),
+        std::exchange( m_pendingChanges, QList<TextChange>() ),
+        m_deckFilePath,
+        m_schemaChecker ) );
+
+    emit validationStarted();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Record the edit with the inserted text. Changes of the whole document are reported including
+/// the paragraph separator after the last block, which is not part of the plain text.
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::onContentsChange( int position, int charsRemoved, int charsAdded )
+{
+    TextChange change;
+    change.position     = position;
+    change.charsRemoved = std::max( 0, std::min( charsRemoved, static_cast<int>( m_textLength ) - position ) );
+
+    const int insertedEnd = std::min( position + charsAdded, m_document->characterCount() - 1 );
+    if ( insertedEnd > position )
+    {
+        QTextCursor cursor( m_document );
+        cursor.setPosition( position );
+        cursor.setPosition( insertedEnd, QTextCursor::KeepAnchor );
+
+        // Block separators as in QTextDocument::toPlainText()
+        change.insertedText = cursor.selectedText();
+        change.insertedText.replace( QChar::ParagraphSeparator, '\n' );
+        change.insertedText.replace( QChar::LineSeparator, '\n' );
+    }
+
+    m_textLength += change.insertedText.size() - change.charsRemoved;
+    m_pendingChanges.append( change );
+    m_needsValidation = true;
+
+    m_debounceTimer->start();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::onJobFinished( QFutureWatcher<JobResult>* watcher )
+{
+    watcher->deleteLater();
+
+    if ( watcher != m_activeWatcher )
+    {
+        // The document was replaced while the job was running
+        return;
+    }
+
+    const JobResult result = watcher->result();
+
+    m_activeWatcher = nullptr;
+    m_baseText      = result.text;
+    m_problems      = result.problems;
+
+    emit validationFinished( m_problems );
+
+    if ( m_rerunWhenFinished )
+    {
+        m_rerunWhenFinished = false;
+        m_debounceTimer->start();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Opm::OpmLog creates its logger on first use and changes its backend map without synchronization.
+/// Both happen here, once, before any thread parses.
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::registerLogBackend()
+{
+    static std::once_flag flag;
+    std::call_once( flag, []() { Opm::OpmLog::addBackend( "DataDeckValidator", std::make_shared<ProblemCollectorLogBackend>() ); } );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Parse a DATA file and collect the messages the parser reports. Returns nullptr if parsing fails,
+/// the failure is then the last problem in the list.
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<Opm::Deck> DataDeckValidator::parseCollectingProblems( const QString& filePath, QList<DataDeckProblem>& problems )
+{
+    ProblemCollectorLogBackend::threadProblems = &problems;
+
+    std::shared_ptr<Opm::Deck> deck;
+    try
+    {
+        QElapsedTimer parseTimer;
+        parseTimer.start();
+
+        deck = RimDataDeck::parseDeckFile( filePath );
+        DataDeckMetrics::recordParse( parseTimer.nsecsElapsed() );
+    }
+    catch ( const std::exception& e )
+    {
+        problems.append( problemFromMessage( DataDeckProblem::Severity::ERROR, QString::fromStdString( e.what() ) ) );
+    }
+
+    ProblemCollectorLogBackend::threadProblems = nullptr;
+
+    return deck;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Parse unsaved text. The text is written to the temporary directory, with the include paths made
+/// absolute so they resolve from the deck's directory as they do when the deck itself is parsed.
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckValidator::validateText( const QString&                         text,
+                                                       const QString&                         deckFilePath,
+                                                       std::shared_ptr<DataDeckSchemaChecker> schemaChecker )
+{
+    QList<DataDeckProblem> problems;
+
+    QFileInfo      deckInfo( deckFilePath );
+    QTemporaryFile tempFile( QDir( QDir::tempPath() ).filePath( "validate_XXXXXX_" + deckInfo.fileName() ) );
+    if ( !tempFile.open() )
+    {
+        DataDeckProblem problem;
+        problem.message  = "Could not create a temporary file for validation";
+        problem.filePath = deckFilePath;
+        problems.append( problem );
+        return problems;
+    }
+
+    tempFile.write( withAbsoluteIncludePaths( text, deckInfo.absolutePath() ).toUtf8() );
+    tempFile.flush();
+
+    auto deck = parseCollectingProblems( tempFile.fileName(), problems );
+    if ( deck )
+    {
+        problems.append( checkDeck( *deck, schemaChecker ) );
+    }
+    replaceFilePath( problems, tempFile.fileName(), deckFilePath );
+
+    return problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Run the checks on the parsed records. The schema check is skipped if no checker is given.
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProblem> DataDeckValidator::checkDeck( const Opm::Deck& deck, std::shared_ptr<DataDeckSchemaChecker> schemaChecker )
+{
+    QList<DataDeckProblem> problems;
+    if ( schemaChecker )
+    {
+        problems.append( schemaChecker->check( deck ) );
+    }
+    problems.append( DataDeckSizeChecker::check( deck ) );
+    problems.append( DataDeckGridChecker::check( deck ) );
+    problems.append( DataDeckRangeChecker::check( deck, DataDeckRangeChecker::activeRules() ) );
+    return problems;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Parser messages locate the problem with a line like "In <file> line <n>"
+//--------------------------------------------------------------------------------------------------
+DataDeckProblem DataDeckValidator::problemFromMessage( DataDeckProblem::Severity severity, const QString& message )
+{
+    static const QRegularExpression locationPattern( "In (.+) line (\\d+)" );
+    static const QRegularExpression keywordPattern( "keyword:? '?([A-Z][A-Z0-9_]*)" );
+
+    DataDeckProblem problem;
+    problem.severity = severity;
+
+    QStringList messageLines;
+    for ( const QString& line : message.split( '\n', Qt::SkipEmptyParts ) )
+    {
+        QRegularExpressionMatch match = locationPattern.match( line );
+        if ( match.hasMatch() && problem.line < 0 )
+        {
+            problem.filePath = match.captured( 1 ).trimmed();
+            problem.line     = match.captured( 2 ).toInt();
+        }
+        else
+        {
+            messageLines << line.trimmed();
+        }
+    }
+    problem.message = messageLines.join( ' ' );
+
+    QRegularExpressionMatch keywordMatch = keywordPattern.match( message );
+    if ( keywordMatch.hasMatch() )
+    {
+        problem.keyword = keywordMatch.captured( 1 );
+    }
+
+    return problem;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::replaceFilePath( QList<DataDeckProblem>& problems, const QString& fromFilePath, const QString& toFilePath )
+{
+    const QString fromAbsolute = QFileInfo( fromFilePath ).absoluteFilePath();
+    const QString fromName     = QFileInfo( fromFilePath ).fileName();
+
+    for ( DataDeckProblem& problem : problems )
+    {
+        if ( problem.filePath.isEmpty() || problem.filePath == fromFilePath || problem.filePath == fromAbsolute ||
+             problem.filePath == fromName )
+        {
+            problem.filePath = toFilePath;
+        }
+        problem.message.replace( fromFilePath, toFilePath );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Apply edits in the order they were made, each position is in the text after the edits before it
+//--------------------------------------------------------------------------------------------------
+void DataDeckValidator::applyChanges( QString& text, const QList<TextChange>& changes )
+{
+    for ( const TextChange& change : changes )
+    {
+        text.replace( change.position, change.charsRemoved, change.insertedText );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The parser resolves relative paths from the directory of the file being parsed. INCLUDE holds
+/// the path as its first item, PATHS the alias and then the path in each record.
+//--------------------------------------------------------------------------------------------------
+QString DataDeckValidator::withAbsoluteIncludePaths( const QString& text, const QString& basePath )
+{
+    QStringList lines = text.split( '\n' );
+
+    QString keyword; // INCLUDE or PATHS while their records are read, empty otherwise
+    for ( QString& line : lines )
+    {
+        const QString code = DataDeckKeywordScanner::stripComment( line ).trimmed();
+        if ( code.isEmpty() )
+        {
+            continue;
+        }
+
+        if ( code.compare( "INCLUDE", Qt::CaseInsensitive ) == 0 || code.compare( "PATHS", Qt::CaseInsensitive ) == 0 )
+        {
+            keyword = code.toUpper();
+            continue;
+        }
+
+        if ( keyword.isEmpty() )
+        {
+            continue;
+        }
+
+        if ( code == "/" )
+        {
+            keyword.clear();
+            continue;
+        }
+
+        line = withAbsolutePathItem( line, keyword == "INCLUDE" ? 0 : 1, basePath );
+
+        // INCLUDE has one record
+        if ( keyword == "INCLUDE" )
+        {
+            keyword.clear();
+        }
+    }
+
+    return lines.join( '\n' );
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "DataDeckProblem.h"
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <memory>
+
+namespace Opm
+{
+class Deck;
+}
+
+class DataDeckSchemaChecker;
+class QTextDocument;
+class QTimer;
+
+template <typename T>
+class QFutureWatcher;
+
+//==================================================================================================
+/// Re-parses the text of a document on a worker thread after edits and collects every error and
+/// warning reported by the parser, with file and line where the parser provides them. The parsed
+/// records are then checked against the keyword schema and the dimension keywords.
+///
+/// Validation is debounced, at most one job runs at a time and edits made while a job is running
+/// trigger one more run when it completes.
+///
+/// The document is never read as a whole after setDocument(). The validator keeps the text of the
+/// last job and records each edit of the document. The job applies the edits to that text on the
+/// worker thread, so the time spent on the GUI thread depends on the size of the edits only.
+//==================================================================================================
+class DataDeckValidator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DataDeckValidator( QObject* parent = nullptr );
+    ~DataDeckValidator() override;
+
+    // The text must be the current text of the document, typically the text it was loaded from. If
+    // it is not given, the document is read here.
+    void    setDocument( QTextDocument* document, const QString& deckFilePath, const QString& text = QString() );
+    QString deckFilePath() const;
+    void    validateNow();
+    bool    isRunning() const;
+
+    QList<DataDeckProblem> problems() const;
+
+    // Call at startup, before the first parse. Parser messages are only collected after this.
+    static void registerLogBackend();
+
+    // Parsing helpers, safe to call from worker threads
+    static std::shared_ptr<Opm::Deck> parseCollectingProblems( const QString& filePath, QList<DataDeckProblem>& problems );
+    static QList<DataDeckProblem>     validateText( const QString&                         text,
+                                                    const QString&                         deckFilePath,
+                                                    std::shared_ptr<DataDeckSchemaChecker> schemaChecker = nullptr );
+    static QList<DataDeckProblem>     checkDeck( const Opm::Deck& deck, std::shared_ptr<DataDeckSchemaChecker> schemaChecker = nullptr );
+    static DataDeckProblem            problemFromMessage( DataDeckProblem::Severity severity, const QString& message );
+    static void replaceFilePath( QList<DataDeckProblem>& problems, const QString& fromFilePath, const QString& toFilePath );
+
+    // The text with relative INCLUDE and PATHS paths made absolute, line numbers are kept
+    static QString withAbsoluteIncludePaths( const QString& text, const QString& basePath );
+
+    // An edit in document positions, which equal QTextDocument::toPlainText() indexes
+    struct TextChange
+    {
+        int     position     = 0;
+        int     charsRemoved = 0;
+        QString insertedText;
+    };
+    static void applyChanges( QString& text, const QList<TextChange>& changes );
+
+    static constexpr int DEBOUNCE_MS = 750;
+
+signals:
+    void validationStarted();
+    void validationFinished( const QList<DataDeckProblem>& problems );
+
+private slots:
+    void startValidation();
+    void onContentsChange( int position, int charsRemoved, int charsAdded );
+
+private:
+    struct JobResult
+    {
+        QString                text; // The validated text, the base for the edits after it
+        QList<DataDeckProblem> problems;
+    };
+
+    void onJobFinished( QFutureWatcher<JobResult>* watcher );
+
+private:
+    QPointer<QTextDocument> m_document;
+    QString                 m_deckFilePath;
+    QTimer*                 m_debounceTimer;
+
+    QFutureWatcher<JobResult>* m_activeWatcher;
+    bool                       m_rerunWhenFinished;
+
+    // The text of the last job and the edits made to the document since that job was started
+    QString           m_baseText;
+    QList<TextChange> m_pendingChanges;
+    qint64            m_textLength; // Length of the base text with the pending edits applied
+    bool              m_needsValidation; // The document was set or edited since the last job was started
+
+    QList<DataDeckProblem> m_problems;
+
+    std::shared_ptr<DataDeckSchemaChecker> m_schemaChecker; // Shared with running jobs
+};
@@ -0,0 +1,503 @@
+#include "DataFileMappedViewer.h"
+#include "DataFileSyntaxHighlighter.h"
+
+#include <QFileInfo>
+#include <QInputDialog>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTextLayout>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <functional>
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataFileMappedViewer::DataFileMappedViewer( QWidget* parent )
+    : QAbstractScrollArea( parent )
+    , m_data( nullptr )
+    , m_size( 0 )
+    , m_maxLineLength( 0 )
+    , m_currentLine( -1 )
+    , m_selectionFirst( -1 )
+    , m_selectionLast( -1 )
+    , m_searchOffset( -1 )
+    , m_highlighter( nullptr )
+{
+    // Document independent highlighter, only formatLine() is used
+    m_highlighter = new DataFileSyntaxHighlighter( nullptr );
+    m_highlighter->setParent( this );
+
+    // Same font as the text editor
+    QFont font;
+    font.setFamily( "Cascadia Mono" );
+    font.setStyleHint( QFont::Monospace );
+    font.setPointSize( 10 );
+    setFont( font );
+
+    setFocusPolicy( Qt::StrongFocus );
+    viewport()->setCursor( Qt::IBeamCursor );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+DataFileMappedViewer::~DataFileMappedViewer()
+{
+    closeFile();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataFileMappedViewer::shouldUseForFile( const QString& filePath )
+{
+    QFileInfo info( filePath );
+    return info.exists() && info.isFile() && info.size() > SIZE_THRESHOLD;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataFileMappedViewer::openFile( const QString& filePath )
+{
+    if ( filePath == m_file.fileName() && m_data )
+    {
+        return true;
+    }
+
+    closeFile();
+
+    m_file.setFileName( filePath );
+    if ( !m_file.open( QIODevice::ReadOnly ) )
+    {
+        return false;
+    }
+
+    m_size = m_file.size();
+    if ( m_size > 0 )
+    {
+        m_data = m_file.map( 0, m_size );
+        if ( !m_data )
+        {
+            closeFile();
+            return false;
+        }
+    }
+
+    buildLineIndex();
+    updateScrollBars();
+    verticalScrollBar()->setValue( 0 );
+    horizontalScrollBar()->setValue( 0 );
+    viewport()->update();
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::closeFile()
+{
+    if ( m_data )
+    {
+        m_file.unmap( const_cast<uchar*>( m_data ) );
+        m_data = nullptr;
+    }
+    if ( m_file.isOpen() )
+    {
+        m_file.close();
+    }
+    m_file.setFileName( QString() );
+
+    m_size = 0;
+    m_lineOffsets.clear();
+    m_lineOffsets.shrink_to_fit();
+    m_sectionChanges.clear();
+    m_maxLineLength  = 0;
+    m_currentLine    = -1;
+    m_selectionFirst = -1;
+    m_selectionLast  = -1;
+    m_searchOffset   = -1;
+
+    updateScrollBars();
+    viewport()->update();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataFileMappedViewer::filePath() const
+{
+    return m_file.fileName();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataFileMappedViewer::lineCount() const
+{
+    return static_cast<qint64>( m_lineOffsets.size() );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Index the start of every line and the lines where a section starts, in one pass over the mapping
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::buildLineIndex()
+{
+    m_lineOffsets.clear();
+    m_sectionChanges.clear();
+    m_maxLineLength = 0;
+
+    m_lineOffsets.push_back( 0 );
+    if ( !m_data )
+    {
+        return;
+    }
+
+    const char* begin = reinterpret_cast<const char*>( m_data );
+    const char* end   = begin + m_size;
+    const char* line  = begin;
+
+    while ( line < end )
+    {
+        // Section keywords start with a letter, data lines can be rejected on the first character
+        const char* first = line;
+        while ( first < end && ( *first == ' ' || *first == '\t' ) )
+        {
+            ++first;
+        }
+        if ( first < end && std::isalpha( static_cast<unsigned char>( *first ) ) )
+        {
+            const char* wordEnd = first;
+            while ( wordEnd < end && wordEnd - first <= 8 && std::isalpha( static_cast<unsigned char>( *wordEnd ) ) )
+            {
+                ++wordEnd;
+            }
+            int sectionIndex = m_highlighter->sectionIndexOfLine( QString::fromLatin1( first, wordEnd - first ) );
+            if ( sectionIndex >= 0 )
+            {
+                m_sectionChanges.emplace_back( static_cast<qint64>( m_lineOffsets.size() ) - 1, sectionIndex );
+            }
+        }
+
+        const void* lineBreak = std::memchr( line, '\n', end - line );
+        if ( !lineBreak )
+        {
+            m_maxLineLength = std::max<qint64>( m_maxLineLength, end - line );
+            break;
+        }
+
+        const char* next = static_cast<const char*>( lineBreak ) + 1;
+        m_maxLineLength  = std::max<qint64>( m_maxLineLength, next - line - 1 );
+        m_lineOffsets.push_back( next - begin );
+        line = next;
+    }
+
+    m_maxLineLength = std::min<qint64>( m_maxLineLength, MAX_DISPLAYED_COLUMNS );
+    m_lineOffsets.shrink_to_fit();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString DataFileMappedViewer::lineText( qint64 lineIndex ) const
+{
+    if ( !m_data || lineIndex < 0 || lineIndex >= lineCount() )
+    {
+        return QString();
+    }
+
+    qint64 start = m_lineOffsets[lineIndex];
+    qint64 end   = lineIndex + 1 < lineCount() ? m_lineOffsets[lineIndex + 1] : m_size;
+
+    while ( end > start && ( m_data[end - 1] == '\n' || m_data[end - 1] == '\r' ) )
+    {
+        --end;
+    }
+
+    // Very long lines are cut, there is no point in laying out megabytes of a single line
+    end = std::min( end, start + MAX_DISPLAYED_COLUMNS );
+
+    return QString::fromUtf8( reinterpret_cast<const char*>( m_data + start ), end - start );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 DataFileMappedViewer::lineIndexAtOffset( qint64 offset ) const
+{
+    auto it = std::upper_bound( m_lineOffsets.begin(), m_lineOffsets.end(), offset );
+    return static_cast<qint64>( it - m_lineOffsets.begin() ) - 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataFileMappedViewer::sectionIndexAtLine( qint64 lineIndex ) const
+{
+    auto it = std::upper_bound( m_sectionChanges.begin(),
+                                m_sectionChanges.end(),
+                                lineIndex,
+                                []( qint64 line, const std::pair<qint64, int>& change ) { return line < change.first; } );
+    if ( it == m_sectionChanges.begin() )
+    {
+        return -1;
+    }
+    return std::prev( it )->second;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataFileMappedViewer::lineHeight() const
+{
+    return std::max( 1, fontMetrics().height() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int DataFileMappedViewer::gutterWidth() const
+{
+    int    digits = 1;
+    qint64 max    = std::max<qint64>( 1, lineCount() );
+    while ( max >= 10 )
+    {
+        max /= 10;
+        ++digits;
+    }
+
+    return 10 + fontMetrics().horizontalAdvance( QLatin1Char( '9' ) ) * digits;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::updateScrollBars()
+{
+    const int visibleLines = viewport()->height() / lineHeight();
+    verticalScrollBar()->setRange( 0, static_cast<int>( std::max<qint64>( 0, lineCount() - visibleLines ) ) );
+    verticalScrollBar()->setPageStep( visibleLines );
+    verticalScrollBar()->setSingleStep( 1 );
+
+    const int charWidth      = std::max( 1, fontMetrics().horizontalAdvance( QLatin1Char( '9' ) ) );
+    const int visibleColumns = std::max( 1, ( viewport()->width() - gutterWidth() ) / charWidth );
+    horizontalScrollBar()->setRange( 0, static_cast<int>( std::max<qint64>( 0, m_maxLineLength - visibleColumns + 1 ) ) );
+    horizontalScrollBar()->setPageStep( visibleColumns );
+    horizontalScrollBar()->setSingleStep( 1 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::scrollToLine( qint64 lineIndex )
+{
+    const qint64 first        = verticalScrollBar()->value();
+    const qint64 visibleLines = std::max( 1, viewport()->height() / lineHeight() );
+
+    if ( lineIndex < first || lineIndex >= first + visibleLines )
+    {
+        verticalScrollBar()->setValue( static_cast<int>( std::max<qint64>( 0, lineIndex - visibleLines / 3 ) ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::selectLines( int startLine, int endLine )
+{
+    if ( startLine < 1 || endLine < startLine || startLine > lineCount() )
+    {
+        return;
+    }
+
+    m_selectionFirst = startLine - 1;
+    m_selectionLast  = std::min<qint64>( endLine, lineCount() ) - 1;
+    m_currentLine    = m_selectionFirst;
+
+    scrollToLine( m_selectionFirst );
+    viewport()->update();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Search the mapped bytes for the UTF-8 encoded text, starting after (or before) the previous match
+//--------------------------------------------------------------------------------------------------
+bool DataFileMappedViewer::find( const QString& text, bool forward )
+{
+    if ( !m_data || text.isEmpty() )
+    {
+        return false;
+    }
+
+    if ( text != m_searchText )
+    {
+        m_searchText   = text;
+        m_searchOffset = m_currentLine >= 0 ? m_lineOffsets[m_currentLine] - 1 : -1;
+    }
+
+    const QByteArray needle = text.toUtf8();
+    const char*      begin  = reinterpret_cast<const char*>( m_data );
+    const char*      end    = begin + m_size;
+    const char*      match  = end;
+
+    if ( forward )
+    {
+        const char* from = begin + std::max<qint64>( 0, m_searchOffset + 1 );
+        match            = std::search( from, end, std::boyer_moore_horspool_searcher( needle.begin(), needle.end() ) );
+    }
+    else if ( m_searchOffset > 0 )
+    {
+        const char* last = std::find_end( begin, begin + m_searchOffset, needle.begin(), needle.end() );
+        match            = last == begin + m_searchOffset ? end : last;
+    }
+
+    if ( match == end )
+    {
+        return false;
+    }
+
+    m_searchOffset   = match - begin;
+    const int line   = static_cast<int>( lineIndexAtOffset( m_searchOffset ) ) + 1;
+    selectLines( line, line );
+    emit currentLineChanged( line );
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::paintEvent( QPaintEvent* event )
+{
+    QPainter painter( viewport() );
+    painter.fillRect( event->rect(), palette().color( QPalette::Base ) );
+
+    if ( !m_data )
+    {
+        return;
+    }
+
+    const int    lineHeight   = this->lineHeight();
+    const int    gutter       = gutterWidth();
+    const int    charWidth    = fontMetrics().horizontalAdvance( QLatin1Char( '9' ) );
+    const qint64 firstLine    = verticalScrollBar()->value();
+    const int    visibleLines = viewport()->height() / lineHeight + 1;
+    const int    textX        = gutter + 4 - horizontalScrollBar()->value() * charWidth;
+
+    const QColor selectionColor   = palette().color( QPalette::Highlight ).lighter( 160 );
+    const QColor currentLineColor = palette().color( QPalette::Base ).lighter( 102 );
+
+    for ( int i = 0; i < visibleLines && firstLine + i < lineCount(); ++i )
+    {
+        const qint64 line = firstLine + i;
+        const int    y    = i * lineHeight;
+
+        if ( line >= m_selectionFirst && line <= m_selectionLast )
+        {
+            painter.fillRect( gutter, y, viewport()->width() - gutter, lineHeight, selectionColor );
+        }
+        else if ( line == m_currentLine )
+        {
+            painter.fillRect( gutter, y, viewport()->width() - gutter, lineHeight, currentLineColor );
+        }
+
+        // Text, highlighted with the same rules as the editor
+        QString     text = lineText( line );
+        QTextLayout layout( text, font() );
+        layout.setFormats( m_highlighter->formatLine( text, sectionIndexAtLine( line ) ) );
+        layout.beginLayout();
+        layout.createLine();
+        layout.endLayout();
+
+        painter.save();
+        painter.setClipRect( gutter, 0, viewport()->width() - gutter, viewport()->height() );
+        painter.setPen( palette().color( QPalette::Text ) );
+        layout.draw( &painter, QPointF( textX, y ) );
+        painter.restore();
+
+        // Line number
+        painter.setPen( Qt::gray );
+        painter.drawText( 0, y, gutter - 8, lineHeight, Qt::AlignRight, QString::number( line + 1 ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::resizeEvent( QResizeEvent* event )
+{
+    QAbstractScrollArea::resizeEvent( event );
+    updateScrollBars();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::mousePressEvent( QMouseEvent* event )
+{
+    if ( !m_data )
+    {
+        return;
+    }
+
+    qint64 line = verticalScrollBar()->value() + static_cast<qint64>( event->position().y() ) / lineHeight();
+    if ( line >= lineCount() )
+    {
+        return;
+    }
+
+    m_currentLine    = line;
+    m_selectionFirst = -1;
+    m_selectionLast  = -1;
+    viewport()->update();
+
+    emit currentLineChanged( static_cast<int>( line ) + 1 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileMappedViewer::keyPressEvent( QKeyEvent* event )
+{
+    if ( event->matches( QKeySequence::Find ) )
+    {
+        bool    ok   = false;
+        QString text = QInputDialog::getText( this, "Find", "Find text:", QLineEdit::Normal, m_searchText, &ok );
+        if ( ok && !text.isEmpty() )
+        {
+            find( text, true );
+        }
+        return;
+    }
+
+    if ( event->matches( QKeySequence::FindNext ) )
+    {
+        find( m_searchText, true );
+        return;
+    }
+
+    if ( event->matches( QKeySequence::FindPrevious ) )
+    {
+        find( m_searchText, false );
+        return;
+    }
+
+    if ( event->matches( QKeySequence::MoveToStartOfDocument ) )
+    {
+        verticalScrollBar()->setValue( 0 );
+        return;
+    }
+
+    if ( event->matches( QKeySequence::MoveToEndOfDocument ) )
+    {
+        verticalScrollBar()->setValue( verticalScrollBar()->maximum() );
+        return;
+    }
+
+    QAbstractScrollArea::keyPressEvent( event );
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QAbstractScrollArea>
+#include <QFile>
+
+#include <utility>
+#include <vector>
+
+class DataFileSyntaxHighlighter;
+
+//==================================================================================================
+/// Read-only viewer for very large DATA and include files
+///
+/// Text is rendered straight from a memory-mapped file. Only a line-offset index is kept in memory,
+/// lines are decoded and highlighted when they are painted.
+//==================================================================================================
+class DataFileMappedViewer : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit DataFileMappedViewer( QWidget* parent = nullptr );
+    ~DataFileMappedViewer() override;
+
+    bool    openFile( const QString& filePath );
+    void    closeFile();
+    QString filePath() const;
+    qint64  lineCount() const;
+
+    void selectLines( int startLine, int endLine ); // 1-based, inclusive
+    bool find( const QString& text, bool forward = true );
+
+    static bool shouldUseForFile( const QString& filePath );
+
+    static constexpr qint64 SIZE_THRESHOLD       = 64 * 1024 * 1024;
+    static constexpr int    MAX_DISPLAYED_COLUMNS = 4096;
+
+signals:
+    void currentLineChanged( int lineNumber ); // 1-based
+
+protected:
+    void paintEvent( QPaintEvent* event ) override;
+    void resizeEvent( QResizeEvent* event ) override;
+    void mousePressEvent( QMouseEvent* event ) override;
+    void keyPressEvent( QKeyEvent* event ) override;
+
+private:
+    void    buildLineIndex();
+    QString lineText( qint64 lineIndex ) const;
+    qint64  lineIndexAtOffset( qint64 offset ) const;
+    int     sectionIndexAtLine( qint64 lineIndex ) const;
+    void    updateScrollBars();
+    void    scrollToLine( qint64 lineIndex );
+    int     gutterWidth() const;
+    int     lineHeight() const;
+
+private:
+    QFile        m_file;
+    const uchar* m_data;
+    qint64       m_size;
+
+    std::vector<qint64>                 m_lineOffsets; // Start offset of each line
+    std::vector<std::pair<qint64, int>> m_sectionChanges; // (line index, section index), sorted by line
+    qint64                              m_maxLineLength;
+
+    qint64  m_currentLine;
+    qint64  m_selectionFirst;
+    qint64  m_selectionLast;
+    QString m_searchText;
+    qint64  m_searchOffset;
+
+    DataFileSyntaxHighlighter* m_highlighter;
+};
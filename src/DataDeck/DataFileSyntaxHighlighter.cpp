@@ -1,7 +1,14 @@
 #include "DataFileSyntaxHighlighter.h"
+#include "DataDeckMetrics.h"
+#include "DataDeckTrace.h"
 #include "KeywordDatabase.h"
 
+#include <QElapsedTimer>
 #include <QTextBlock>
+#include <QTextLayout>
+#include <QTimer>
+
+#include <algorithm>
 
 //--------------------------------------------------------------------------------------------------
 ///
@@ -9,6 +16,13 @@
 DataFileSyntaxHighlighter::DataFileSyntaxHighlighter( QTextDocument* parent )
     : QSyntaxHighlighter( parent )
     , m_keywordDatabase( KeywordDatabase::instance() )
+    , m_priorityFirstBlock( 0 )
+    , m_priorityLastBlock( 200 )
+    , m_idleBlockNumber( 0 )
+    , m_idlePassNs( 0 )
+    , m_forceFormatting( false )
+    , m_priorityTimer( nullptr )
+    , m_idleTimer( nullptr )
 {
     HighlightingRule rule;
 
@@ -80,6 +94,164 @@ DataFileSyntaxHighlighter::DataFileSyntaxHighlighter( QTextDocument* parent )
 
     // Initialize keyword sets
     initializeKeywordSets();
+
+    // Coalesce priority range updates, the editor reports them on every viewport update
+    m_priorityTimer = new QTimer( this );
+    m_priorityTimer->setSingleShot( true );
+    m_priorityTimer->setInterval( 0 );
+    connect( m_priorityTimer, &QTimer::timeout, this, &DataFileSyntaxHighlighter::highlightPriorityRange );
+
+    m_idleTimer = new QTimer( this );
+    m_idleTimer->setInterval( 0 );
+    connect( m_idleTimer, &QTimer::timeout, this, &DataFileSyntaxHighlighter::runIdlePass );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Set the block range that must be formatted right away, typically the viewport and a margin
+//--------------------------------------------------------------------------------------------------
+void DataFileSyntaxHighlighter::setPriorityRange( int firstBlockNumber, int lastBlockNumber )
+{
+    m_priorityFirstBlock = std::max( 0, firstBlockNumber );
+    m_priorityLastBlock  = std::max( m_priorityFirstBlock, lastBlockNumber );
+
+    m_priorityTimer->start();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataFileSyntaxHighlighter::isIdlePassComplete() const
+{
+    return !m_idleTimer->isActive();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Format the blocks in the priority range that only have their state computed so far
+//--------------------------------------------------------------------------------------------------
+void DataFileSyntaxHighlighter::highlightPriorityRange()
+{
+    DATADECK_TRACE_SCOPE( "highlight", "DataFileSyntaxHighlighter::highlightPriorityRange" );
+
+    QTextDocument* doc = document();
+    if ( !doc ) return;
+
+    QTextBlock block = doc->findBlockByNumber( m_priorityFirstBlock );
+    while ( block.isValid() && block.blockNumber() <= m_priorityLastBlock )
+    {
+        formatBlockNow( block );
+        block = block.next();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Format the rest of the document in small time slices from the event loop
+//--------------------------------------------------------------------------------------------------
+void DataFileSyntaxHighlighter::runIdlePass()
+{
+    DATADECK_TRACE_SCOPE( "highlight", "DataFileSyntaxHighlighter::runIdlePass" );
+
+    QTextDocument* doc = document();
+    if ( !doc )
+    {
+        m_idleTimer->stop();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QTextBlock block = doc->findBlockByNumber( m_idleBlockNumber );
+    while ( block.isValid() && timer.elapsed() < IDLE_SLICE_MS )
+    {
+        formatBlockNow( block );
+        block = block.next();
+    }
+
+    m_idlePassNs += timer.nsecsElapsed();
+
+    if ( block.isValid() )
+    {
+        m_idleBlockNumber = block.blockNumber();
+    }
+    else
+    {
+        m_idleBlockNumber = doc->blockCount();
+        m_idleTimer->stop();
+        DataDeckMetrics::recordHighlightPass( m_idlePassNs );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Formatted blocks always carry at least one format range after a full pass, except lines without
+/// any tokens which are cheap to redo. Blocks that only got their state have no formats.
+//--------------------------------------------------------------------------------------------------
+void DataFileSyntaxHighlighter::formatBlockNow( const QTextBlock& block )
+{
+    if ( !block.isVisible() || !block.layout()->formats().isEmpty() )
+    {
+        return;
+    }
+
+    m_forceFormatting = true;
+    rehighlightBlock( block );
+    m_forceFormatting = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void DataFileSyntaxHighlighter::scheduleIdlePass( int fromBlockNumber )
+{
+    m_idleBlockNumber = std::min( m_idleBlockNumber, fromBlockNumber );
+    if ( !m_idleTimer->isActive() )
+    {
+        m_idlePassNs = 0;
+        m_idleTimer->start();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool DataFileSyntaxHighlighter::isFormattingEnabled( int blockNumber ) const
+{
+    return m_forceFormatting || ( blockNumber >= m_priorityFirstBlock && blockNumber <= m_priorityLastBlock );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Index of the section keyword starting this line, or -1 if the line does not start a section
+//--------------------------------------------------------------------------------------------------
+int DataFileSyntaxHighlighter::sectionIndexOfLine( const QString& text ) const
+{
+    int start = 0;
+    while ( start < text.size() && text[start].isSpace() )
+    {
+        ++start;
+    }
+
+    int end = start;
+    while ( end < text.size() && text[end].isLetter() )
+    {
+        ++end;
+    }
+
+    // Section keywords are 4 to 8 characters long, anything else can be rejected without a lookup
+    const int length = end - start;
+    if ( length < 4 || length > 8 || ( end < text.size() && !text[end].isSpace() && text[end] != '-' ) )
+    {
+        return -1;
+    }
+
+    QStringView word = QStringView( text ).mid( start, length );
+    for ( int i = 0; i < m_sectionKeywordList.size(); ++i )
+    {
+        if ( word.compare( m_sectionKeywordList[i], Qt::CaseInsensitive ) == 0 )
+        {
+            return i;
+        }
+    }
+
+    return -1;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -87,11 +259,47 @@ DataFileSyntaxHighlighter::DataFileSyntaxHighlighter( QTextDocument* parent )
 //--------------------------------------------------------------------------------------------------
 void DataFileSyntaxHighlighter::highlightBlock( const QString& text )
 {
+    // Carry the current section in the block state
+    int sectionIndex = previousBlockState();
+    int lineSection  = sectionIndexOfLine( text );
+    if ( lineSection >= 0 )
+    {
+        sectionIndex = lineSection;
+    }
+    setCurrentBlockState( sectionIndex );
+
+    // Folded blocks only carry the state, they are formatted again when unfolded
+    if ( !currentBlock().isVisible() )
+    {
+        return;
+    }
+
+    const int blockNumber = currentBlock().blockNumber();
+    if ( !isFormattingEnabled( blockNumber ) )
+    {
+        // State only, formatting is done when the block becomes visible or by the idle pass
+        scheduleIdlePass( blockNumber );
+        return;
+    }
+
+    for ( const QTextLayout::FormatRange& range : formatLine( text, sectionIndex ) )
+    {
+        setFormat( range.start, range.length, range.format );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Format ranges for one line, later ranges take precedence over earlier ones
+//--------------------------------------------------------------------------------------------------
+QVector<QTextLayout::FormatRange> DataFileSyntaxHighlighter::formatLine( const QString& text, int sectionIndex ) const
+{
+    QVector<QTextLayout::FormatRange> formats;
+
     // Check if line is a comment
     if ( text.trimmed().startsWith( "--" ) )
     {
-        setFormat( 0, text.length(), m_commentFormat );
-        return;
+        formats.append( { 0, static_cast<int>( text.length() ), m_commentFormat } );
+        return formats;
     }
 
     // Apply non-keyword rules first
@@ -101,7 +309,7 @@ void DataFileSyntaxHighlighter::highlightBlock( const QString& text )
         while ( matchIterator.hasNext() )
         {
             QRegularExpressionMatch match = matchIterator.next();
-            setFormat( match.capturedStart(), match.capturedLength(), rule.format );
+            formats.append( { static_cast<int>( match.capturedStart() ), static_cast<int>( match.capturedLength() ), rule.format } );
         }
     }
 
@@ -109,18 +317,20 @@ void DataFileSyntaxHighlighter::highlightBlock( const QString& text )
     if ( text.trimmed().startsWith( "INCLUDE" ) )
     {
         // Find the file path after INCLUDE keyword
-        QRegularExpression includeRegex( "^\\s*INCLUDE\\s+(['\"]?)([^'\"\\s]+)\\1" );
+        static QRegularExpression includeRegex( "^\\s*INCLUDE\\s+(['\"]?)([^'\"\\s]+)\\1" );
         QRegularExpressionMatch match = includeRegex.match( text );
         if ( match.hasMatch() )
         {
             int pathStart = match.capturedStart( 2 );
             int pathLength = match.capturedLength( 2 );
-            setFormat( pathStart, pathLength, m_includePathFormat );
+            formats.append( { pathStart, pathLength, m_includePathFormat } );
         }
     }
 
     // Apply keyword highlighting with context awareness
-    highlightKeywords( text );
+    highlightKeywords( text, sectionIndex, formats );
+
+    return formats;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -131,8 +341,8 @@ void DataFileSyntaxHighlighter::initializeKeywordSets()
     if ( m_keywordDatabase )
     {
         // Get section keywords
-        QStringList sections = m_keywordDatabase->getAllSections();
-        for ( const QString& section : sections )
+        m_sectionKeywordList = m_keywordDatabase->getAllSections();
+        for ( const QString& section : m_sectionKeywordList )
         {
             m_sectionKeywords.insert( section );
         }
@@ -149,7 +359,7 @@ void DataFileSyntaxHighlighter::initializeKeywordSets()
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void DataFileSyntaxHighlighter::highlightKeywords( const QString& text )
+void DataFileSyntaxHighlighter::highlightKeywords( const QString& text, int sectionIndex, QVector<QTextLayout::FormatRange>& formats ) const
 {
     // Find keywords at line start (after optional whitespace)
     static QRegularExpression keywordPattern( "^\\s*([A-Z][_A-Z0-9]*)\\b" );
@@ -171,7 +381,7 @@ void DataFileSyntaxHighlighter::highlightKeywords( const QString& text )
         else if ( m_validKeywords.contains( keyword ) )
         {
             // Check if keyword is valid in current context
-            QString currentSection = getCurrentSection( currentBlock().blockNumber() );
+            QString currentSection = sectionIndex >= 0 ? m_sectionKeywordList.value( sectionIndex ) : QString();
             if ( !currentSection.isEmpty() )
             {
                 KeywordInfo info = m_keywordDatabase->getKeywordInfo( keyword );
@@ -195,34 +405,6 @@ void DataFileSyntaxHighlighter::highlightKeywords( const QString& text )
             format = m_invalidKeywordFormat;
         }
 
-        setFormat( start, length, format );
+        formats.append( { start, length, format } );
     }
 }
-
-//--------------------------------------------------------------------------------------------------
-///
-//--------------------------------------------------------------------------------------------------
-QString DataFileSyntaxHighlighter::getCurrentSection( int blockNumber ) const
-{
-    // Search backwards from current block to find the last section keyword
-    QTextDocument* doc = document();
-    if ( !doc ) return QString();
-
-    for ( int i = blockNumber; i >= 0; --i )
-    {
-        QTextBlock block = doc->findBlockByNumber( i );
-        if ( block.isValid() )
-        {
-            QString blockText = block.text().trimmed();
-            for ( const QString& section : m_sectionKeywords )
-            {
-                if ( blockText.startsWith( section, Qt::CaseInsensitive ) )
-                {
-                    return section;
-                }
-            }
-        }
-    }
-
-    return QString();
-}
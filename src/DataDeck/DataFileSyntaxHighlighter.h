@@ -3,12 +3,21 @@
 #include <QRegularExpression>
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
+#include <QTextLayout>
 #include <QSet>
+#include <QStringList>
 
 class KeywordDatabase;
+class QTextBlock;
+class QTimer;
 
 //==================================================================================================
 /// Syntax highlighter for Eclipse DATA files with dynamic keyword support
+///
+/// Only blocks inside the priority range (the viewport and a margin set by the editor) are formatted
+/// synchronously. Other blocks only get their block state, which holds the index of the current
+/// section, and are formatted later by a time-sliced idle pass. Because the section is carried in the
+/// block state, re-highlighting after an edit stops at the first block whose end state is unchanged.
 //==================================================================================================
 class DataFileSyntaxHighlighter : public QSyntaxHighlighter
 {
@@ -17,9 +26,20 @@ class DataFileSyntaxHighlighter : public QSyntaxHighlighter
 public:
     explicit DataFileSyntaxHighlighter( QTextDocument* parent = nullptr );
 
+    void setPriorityRange( int firstBlockNumber, int lastBlockNumber );
+    bool isIdlePassComplete() const;
+
+    // Document independent formatting, also used by views that do not hold a QTextDocument
+    QVector<QTextLayout::FormatRange> formatLine( const QString& text, int sectionIndex ) const;
+    int                               sectionIndexOfLine( const QString& text ) const;
+
 protected:
     void highlightBlock( const QString& text ) override;
 
+private slots:
+    void highlightPriorityRange();
+    void runIdlePass();
+
 private:
     struct HighlightingRule
     {
@@ -28,14 +48,28 @@ private:
     };
 
     void initializeKeywordSets();
-    void highlightKeywords( const QString& text );
-    QString getCurrentSection( int blockNumber ) const;
+    void highlightKeywords( const QString& text, int sectionIndex, QVector<QTextLayout::FormatRange>& formats ) const;
+    bool isFormattingEnabled( int blockNumber ) const;
+    void formatBlockNow( const QTextBlock& block );
+    void scheduleIdlePass( int fromBlockNumber );
 
     QVector<HighlightingRule> m_rules;
     KeywordDatabase* m_keywordDatabase;
+    QStringList m_sectionKeywordList; // Block state is an index into this list, -1 before the first section
     QSet<QString> m_sectionKeywords;
     QSet<QString> m_validKeywords;
 
+    // Deferred highlighting
+    static constexpr int IDLE_SLICE_MS = 8;
+
+    int     m_priorityFirstBlock;
+    int     m_priorityLastBlock;
+    int     m_idleBlockNumber;
+    qint64  m_idlePassNs; // Work time of the idle pass so far, without the gaps between slices
+    bool    m_forceFormatting;
+    QTimer* m_priorityTimer;
+    QTimer* m_idleTimer;
+
     QTextCharFormat m_sectionKeywordFormat;
     QTextCharFormat m_keywordFormat;
     QTextCharFormat m_invalidKeywordFormat;
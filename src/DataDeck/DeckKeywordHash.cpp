@@ -0,0 +1,122 @@
+#include "DeckKeywordHash.h"
+
+#include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
+#include "opm/input/eclipse/Deck/DeckKeyword.hpp"
+#include "opm/input/eclipse/Deck/DeckRecord.hpp"
+#include "opm/input/eclipse/Deck/UDAValue.hpp"
+
+#include <QHash>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+static size_t combine( size_t seed, size_t value )
+{
+    return seed ^ ( value + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+static size_t vectorHash( const std::vector<T>& values, size_t seed )
+{
+    return qHashBits( values.data(), values.size() * sizeof( T ), seed );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Numeric data is hashed as raw memory, which is what makes hashing multi-million value arrays cheap
+//--------------------------------------------------------------------------------------------------
+static size_t itemHash( const Opm::DeckItem& item, size_t seed )
+{
+    seed = combine( seed, static_cast<size_t>( item.getType() ) );
+    seed = combine( seed, item.data_size() );
+
+    switch ( item.getType() )
+    {
+        case Opm::type_tag::integer:
+            seed = vectorHash( item.getData<int>(), seed );
+            break;
+        case Opm::type_tag::fdouble:
+            seed = vectorHash( item.getData<double>(), seed );
+            break;
+        case Opm::type_tag::string:
+            for ( const std::string& value : item.getData<std::string>() )
+            {
+                seed = qHashBits( value.data(), value.size(), seed );
+            }
+            break;
+        case Opm::type_tag::uda:
+            for ( const Opm::UDAValue& value : item.getData<Opm::UDAValue>() )
+            {
+                if ( value.is<double>() )
+                {
+                    double number = value.get<double>();
+                    seed          = qHashBits( &number, sizeof( number ), seed );
+                }
+                else
+                {
+                    const std::string& text = value.get<std::string>();
+                    seed                    = qHashBits( text.data(), text.size(), seed );
+                }
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Defaulted values hash differently from explicit values equal to the default
+    for ( size_t i = 0; i < item.data_size(); ++i )
+    {
+        if ( item.defaultApplied( i ) )
+        {
+            seed = combine( seed, i + 1 );
+        }
+    }
+
+    return seed;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t DeckKeywordHash::recordHash( const Opm::DeckRecord& record )
+{
+    size_t seed = record.size();
+    for ( size_t i = 0; i < record.size(); ++i )
+    {
+        seed = itemHash( record.getItem( i ), seed );
+    }
+    return seed;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+size_t DeckKeywordHash::keywordHash( const Opm::DeckKeyword& keyword )
+{
+    size_t seed = qHashBits( keyword.name().data(), keyword.name().size() );
+    seed        = combine( seed, keyword.size() );
+    for ( size_t i = 0; i < keyword.size(); ++i )
+    {
+        seed = combine( seed, recordHash( keyword.getRecord( i ) ) );
+    }
+    return seed;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<size_t> DeckKeywordHash::keywordHashes( const Opm::Deck& deck )
+{
+    std::vector<size_t> indices( deck.size() );
+    std::iota( indices.begin(), indices.end(), size_t( 0 ) );
+
+    return QtConcurrent::blockingMapped<std::vector<size_t>>( indices, [&deck]( size_t index ) { return keywordHash( deck[index] ); } );
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+class Deck;
+class DeckKeyword;
+class DeckRecord;
+} // namespace Opm
+
+//==================================================================================================
+/// Content hashes of parsed keywords and records, used to detect which parts of a deck changed
+/// between two parses. Values, value status (defaulted or not) and the keyword name are hashed, the
+/// location in the file is not.
+//==================================================================================================
+namespace DeckKeywordHash
+{
+size_t keywordHash( const Opm::DeckKeyword& keyword );
+size_t recordHash( const Opm::DeckRecord& record );
+
+// Hash of every keyword of the deck in order, computed in parallel
+std::vector<size_t> keywordHashes( const Opm::Deck& deck );
+} // namespace DeckKeywordHash
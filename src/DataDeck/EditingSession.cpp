@@ -0,0 +1,173 @@
+#include "EditingSession.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace
+{
+constexpr int SESSION_FORMAT_VERSION = 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QJsonObject EditingSessionEvent::toJson() const
+{
+    QJsonObject object;
+    object["type"]   = typeName( type );
+    object["timeMs"] = timeMs;
+
+    switch ( type )
+    {
+        case Type::KEY_PRESS:
+            object["key"]       = key;
+            object["modifiers"] = modifiers;
+            if ( !text.isEmpty() ) object["text"] = text;
+            break;
+        case Type::CURSOR_MOVE:
+            object["position"] = position;
+            break;
+        case Type::TREE_SELECTION:
+            object["keywordIndex"] = keywordIndex;
+            break;
+        default:
+            break;
+    }
+
+    return object;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString EditingSessionEvent::typeName( Type type )
+{
+    switch ( type )
+    {
+        case Type::KEY_PRESS:
+            return "keyPress";
+        case Type::CURSOR_MOVE:
+            return "cursorMove";
+        case Type::TREE_SELECTION:
+            return "treeSelection";
+        case Type::SYNC_TEXT_TO_TREE:
+            return "syncTextToTree";
+        case Type::SYNC_TREE_TO_TEXT:
+            return "syncTreeToText";
+    }
+    return QString();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool EditingSessionEvent::typeFromName( const QString& name, Type* type )
+{
+    for ( Type candidate :
+          { Type::KEY_PRESS, Type::CURSOR_MOVE, Type::TREE_SELECTION, Type::SYNC_TEXT_TO_TREE, Type::SYNC_TREE_TO_TEXT } )
+    {
+        if ( typeName( candidate ) == name )
+        {
+            *type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QJsonObject EditingSession::toJson() const
+{
+    QJsonArray eventArray;
+    for ( const EditingSessionEvent& event : events )
+    {
+        eventArray.append( event.toJson() );
+    }
+
+    QJsonObject object;
+    object["version"] = SESSION_FORMAT_VERSION;
+    object["deck"]    = deckFilePath;
+    object["events"]  = eventArray;
+    return object;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool EditingSession::save( const QString& filePath, QString* errorMessage ) const
+{
+    QFile file( filePath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        if ( errorMessage ) *errorMessage = QString( "Could not write %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    file.write( QJsonDocument( toJson() ).toJson( QJsonDocument::Indented ) );
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool EditingSession::fromJson( const QJsonObject& json, EditingSession* session, QString* errorMessage )
+{
+    const int version = json["version"].toInt();
+    if ( version != SESSION_FORMAT_VERSION )
+    {
+        if ( errorMessage ) *errorMessage = QString( "Unsupported session format version %1" ).arg( version );
+        return false;
+    }
+
+    EditingSession result;
+    result.deckFilePath = json["deck"].toString();
+
+    const QJsonArray eventArray = json["events"].toArray();
+    for ( const QJsonValue& value : eventArray )
+    {
+        const QJsonObject   object = value.toObject();
+        EditingSessionEvent event;
+        if ( !EditingSessionEvent::typeFromName( object["type"].toString(), &event.type ) )
+        {
+            if ( errorMessage ) *errorMessage = QString( "Unknown event type '%1'" ).arg( object["type"].toString() );
+            return false;
+        }
+
+        event.timeMs       = object["timeMs"].toInteger();
+        event.key          = object["key"].toInt();
+        event.modifiers    = object["modifiers"].toInt();
+        event.text         = object["text"].toString();
+        event.position     = object["position"].toInt( -1 );
+        event.keywordIndex = object["keywordIndex"].toInt( -1 );
+        result.events.append( event );
+    }
+
+    *session = result;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool EditingSession::load( const QString& filePath, EditingSession* session, QString* errorMessage )
+{
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        if ( errorMessage ) *errorMessage = QString( "Could not read %1: %2" ).arg( filePath ).arg( file.errorString() );
+        return false;
+    }
+
+    QJsonParseError     parseError;
+    const QJsonDocument document = QJsonDocument::fromJson( file.readAll(), &parseError );
+    if ( parseError.error != QJsonParseError::NoError || !document.isObject() )
+    {
+        if ( errorMessage ) *errorMessage = QString( "Invalid session file %1: %2" ).arg( filePath ).arg( parseError.errorString() );
+        return false;
+    }
+
+    return fromJson( document.object(), session, errorMessage );
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+//==================================================================================================
+/// One user action in a recorded editing session
+//==================================================================================================
+struct EditingSessionEvent
+{
+    enum class Type
+    {
+        KEY_PRESS,
+        CURSOR_MOVE, // Cursor moves not caused by a key, like mouse clicks in the text
+        TREE_SELECTION,
+        SYNC_TEXT_TO_TREE,
+        SYNC_TREE_TO_TEXT
+    };
+
+    Type   type   = Type::KEY_PRESS;
+    qint64 timeMs = 0; // Since the recording started
+
+    // KEY_PRESS
+    int     key       = 0;
+    int     modifiers = 0;
+    QString text;
+
+    // CURSOR_MOVE, character position in the document
+    int position = -1;
+
+    // TREE_SELECTION, index in RimDataDeck::keywordsInDeckOrder(), -1 selects the deck itself
+    int keywordIndex = -1;
+
+    QJsonObject toJson() const;
+
+    static QString typeName( Type type );
+    static bool    typeFromName( const QString& name, Type* type );
+};
+
+//==================================================================================================
+/// A recorded editing session, saved as JSON and replayed by the session replayer to measure the
+/// latency of each event
+//==================================================================================================
+class EditingSession
+{
+public:
+    QString                    deckFilePath;
+    QList<EditingSessionEvent> events;
+
+    QJsonObject toJson() const;
+    bool        save( const QString& filePath, QString* errorMessage ) const;
+
+    static bool fromJson( const QJsonObject& json, EditingSession* session, QString* errorMessage );
+    static bool load( const QString& filePath, EditingSession* session, QString* errorMessage );
+};
@@ -0,0 +1,206 @@
+#include "EditingSessionRecorder.h"
+
+#include "DataFileCompleter.h"
+#include "RimDataDeck.h"
+#include "RimDataDeckTextEditor.h"
+#include "RimDataKeyword.h"
+
+#include <QAbstractItemView>
+#include <QCoreApplication>
+#include <QKeyEvent>
+
+#include <algorithm>
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+EditingSessionRecorder::EditingSessionRecorder( QObject* parent )
+    : QObject( parent )
+    , m_isKeyDown( false )
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+EditingSessionRecorder::~EditingSessionRecorder()
+{
+    if ( isRecording() )
+    {
+        stop();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void EditingSessionRecorder::start( RimDataDeckTextEditor* textEditor, RimDataDeck* dataDeck )
+{
+    if ( isRecording() )
+    {
+        stop();
+    }
+
+    m_textEditor           = textEditor;
+    m_dataDeck             = dataDeck;
+    m_session              = EditingSession();
+    m_session.deckFilePath = dataDeck ? dataDeck->filePath() : QString();
+    m_isKeyDown            = false;
+
+    qApp->installEventFilter( this );
+    connect( m_textEditor, &QPlainTextEdit::cursorPositionChanged, this, &EditingSessionRecorder::onCursorPositionChanged );
+
+    m_timer.start();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+EditingSession EditingSessionRecorder::stop()
+{
+    qApp->removeEventFilter( this );
+    if ( m_textEditor )
+    {
+        disconnect( m_textEditor, nullptr, this, nullptr );
+    }
+
+    m_textEditor = nullptr;
+    m_dataDeck   = nullptr;
+    m_timer.invalidate();
+
+    EditingSession session = m_session;
+    m_session              = EditingSession();
+    return session;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool EditingSessionRecorder::isRecording() const
+{
+    return m_timer.isValid();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Record a selection made in the project tree. Only the recorded deck and its keywords are replayed.
+//--------------------------------------------------------------------------------------------------
+void EditingSessionRecorder::recordTreeSelection( caf::PdmObjectHandle* object )
+{
+    if ( !isRecording() || !m_dataDeck || !object )
+    {
+        return;
+    }
+
+    EditingSessionEvent event;
+    event.type = EditingSessionEvent::Type::TREE_SELECTION;
+
+    if ( object == m_dataDeck.p() )
+    {
+        event.keywordIndex = -1;
+    }
+    else if ( RimDataKeyword* keyword = dynamic_cast<RimDataKeyword*>( object ) )
+    {
+        RimDataDeck* dataDeck = nullptr;
+        keyword->firstAncestorOrThisOfType( dataDeck );
+        if ( dataDeck != m_dataDeck.p() )
+        {
+            return;
+        }
+
+        const std::vector<RimDataKeyword*> keywords = dataDeck->keywordsInDeckOrder();
+        auto                               it       = std::find( keywords.begin(), keywords.end(), keyword );
+        if ( it == keywords.end() )
+        {
+            return;
+        }
+        event.keywordIndex = static_cast<int>( it - keywords.begin() );
+    }
+    else
+    {
+        return;
+    }
+
+    append( event );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void EditingSessionRecorder::recordSync( EditingSessionEvent::Type type )
+{
+    if ( !isRecording() )
+    {
+        return;
+    }
+
+    EditingSessionEvent event;
+    event.type = type;
+    append( event );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Key presses go to the editor, or to the completer popup while it is visible. The popup forwards
+/// the keys it does not use to the editor, these are only recorded once.
+//--------------------------------------------------------------------------------------------------
+bool EditingSessionRecorder::eventFilter( QObject* watched, QEvent* event )
+{
+    if ( !m_textEditor || ( event->type() != QEvent::KeyPress && event->type() != QEvent::KeyRelease ) )
+    {
+        return QObject::eventFilter( watched, event );
+    }
+
+    QAbstractItemView* popup        = m_textEditor->completer() ? m_textEditor->completer()->popup() : nullptr;
+    const bool         popupVisible = popup && popup->isVisible();
+    const bool         isEditorKey  = popupVisible ? watched == popup : watched == m_textEditor.data();
+    if ( !isEditorKey )
+    {
+        return QObject::eventFilter( watched, event );
+    }
+
+    QKeyEvent* keyEvent = static_cast<QKeyEvent*>( event );
+    if ( event->type() == QEvent::KeyRelease )
+    {
+        if ( !keyEvent->isAutoRepeat() )
+        {
+            m_isKeyDown = false;
+        }
+        return QObject::eventFilter( watched, event );
+    }
+
+    m_isKeyDown = true;
+
+    EditingSessionEvent sessionEvent;
+    sessionEvent.type      = EditingSessionEvent::Type::KEY_PRESS;
+    sessionEvent.key       = keyEvent->key();
+    sessionEvent.modifiers = static_cast<int>( keyEvent->modifiers() );
+    sessionEvent.text      = keyEvent->text();
+    append( sessionEvent );
+
+    return QObject::eventFilter( watched, event );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Record cursor moves from the mouse. Moves while a key is down are replayed by the key, and moves
+/// while the editor does not have focus come from the tree or the problems panel.
+//--------------------------------------------------------------------------------------------------
+void EditingSessionRecorder::onCursorPositionChanged()
+{
+    if ( !m_textEditor || m_isKeyDown || !m_textEditor->hasFocus() )
+    {
+        return;
+    }
+
+    EditingSessionEvent event;
+    event.type     = EditingSessionEvent::Type::CURSOR_MOVE;
+    event.position = m_textEditor->textCursor().position();
+    append( event );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void EditingSessionRecorder::append( EditingSessionEvent event )
+{
+    event.timeMs = m_timer.elapsed();
+    m_session.events.append( event );
+}
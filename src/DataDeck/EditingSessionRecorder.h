@@ -0,0 +1,56 @@
+#pragma once
+
+#include "EditingSession.h"
+
+#include "cafPdmPointer.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+
+class RimDataDeck;
+class RimDataDeckTextEditor;
+
+namespace caf
+{
+class PdmObjectHandle;
+}
+
+//==================================================================================================
+/// Records the key presses, cursor moves, tree selections and sync actions of an editing session in
+/// the text editor, for replay by the session replayer.
+///
+/// Key presses are picked up by an application event filter, so keys handled by the completer popup
+/// are recorded as well. Tree selections and sync actions are reported by the main window.
+//==================================================================================================
+class EditingSessionRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EditingSessionRecorder( QObject* parent = nullptr );
+    ~EditingSessionRecorder() override;
+
+    void           start( RimDataDeckTextEditor* textEditor, RimDataDeck* dataDeck );
+    EditingSession stop();
+    bool           isRecording() const;
+
+    void recordTreeSelection( caf::PdmObjectHandle* object );
+    void recordSync( EditingSessionEvent::Type type );
+
+protected:
+    bool eventFilter( QObject* watched, QEvent* event ) override;
+
+private slots:
+    void onCursorPositionChanged();
+
+private:
+    void append( EditingSessionEvent event );
+
+private:
+    QPointer<RimDataDeckTextEditor> m_textEditor;
+    caf::PdmPointer<RimDataDeck>    m_dataDeck;
+    EditingSession                  m_session;
+    QElapsedTimer                   m_timer;
+    bool                            m_isKeyDown;
+};
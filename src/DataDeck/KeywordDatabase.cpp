@@ -1,13 +1,15 @@
 #include "KeywordDatabase.h"
 
-#include <QApplication>
+#include "DataDeckLogging.h"
+#include "DataDeckTrace.h"
+
+#include <QCoreApplication>
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QDebug>
 
 KeywordDatabase* KeywordDatabase::s_instance = nullptr;
 
@@ -40,22 +42,24 @@ KeywordDatabase* KeywordDatabase::instance()
 //--------------------------------------------------------------------------------------------------
 void KeywordDatabase::loadKeywords()
 {
+    DATADECK_TRACE_SCOPE( "keywords", "KeywordDatabase::loadKeywords" );
+
     QString keywordsDir = findKeywordsDirectory();
     if (keywordsDir.isEmpty())
     {
-        qWarning() << "Could not find keywords directory, using fallback keywords";
+        qCWarning( logKeywords ) << "Could not find keywords directory, using fallback keywords";
         loadFallbackKeywords();
         return;
     }
     
-    qDebug() << "Loading keywords from:" << keywordsDir;
+    qCDebug( logKeywords ) << "Loading keywords from:" << keywordsDir;
     loadKeywordsFromDirectory(keywordsDir);
-    qDebug() << "Loaded" << m_keywords.size() << "keywords";
+    qCDebug( logKeywords ) << "Loaded" << m_keywords.size() << "keywords";
     
     // If no keywords loaded, use fallback
     if (m_keywords.isEmpty())
     {
-        qWarning() << "No keywords loaded from JSON files, using fallback keywords";
+        qCWarning( logKeywords ) << "No keywords loaded from JSON files, using fallback keywords";
         loadFallbackKeywords();
     }
 }
@@ -68,7 +72,7 @@ QString KeywordDatabase::findKeywordsDirectory() const
     // Try to find the keywords directory relative to application
     QStringList searchPaths;
     
-    QString appDir = QApplication::applicationDirPath();
+    QString appDir = QCoreApplication::applicationDirPath();
     
     // New search path for installed keywords
     searchPaths << appDir + "/../share/keywords";
@@ -89,22 +93,22 @@ QString KeywordDatabase::findKeywordsDirectory() const
     QString rootPath = workingDir.absolutePath() + "/external/ResInsight/ThirdParty/custom-opm-common/opm-common/opm/input/eclipse/share/keywords";
     searchPaths << rootPath;
     
-    qDebug() << "Searching for keywords directory...";
-    qDebug() << "Application directory:" << appDir;
-    qDebug() << "Current working directory:" << QDir::current().absolutePath();
+    qCDebug( logKeywords ) << "Searching for keywords directory...";
+    qCDebug( logKeywords ) << "Application directory:" << appDir;
+    qCDebug( logKeywords ) << "Current working directory:" << QDir::current().absolutePath();
     
     for (const QString& path : searchPaths)
     {
         QDir dir(path);
-        qDebug() << "Checking path:" << dir.absolutePath();
+        qCDebug( logKeywords ) << "Checking path:" << dir.absolutePath();
         if (dir.exists() && dir.exists("000_Eclipse100"))
         {
-            qDebug() << "Found keywords directory at:" << dir.absolutePath();
+            qCDebug( logKeywords ) << "Found keywords directory at:" << dir.absolutePath();
             return dir.absolutePath();
         }
     }
     
-    qWarning() << "Keywords directory not found in any of the search paths";
+    qCWarning( logKeywords ) << "Keywords directory not found in any of the search paths";
     return QString();
 }
 
@@ -276,7 +280,7 @@ void KeywordDatabase::loadFallbackKeywords()
     
     // Note: Detailed parameter information is now extracted from JSON files
     
-    qDebug() << "Loaded" << m_keywords.size() << "fallback keywords";
+    qCDebug( logKeywords ) << "Loaded" << m_keywords.size() << "fallback keywords";
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -284,13 +288,15 @@ void KeywordDatabase::loadFallbackKeywords()
 //--------------------------------------------------------------------------------------------------
 void KeywordDatabase::loadKeywordsFromDirectory(const QString& directory)
 {
+    DATADECK_TRACE_SCOPE_DETAIL( "keywords", "KeywordDatabase::loadKeywordsFromDirectory", directory );
+
     // Load from Eclipse100 directory (main keywords)
     QString eclipse100Dir = directory + "/000_Eclipse100";
     QDir dir(eclipse100Dir);
     
     if (!dir.exists())
     {
-        qWarning() << "Eclipse100 directory not found:" << eclipse100Dir;
+        qCWarning( logKeywords ) << "Eclipse100 directory not found:" << eclipse100Dir;
         return;
     }
     
@@ -324,7 +330,7 @@ void KeywordDatabase::loadKeywordsFromDirectory(const QString& directory)
                 }
                 else
                 {
-                    qDebug() << "Failed to parse JSON for keyword" << keywordName << ":" << error.errorString();
+                    qCDebug( logKeywords ) << "Failed to parse JSON for keyword" << keywordName << ":" << error.errorString();
                 }
             }
         }
@@ -386,6 +392,9 @@ KeywordInfo KeywordDatabase::parseKeywordJson(const QJsonObject& json, const QSt
                 // Create a meaningful description
                 QString paramDesc = createParameterDescription(name, type, dimension, defaultVal);
                 info.parameterDescriptions << paramDesc;
+                
+                // Keep the default, used when validating defaulted items
+                info.parameterDefaults << (defaultVal.isUndefined() || defaultVal.isNull() ? QString() : defaultVal.toVariant().toString());
             }
         }
     }
@@ -19,8 +19,9 @@ struct KeywordInfo
     QStringList parameterNames;
     QStringList parameterTypes;
     QStringList parameterDescriptions;
+    QStringList parameterDefaults; // Empty string when the item has no default
     bool hasSize = false;
-    QString sizeKeyword;
+    QString sizeKeyword;    // Record count taken from an item of this keyword, e.g. TABDIMS
     
     bool isValidInSection(const QString& section) const {
         return validSections.isEmpty() || validSections.contains(section, Qt::CaseInsensitive);
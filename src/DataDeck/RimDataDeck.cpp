@@ -1,4 +1,11 @@
 #include "RimDataDeck.h"
+#include "DataDeckDiff.h"
+#include "DataDeckFileScan.h"
+#include "DataDeckLogging.h"
+#include "DataDeckMetrics.h"
+#include "DataDeckTrace.h"
+#include "DeckKeywordHash.h"
+#include "RimDataDeckTextEditor.h"
 #include "RimDataSection.h"
 #include "RimDataKeyword.h"
 #include "RimDataItem.h"
@@ -6,20 +13,27 @@
 #include "RimIncludeKeyword.h"
 
 #include "cafPdmUiOrdering.h"
+#include "cafPdmUiTextEditor.h"
 #include "cafPdmUiTreeOrdering.h"
 
+#include "opm/common/OpmLog/KeywordLocation.hpp"
 #include "opm/input/eclipse/Deck/Deck.hpp"
+#include "opm/input/eclipse/Deck/DeckItem.hpp"
 #include "opm/input/eclipse/Deck/DeckKeyword.hpp"
 #include "opm/input/eclipse/Deck/DeckRecord.hpp"
 #include "opm/input/eclipse/Parser/Parser.hpp"
 #include "opm/input/eclipse/Parser/ParseContext.hpp"
 #include "opm/input/eclipse/Parser/InputErrorAction.hpp"
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QFont>
 #include <QFile>
 #include <QTextStream>
-#include <QDebug>
-#include <QRegularExpression>
+#include <QHash>
+#include <algorithm>
 #include <stdexcept>
 
 CAF_PDM_SOURCE_INIT( RimDataDeck, "DataDeck" );
@@ -28,23 +42,44 @@ CAF_PDM_SOURCE_INIT( RimDataDeck, "DataDeck" );
 ///
 //--------------------------------------------------------------------------------------------------
 RimDataDeck::RimDataDeck()
+    : m_parseTimeNs( -1 )
 {
     CAF_PDM_InitObject( "DATA File", "", "", "" );
 
     CAF_PDM_InitField( &m_filePath, "FilePath", QString( "" ), "File Path", "", "", "" );
     m_filePath.uiCapability()->setUiReadOnly( true );
 
+    CAF_PDM_InitField( &m_cacheKey, "CacheKey", QString( "" ), "Cache Key", "", "", "" );
+    m_cacheKey.uiCapability()->setUiHidden( true );
+
+    // Everything below is derived from the deck and rebuilt on open, the project file holds references only
+
     CAF_PDM_InitField( &m_fileName, "FileName", QString( "" ), "File Name", "", "", "" );
     m_fileName.uiCapability()->setUiReadOnly( true );
+    m_fileName.xmlCapability()->disableIO();
 
     CAF_PDM_InitField( &m_keywordCount, "KeywordCount", 0, "Total Keywords", "", "", "" );
     m_keywordCount.uiCapability()->setUiReadOnly( true );
+    m_keywordCount.xmlCapability()->disableIO();
 
     CAF_PDM_InitField( &m_basePath, "BasePath", QString( "" ), "Base Path", "", "", "" );
     m_basePath.uiCapability()->setUiHidden( true );
+    m_basePath.xmlCapability()->disableIO();
+
+    CAF_PDM_InitField( &m_comparison, "Comparison", QString( "" ), "Comparison", "", "", "" );
+    m_comparison.uiCapability()->setUiReadOnly( true );
+    m_comparison.xmlCapability()->disableIO();
+
+    CAF_PDM_InitFieldNoDefault( &m_memoryUsage, "MemoryUsage", "Estimated Memory", "", "", "" );
+    m_memoryUsage.uiCapability()->setUiReadOnly( true );
+    m_memoryUsage.uiCapability()->setUiEditorTypeName( caf::PdmUiTextEditor::uiEditorTypeName() );
+    m_memoryUsage.xmlCapability()->disableIO();
 
     CAF_PDM_InitFieldNoDefault( &m_sections, "Sections", "Sections", "", "", "" );
+    m_sections.xmlCapability()->disableIO();
+
     CAF_PDM_InitFieldNoDefault( &m_includeFiles, "IncludeFiles", "Include Files", "", "", "" );
+    m_includeFiles.xmlCapability()->disableIO();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -61,20 +96,21 @@ RimDataDeck::~RimDataDeck()
 //--------------------------------------------------------------------------------------------------
 bool RimDataDeck::loadFromFile( const QString& filePath )
 {
+    DATADECK_TRACE_SCOPE_DETAIL( "deck", "RimDataDeck::loadFromFile", filePath );
+
     try
     {
-        // Create parser with default configuration
-        Opm::Parser parser;
+        QElapsedTimer parseTimer;
+        parseTimer.start();
 
-        // Set up parse context to handle errors gracefully
-        Opm::ParseContext parseContext;
-        parseContext.update( Opm::InputErrorAction::WARN );
+        auto deck = parseDeckFile( filePath );
 
-        // Parse the file
-        auto deck = std::make_shared<Opm::Deck>( parser.parseFile( filePath.toStdString(), parseContext ) );
+        const qint64 parseTimeNs = parseTimer.nsecsElapsed();
 
         // Store deck and build UI structure
         setDeck( deck, filePath );
+        m_parseTimeNs = parseTimeNs;
+        DataDeckMetrics::recordParse( parseTimeNs );
 
         return true;
     }
@@ -85,13 +121,36 @@ bool RimDataDeck::loadFromFile( const QString& filePath )
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Parse a DATA file with the error handling used throughout the editor. Throws on parse failure.
+//--------------------------------------------------------------------------------------------------
+std::shared_ptr<Opm::Deck> RimDataDeck::parseDeckFile( const QString& filePath )
+{
+    DATADECK_TRACE_SCOPE_DETAIL( "deck", "RimDataDeck::parseDeckFile", filePath );
+
+    // Create parser with default configuration
+    Opm::Parser parser;
+
+    // Set up parse context to handle errors gracefully
+    Opm::ParseContext parseContext;
+    parseContext.update( Opm::InputErrorAction::WARN );
+
+    return std::make_shared<Opm::Deck>( parser.parseFile( filePath.toStdString(), parseContext ) );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void RimDataDeck::setDeck( std::shared_ptr<Opm::Deck> deck, const QString& filePath )
+void RimDataDeck::setDeck( std::shared_ptr<Opm::Deck>                        deck,
+                           const QString&                                    filePath,
+                           const QMap<QString, std::shared_ptr<Opm::Deck>>& includeDecks,
+                           const QMap<QString, DataDeckFileScan>&            fileScans )
 {
+    DATADECK_TRACE_SCOPE_DETAIL( "deck", "RimDataDeck::setDeck", filePath );
+
     m_deck = deck;
     m_filePath = filePath;
+    m_parseTimeNs = -1;
 
     QFileInfo fileInfo( filePath );
     m_fileName = fileInfo.fileName();
@@ -110,10 +169,14 @@ void RimDataDeck::setDeck( std::shared_ptr<Opm::Deck> deck, const QString& fileP
     setUiName( m_fileName );
 
     // Build section structure
-    buildSectionsFromDeck();
+    auto fileScan = fileScans.constFind( filePath );
+    buildSectionsFromDeck( fileScan != fileScans.constEnd() ? &fileScan.value() : nullptr );
     
     // Resolve include file references by parsing the raw file
-    resolveIncludesFromRawFile();
+    resolveIncludesFromRawFile( includeDecks, fileScans );
+
+    updateCacheKey();
+    refreshMemoryUsage();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -124,6 +187,70 @@ QString RimDataDeck::filePath() const
     return m_filePath;
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Computed when the deck is set. After a project is read it holds the key saved with the project
+/// until the deck is loaded again.
+//--------------------------------------------------------------------------------------------------
+QString RimDataDeck::cacheKey() const
+{
+    return m_cacheKey;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Size and modification time of the deck file and every include file it reaches. Reading the file
+/// contents would cost as much as parsing them.
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::updateCacheKey()
+{
+    QStringList sourceFiles;
+    collectSourceFiles( sourceFiles );
+
+    QCryptographicHash hash( QCryptographicHash::Sha1 );
+    for ( const QString& sourceFile : sourceFiles )
+    {
+        QFileInfo info( sourceFile );
+        hash.addData( QString( "%1|%2|%3\n" )
+                          .arg( info.absoluteFilePath() )
+                          .arg( info.exists() ? info.size() : -1 )
+                          .arg( info.lastModified().toMSecsSinceEpoch() )
+                          .toUtf8() );
+    }
+
+    m_cacheKey = QString::fromLatin1( hash.result().toHex() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::collectSourceFiles( QStringList& filePaths ) const
+{
+    filePaths.append( m_filePath );
+
+    for ( const RimIncludeFile* includeFile : m_includeFiles )
+    {
+        if ( includeFile->content() )
+        {
+            includeFile->content()->collectSourceFiles( filePaths );
+        }
+        else
+        {
+            filePaths.append( includeFile->resolvedPath() );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Only the references are read, the derived fields follow the file path until the deck is loaded
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::initAfterRead()
+{
+    QFileInfo fileInfo( m_filePath );
+    m_fileName = fileInfo.fileName();
+    m_basePath = fileInfo.absolutePath();
+
+    setUiName( m_fileName );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -140,6 +267,173 @@ std::shared_ptr<Opm::Deck> RimDataDeck::deck() const
     return m_deck;
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Walks the deck and the tree, so it is computed on demand and not kept up to date. The properties
+/// show the value from the last refreshMemoryUsage().
+//--------------------------------------------------------------------------------------------------
+DataDeckMemoryUsage RimDataDeck::memoryUsage() const
+{
+    DATADECK_TRACE_SCOPE( "deck", "RimDataDeck::memoryUsage" );
+
+    // Node of the std::map behind QMap: tree links and color, key and value
+    constexpr qint64 positionNodeBytes = 32 + sizeof( size_t ) + sizeof( QPair<int, int> );
+
+    DataDeckMemoryUsage usage;
+
+    if ( m_deck )
+    {
+        usage.parsedDeckBytes = DataDeckMemoryUsage::deckBytes( *m_deck );
+    }
+
+    usage.pdmObjectBytes = sizeof( RimDataDeck ) + DataDeckMemoryUsage::pdmOverheadBytes( *this );
+    for ( const RimDataSection* section : m_sections )
+    {
+        usage.pdmObjectBytes += section->estimatedMemoryBytes();
+    }
+
+    if ( m_textEditor && m_textEditor->dataDeck() == this )
+    {
+        usage.editorDocumentBytes = m_textEditor->documentMemoryBytes();
+    }
+
+    for ( const RimIncludeFile* includeFile : m_includeFiles )
+    {
+        usage.includeDeckBytes += sizeof( RimIncludeFile ) + DataDeckMemoryUsage::pdmOverheadBytes( *includeFile );
+        if ( includeFile->content() )
+        {
+            usage.includeDeckBytes += includeFile->content()->memoryUsage().totalBytes();
+        }
+    }
+
+    usage.cacheBytes = static_cast<qint64>( m_keywordHashes.capacity() * sizeof( size_t ) ) +
+                       static_cast<qint64>( m_keywordPositions.size() ) * positionNodeBytes +
+                       static_cast<qint64>( m_keywordProfiles.capacity() * sizeof( KeywordProfile ) );
+
+    return usage;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::setTextEditor( RimDataDeckTextEditor* textEditor )
+{
+    m_textEditor = textEditor;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::refreshMemoryUsage()
+{
+    m_memoryUsage = memoryUsage().toText();
+    m_memoryUsage.uiCapability()->updateConnectedEditors();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The keywords of this deck, then the include files. opm-common inlines the included keywords in
+/// the deck, so the keywords of the include decks are already listed.
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProfileEntry> RimDataDeck::profile() const
+{
+    QList<DataDeckProfileEntry> entries;
+    if ( !m_deck || m_keywordProfiles.size() != m_deck->size() )
+    {
+        return entries;
+    }
+
+    qint64 totalBytes = 0;
+    for ( const KeywordProfile& keywordProfile : m_keywordProfiles )
+    {
+        totalBytes += std::max<qint64>( keywordProfile.bytes, 0 );
+    }
+
+    for ( size_t i = 0; i < m_keywordProfiles.size(); ++i )
+    {
+        const KeywordProfile& keywordProfile = m_keywordProfiles[i];
+
+        DataDeckProfileEntry entry;
+        entry.name        = QString::fromStdString( ( *m_deck )[i].name() );
+        entry.filePath    = QString::fromStdString( ( *m_deck )[i].location().filename );
+        entry.line        = m_keywordPositions.contains( i ) ? m_keywordPositions[i].first : -1;
+        entry.bytes       = keywordProfile.bytes;
+        entry.recordCount = keywordProfile.recordCount;
+        entry.valueCount  = keywordProfile.valueCount;
+        entry.buildTimeNs = keywordProfile.buildTimeNs;
+        if ( m_parseTimeNs >= 0 && totalBytes > 0 && keywordProfile.bytes >= 0 )
+        {
+            entry.parseTimeNs = static_cast<qint64>( static_cast<double>( m_parseTimeNs ) * keywordProfile.bytes / totalBytes );
+        }
+        entries.append( entry );
+    }
+
+    entries.append( includeProfile() );
+
+    return entries;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The include files of this deck and, after each, the files it includes
+//--------------------------------------------------------------------------------------------------
+QList<DataDeckProfileEntry> RimDataDeck::includeProfile() const
+{
+    QList<DataDeckProfileEntry> entries;
+
+    for ( const RimIncludeFile* includeFile : m_includeFiles )
+    {
+        DataDeckProfileEntry entry;
+        entry.type     = DataDeckProfileEntry::Type::INCLUDE_FILE;
+        entry.name     = includeFile->includePath();
+        entry.filePath = includeFile->resolvedPath();
+        entry.bytes    = includeFile->fileSize();
+
+        const RimDataDeck* content = includeFile->content();
+        if ( content )
+        {
+            entry.parseTimeNs = content->parseTimeNs();
+            entry.buildTimeNs = 0;
+            for ( const KeywordProfile& keywordProfile : content->m_keywordProfiles )
+            {
+                entry.recordCount += keywordProfile.recordCount;
+                entry.valueCount += keywordProfile.valueCount;
+                entry.buildTimeNs += std::max<qint64>( keywordProfile.buildTimeNs, 0 );
+            }
+        }
+        entries.append( entry );
+
+        if ( content )
+        {
+            entries.append( content->includeProfile() );
+        }
+    }
+
+    return entries;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The include decks are keyed by resolved path, as in DataDeckLoadResult
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::setParseTimes( qint64 parseTimeNs, const QMap<QString, qint64>& includeParseTimesNs )
+{
+    m_parseTimeNs = parseTimeNs;
+
+    for ( RimIncludeFile* includeFile : m_includeFiles )
+    {
+        RimDataDeck* content = includeFile->content();
+        if ( content && includeParseTimesNs.contains( includeFile->resolvedPath() ) )
+        {
+            content->setParseTimes( includeParseTimesNs.value( includeFile->resolvedPath() ), includeParseTimesNs );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// -1 if the parse was not timed
+//--------------------------------------------------------------------------------------------------
+qint64 RimDataDeck::parseTimeNs() const
+{
+    return m_parseTimeNs;
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -148,6 +442,11 @@ void RimDataDeck::defineUiOrdering( QString uiConfigName, caf::PdmUiOrdering& ui
     uiOrdering.add( &m_fileName );
     uiOrdering.add( &m_filePath );
     uiOrdering.add( &m_keywordCount );
+
+    if ( !m_comparison().isEmpty() )
+    {
+        uiOrdering.add( &m_comparison );
+    }
     
     // Add include files section if there are any
     if ( !m_includeFiles.empty() )
@@ -156,6 +455,9 @@ void RimDataDeck::defineUiOrdering( QString uiConfigName, caf::PdmUiOrdering& ui
         includeGroup->add( &m_includeFiles );
     }
 
+    caf::PdmUiGroup* memoryGroup = uiOrdering.addNewGroup( "Memory" );
+    memoryGroup->add( &m_memoryUsage );
+
     uiOrdering.skipRemainingFields( true );
 }
 
@@ -176,9 +478,35 @@ void RimDataDeck::defineUiTreeOrdering( caf::PdmUiTreeOrdering& uiTreeOrdering,
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void RimDataDeck::buildSectionsFromDeck()
+void RimDataDeck::defineEditorAttribute( const caf::PdmFieldHandle* field, QString uiConfigName, caf::PdmUiEditorAttribute* attribute )
+{
+    if ( field == &m_memoryUsage )
+    {
+        auto* textEditAttr = dynamic_cast<caf::PdmUiTextEditorAttribute*>( attribute );
+        if ( textEditAttr )
+        {
+            textEditAttr->textMode   = caf::PdmUiTextEditorAttribute::PLAIN;
+            textEditAttr->wrapMode   = caf::PdmUiTextEditorAttribute::NoWrap;
+            textEditAttr->heightHint = 110;
+
+            // Monospace keeps the numbers aligned
+            QFont font( "Courier" );
+            font.setStyleHint( QFont::Monospace );
+            textEditAttr->font = font;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::buildSectionsFromDeck( const DataDeckFileScan* fileScan )
 {
+    DATADECK_TRACE_SCOPE( "deck", "RimDataDeck::buildSectionsFromDeck" );
+
     m_sections.deleteChildren();
+    m_keywordHashes.clear();
+    m_comparison = "";
 
     if ( !m_deck )
     {
@@ -186,15 +514,19 @@ void RimDataDeck::buildSectionsFromDeck()
     }
 
     // First pass: calculate line positions for each keyword
-    calculateTextPositions();
+    calculateTextPositions( fileScan );
 
     // Create sections for organizing keywords
     RimDataSection* currentSection = nullptr;
     RimDataSection::SectionType currentSectionType = RimDataSection::SectionType::OTHER;
 
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+
     for ( size_t i = 0; i < m_deck->size(); ++i )
     {
         const Opm::DeckKeyword& keyword = (*m_deck)[i];
+        const qint64 buildStartNs = buildTimer.nsecsElapsed();
         QString keywordName = QString::fromStdString( keyword.name() );
 
         // Check if this is a section keyword
@@ -211,6 +543,7 @@ void RimDataDeck::buildSectionsFromDeck()
             // Create a keyword object for the section delimiter itself
             RimDataKeyword* sectionKeyword = new RimDataKeyword();
             sectionKeyword->setDeckKeyword( &keyword );
+            m_keywordProfiles[i].buildTimeNs = buildTimer.nsecsElapsed() - buildStartNs;
             
             // Set text position from our calculated positions
             if ( m_keywordPositions.contains( i ) )
@@ -237,7 +570,7 @@ void RimDataDeck::buildSectionsFromDeck()
             RimDataKeyword* dataKeyword = nullptr;
             if ( keywordName == "INCLUDE" )
             {
-                qDebug() << "Creating RimIncludeKeyword for INCLUDE at index" << i;
+                qCDebug( logDeck ) << "Creating RimIncludeKeyword for INCLUDE at index" << i;
                 dataKeyword = new RimIncludeKeyword();
             }
             else
@@ -245,6 +578,7 @@ void RimDataDeck::buildSectionsFromDeck()
                 dataKeyword = new RimDataKeyword();
             }
             dataKeyword->setDeckKeyword( &keyword );
+            m_keywordProfiles[i].buildTimeNs = buildTimer.nsecsElapsed() - buildStartNs;
             
             // Set text position from our calculated positions
             if ( m_keywordPositions.contains( i ) )
@@ -259,26 +593,272 @@ void RimDataDeck::buildSectionsFromDeck()
 }
 
 //--------------------------------------------------------------------------------------------------
-///
+/// Update the tree after the file was parsed again. Keyword nodes are matched to the new keywords by
+/// content hash, so unchanged nodes keep their tree state and only changed keywords are patched.
+/// Between two unchanged keywords, nodes of keywords with the same name are reused for the changed
+/// keywords. Only the sections whose keyword list changed are refreshed in the tree.
 //--------------------------------------------------------------------------------------------------
 bool RimDataDeck::updateFromDeck( std::shared_ptr<Opm::Deck> deck )
 {
+    DATADECK_TRACE_SCOPE( "deck", "RimDataDeck::updateFromDeck" );
+
     if ( !deck )
     {
         return false;
     }
 
-    m_deck         = deck;
-    m_keywordCount = static_cast<int>( m_deck->size() );
+    // The new deck was parsed from the editor text, the parse time of the file no longer applies
+    m_parseTimeNs = -1;
 
-    // Clear existing sections
-    m_sections.deleteChildren();
+    std::vector<RimDataKeyword*> oldKeywords = keywordsInDeckOrder();
+    if ( !m_deck || oldKeywords.size() != m_deck->size() )
+    {
+        m_deck         = deck;
+        m_keywordCount = static_cast<int>( m_deck->size() );
+        buildSectionsFromDeck();
+        refreshMemoryUsage();
+        updateConnectedEditors();
+        return true;
+    }
 
-    // Rebuild from new deck
-    buildSectionsFromDeck();
+    if ( !m_comparison().isEmpty() )
+    {
+        // The comparison was made against the previous content
+        clearComparison();
+    }
 
-    // Update all connected editors
-    updateConnectedEditors();
+    if ( m_keywordHashes.size() != m_deck->size() )
+    {
+        m_keywordHashes = DeckKeywordHash::keywordHashes( *m_deck );
+    }
+    std::vector<size_t> newHashes = DeckKeywordHash::keywordHashes( *deck );
+
+    std::vector<RimDataKeyword*> newKeywords( deck->size(), nullptr );
+    std::vector<bool>            isReused( oldKeywords.size(), false );
+    QSet<RimDataKeyword*>        patchedKeywords;
+
+    auto reuseKeywordsWithSameName = [&]( int oldBegin, int oldEnd, int newBegin, int newEnd )
+    {
+        std::vector<size_t> oldNames;
+        std::vector<size_t> newNames;
+        for ( int i = oldBegin; i < oldEnd; ++i )
+        {
+            oldNames.push_back( qHash( oldKeywords[i]->keywordName() ) );
+        }
+        for ( int i = newBegin; i < newEnd; ++i )
+        {
+            newNames.push_back( qHash( QString::fromStdString( ( *deck )[i].name() ) ) );
+        }
+
+        for ( const auto& [oldOffset, newOffset] : DataDeckDiff::alignSequences( oldNames, newNames ) )
+        {
+            RimDataKeyword* keyword = oldKeywords[oldBegin + oldOffset];
+            if ( keyword->keywordName() != QString::fromStdString( ( *deck )[newBegin + newOffset].name() ) ) continue;
+
+            keyword->setDeckKeyword( &( *deck )[newBegin + newOffset] );
+            newKeywords[newBegin + newOffset] = keyword;
+            isReused[oldBegin + oldOffset]    = true;
+            patchedKeywords.insert( keyword );
+        }
+    };
+
+    int oldBegin = 0;
+    int newBegin = 0;
+    for ( const auto& [oldIndex, newIndex] : DataDeckDiff::alignSequences( m_keywordHashes, newHashes ) )
+    {
+        if ( oldIndex > oldBegin && newIndex > newBegin )
+        {
+            reuseKeywordsWithSameName( oldBegin, oldIndex, newBegin, newIndex );
+        }
+
+        oldKeywords[oldIndex]->rebindDeckKeyword( &( *deck )[newIndex] );
+        newKeywords[newIndex] = oldKeywords[oldIndex];
+        isReused[oldIndex]    = true;
+
+        oldBegin = oldIndex + 1;
+        newBegin = newIndex + 1;
+    }
+    if ( static_cast<int>( oldKeywords.size() ) > oldBegin && static_cast<int>( newKeywords.size() ) > newBegin )
+    {
+        reuseKeywordsWithSameName( oldBegin, static_cast<int>( oldKeywords.size() ), newBegin, static_cast<int>( newKeywords.size() ) );
+    }
+
+    m_deck          = deck;
+    m_keywordCount  = static_cast<int>( m_deck->size() );
+    m_keywordHashes = std::move( newHashes );
+
+    calculateTextPositions();
+
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+
+    for ( size_t i = 0; i < newKeywords.size(); ++i )
+    {
+        const Opm::DeckKeyword& keyword = ( *m_deck )[i];
+        if ( !newKeywords[i] )
+        {
+            const qint64 buildStartNs = buildTimer.nsecsElapsed();
+            if ( keyword.name() == "INCLUDE" )
+            {
+                newKeywords[i] = new RimIncludeKeyword();
+            }
+            else
+            {
+                newKeywords[i] = new RimDataKeyword();
+            }
+            newKeywords[i]->setDeckKeyword( &keyword );
+            m_keywordProfiles[i].buildTimeNs = buildTimer.nsecsElapsed() - buildStartNs;
+        }
+
+        if ( m_keywordPositions.contains( i ) )
+        {
+            const auto& pos = m_keywordPositions[i];
+            newKeywords[i]->setTextPosition( pos.first, pos.second );
+        }
+    }
+
+    // Group the keyword nodes into sections the same way as buildSectionsFromDeck()
+    struct SectionKeywords
+    {
+        RimDataSection::SectionType  type = RimDataSection::SectionType::OTHER;
+        std::vector<RimDataKeyword*> keywords;
+        RimDataSection*              section = nullptr;
+    };
+
+    std::vector<SectionKeywords> newSections;
+    for ( RimDataKeyword* keyword : newKeywords )
+    {
+        RimDataSection::SectionType type = RimDataSection::stringToSectionType( keyword->keywordName() );
+        if ( type != RimDataSection::SectionType::OTHER || newSections.empty() )
+        {
+            newSections.push_back( SectionKeywords{ type, {}, nullptr } );
+        }
+        newSections.back().keywords.push_back( keyword );
+    }
+
+    // Reuse the section node that held the first reused keyword of each new section
+    std::vector<RimDataSection*>            oldSections;
+    QHash<RimDataKeyword*, RimDataSection*> oldSectionOfKeyword;
+    for ( RimDataSection* section : m_sections )
+    {
+        oldSections.push_back( section );
+        for ( RimDataKeyword* keyword : section->keywords() )
+        {
+            oldSectionOfKeyword[keyword] = section;
+        }
+    }
+
+    QSet<RimDataSection*> reusedSections;
+    for ( SectionKeywords& newSection : newSections )
+    {
+        for ( RimDataKeyword* keyword : newSection.keywords )
+        {
+            RimDataSection* section = oldSectionOfKeyword.value( keyword, nullptr );
+            if ( section && section->sectionType() == newSection.type && !reusedSections.contains( section ) )
+            {
+                newSection.section = section;
+                reusedSections.insert( section );
+                break;
+            }
+        }
+    }
+
+    // Detach the keywords of all sections that change before moving any keyword
+    for ( RimDataSection* section : oldSections )
+    {
+        if ( !reusedSections.contains( section ) )
+        {
+            section->takeKeywords();
+        }
+    }
+
+    std::vector<RimDataSection*> changedSections;
+    for ( SectionKeywords& newSection : newSections )
+    {
+        if ( !newSection.section )
+        {
+            newSection.section = new RimDataSection();
+            newSection.section->setSectionType( newSection.type );
+            if ( newSection.type == RimDataSection::SectionType::OTHER )
+            {
+                newSection.section->setSectionName( "Pre-RUNSPEC" );
+            }
+            changedSections.push_back( newSection.section );
+            continue;
+        }
+
+        const auto& currentKeywords = newSection.section->keywords();
+        bool        isUnchanged     = currentKeywords.size() == newSection.keywords.size();
+        for ( size_t i = 0; isUnchanged && i < newSection.keywords.size(); ++i )
+        {
+            isUnchanged = currentKeywords[i] == newSection.keywords[i];
+        }
+
+        if ( !isUnchanged )
+        {
+            newSection.section->takeKeywords();
+            changedSections.push_back( newSection.section );
+        }
+    }
+
+    for ( RimDataSection* section : changedSections )
+    {
+        for ( const SectionKeywords& newSection : newSections )
+        {
+            if ( newSection.section != section ) continue;
+
+            for ( RimDataKeyword* keyword : newSection.keywords )
+            {
+                section->addKeyword( keyword );
+            }
+        }
+    }
+
+    // Nodes of removed keywords are detached from their sections by now
+    for ( size_t i = 0; i < oldKeywords.size(); ++i )
+    {
+        if ( !isReused[i] )
+        {
+            delete oldKeywords[i];
+        }
+    }
+
+    bool isSectionListChanged = oldSections.size() != newSections.size();
+    for ( size_t i = 0; !isSectionListChanged && i < newSections.size(); ++i )
+    {
+        isSectionListChanged = oldSections[i] != newSections[i].section;
+    }
+
+    if ( isSectionListChanged )
+    {
+        m_sections.clearWithoutDelete();
+        for ( const SectionKeywords& newSection : newSections )
+        {
+            m_sections.push_back( newSection.section );
+        }
+        for ( RimDataSection* section : oldSections )
+        {
+            if ( !reusedSections.contains( section ) )
+            {
+                delete section;
+            }
+        }
+
+        refreshMemoryUsage();
+        updateConnectedEditors();
+        return true;
+    }
+
+    refreshMemoryUsage();
+    m_keywordCount.uiCapability()->updateConnectedEditors();
+    for ( RimDataSection* section : changedSections )
+    {
+        section->updateConnectedEditors();
+    }
+    for ( RimDataKeyword* keyword : patchedKeywords )
+    {
+        keyword->updateConnectedEditors();
+    }
 
     return true;
 }
@@ -288,7 +868,17 @@ bool RimDataDeck::updateFromDeck( std::shared_ptr<Opm::Deck> deck )
 //--------------------------------------------------------------------------------------------------
 QString RimDataDeck::serializeToText() const
 {
-    if ( !m_deck )
+    return serializeToText( m_filePath, m_deck.get() );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The text of the file when it exists, otherwise the text is generated from the deck
+//--------------------------------------------------------------------------------------------------
+QString RimDataDeck::serializeToText( const QString& filePath, const Opm::Deck* deck )
+{
+    DATADECK_TRACE_SCOPE( "deck", "RimDataDeck::serializeToText" );
+
+    if ( !deck )
     {
         return QString();
     }
@@ -296,9 +886,9 @@ QString RimDataDeck::serializeToText() const
     QStringList lines;
 
     // Try to read original file if it exists
-    if ( QFileInfo::exists( m_filePath ) )
+    if ( QFileInfo::exists( filePath ) )
     {
-        QFile file( m_filePath );
+        QFile file( filePath );
         if ( file.open( QIODevice::ReadOnly | QIODevice::Text ) )
         {
             QTextStream in( &file );
@@ -309,9 +899,9 @@ QString RimDataDeck::serializeToText() const
     }
 
     // Otherwise, serialize from deck structure
-    for ( size_t i = 0; i < m_deck->size(); ++i )
+    for ( size_t i = 0; i < deck->size(); ++i )
     {
-        const Opm::DeckKeyword& keyword     = ( *m_deck )[i];
+        const Opm::DeckKeyword& keyword     = ( *deck )[i];
         QString                 keywordName = QString::fromStdString( keyword.name() );
 
         // Check if this is a section keyword
@@ -396,82 +986,69 @@ QString RimDataDeck::serializeToText() const
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void RimDataDeck::calculateTextPositions()
+void RimDataDeck::calculateTextPositions( const DataDeckFileScan* fileScan )
 {
+    DATADECK_TRACE_SCOPE( "deck", "RimDataDeck::calculateTextPositions" );
+
     m_keywordPositions.clear();
+    m_keywordProfiles.clear();
     
     if ( !m_deck )
     {
         return;
     }
 
-    // Get the actual text content that will be displayed
-    QString textContent = serializeToText();
-    QStringList lines = textContent.split( '\n' );
-    
-    // Track which lines we've already used to avoid duplicate matches
-    QSet<int> usedLines;
-    
-    // Find each keyword in the actual text content
+    // The size of each keyword is collected in the same pass, for the deck profile
+    m_keywordProfiles.resize( m_deck->size() );
+
+    // Scan the text that will be displayed, unless the loader has scanned the file already
+    const DataDeckFileScan scan = fileScan ? *fileScan : DataDeckFileScan::scanText( serializeToText() );
+
+    // The text is read from the file when it exists, and then holds no keywords of the include files
+    const bool    isTextFromFile   = fileScan || QFileInfo::exists( m_filePath );
+    const QString absoluteFilePath = QFileInfo( m_filePath ).absoluteFilePath();
+
+    // Keywords end at a "/" line, or at the trailing "/" of their last record
+    int nextKeywordLines = 0;
+
     for ( size_t i = 0; i < m_deck->size(); ++i )
     {
         const Opm::DeckKeyword& keyword = (*m_deck)[i];
         QString keywordName = QString::fromStdString( keyword.name() );
-        
-        // Search for this keyword in the text lines (starting from unused lines)
-        int startLine = -1;
-        int endLine = -1;
-        
-        for ( int lineIdx = 0; lineIdx < lines.size(); ++lineIdx )
+
+        KeywordProfile& keywordProfile = m_keywordProfiles[i];
+        keywordProfile.recordCount     = static_cast<qint64>( keyword.size() );
+        for ( size_t recordIndex = 0; recordIndex < keyword.size(); ++recordIndex )
         {
-            // Skip lines we've already assigned to previous keywords
-            if ( usedLines.contains( lineIdx ) )
-                continue;
-                
-            QString line = lines[lineIdx].trimmed();
-            
-            // Check if this line contains our keyword name
-            if ( line == keywordName )
+            const Opm::DeckRecord& record = keyword.getRecord( recordIndex );
+            for ( size_t itemIndex = 0; itemIndex < record.size(); ++itemIndex )
             {
-                startLine = lineIdx + 1; // Convert to 1-based line numbers
-                usedLines.insert( lineIdx );
-                
-                // For section keywords, the end is usually just the keyword line
-                bool isSection = ( keywordName == "RUNSPEC" || keywordName == "GRID" || keywordName == "EDIT" ||
-                                  keywordName == "PROPS" || keywordName == "REGIONS" || keywordName == "SOLUTION" ||
-                                  keywordName == "SUMMARY" || keywordName == "SCHEDULE" );
-                
-                if ( isSection )
-                {
-                    endLine = startLine; // Section keywords are single line
-                }
-                else
-                {
-                    // For regular keywords, find the terminating "/"
-                    endLine = startLine;
-                    for ( int searchIdx = lineIdx + 1; searchIdx < lines.size(); ++searchIdx )
-                    {
-                        QString searchLine = lines[searchIdx].trimmed();
-                        usedLines.insert( searchIdx );
-                        
-                        if ( searchLine == "/" )
-                        {
-                            endLine = searchIdx + 1; // Include the "/" line
-                            break;
-                        }
-                        else if ( !searchLine.isEmpty() )
-                        {
-                            endLine = searchIdx + 1; // Update end line as we find content
-                        }
-                    }
-                }
-                break; // Found the keyword, move to next
+                keywordProfile.valueCount += static_cast<qint64>( record.getItem( itemIndex ).data_size() );
             }
         }
-        
-        if ( startLine > 0 && endLine > 0 )
+
+        const QString keywordFile = QString::fromStdString( keyword.location().filename );
+        if ( isTextFromFile && !keywordFile.isEmpty() && QFileInfo( keywordFile ).absoluteFilePath() != absoluteFilePath )
+        {
+            // Inlined from an include file, its text is measured in the include file's own deck
+            keywordProfile.bytes = -1;
+            continue;
+        }
+
+        // Keywords are in deck order in the text. A keyword that is not found leaves the search
+        // position, so the following keywords are still found.
+        for ( int keywordIndex = nextKeywordLines; keywordIndex < scan.keywords.size(); ++keywordIndex )
         {
-            m_keywordPositions[i] = QPair<int, int>( startLine, endLine );
+            const DataDeckFileScan::KeywordText& keywordText = scan.keywords[keywordIndex];
+            if ( keywordText.lines.keyword != keywordName )
+            {
+                continue;
+            }
+
+            m_keywordPositions[i] = QPair<int, int>( keywordText.lines.firstLine + 1, keywordText.lines.lastLine + 1 ); // 1-based line numbers
+            keywordProfile.bytes  = keywordText.bytes;
+            nextKeywordLines      = keywordIndex + 1;
+            break;
         }
     }
 }
@@ -494,6 +1071,135 @@ RimDataKeyword* RimDataDeck::findKeywordAtLine( int lineNumber )
     return nullptr;
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::vector<RimDataKeyword*> RimDataDeck::keywordsInDeckOrder() const
+{
+    std::vector<RimDataKeyword*> keywords;
+    for ( RimDataSection* section : m_sections )
+    {
+        for ( RimDataKeyword* keyword : section->keywords() )
+        {
+            keywords.push_back( keyword );
+        }
+    }
+    return keywords;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Attach validation problems to the keyword nodes. Problems without a keyword index are ignored,
+/// keywords without problems are cleared.
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::setValidationProblems( const QList<DataDeckProblem>& problems )
+{
+    QMap<int, QList<DataDeckProblem>> problemsPerKeyword;
+    for ( const DataDeckProblem& problem : problems )
+    {
+        if ( problem.keywordIndex >= 0 )
+        {
+            problemsPerKeyword[problem.keywordIndex].append( problem );
+        }
+    }
+
+    std::vector<RimDataKeyword*> keywords = keywordsInDeckOrder();
+    for ( size_t i = 0; i < keywords.size(); ++i )
+    {
+        keywords[i]->setValidationProblems( problemsPerKeyword.value( static_cast<int>( i ) ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The base deck marks changed and removed keywords, the other deck marks changed and added keywords
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::setComparison( const DataDeckDiff& diff, bool isBaseDeck, RimDataDeck* otherDeck )
+{
+    std::vector<RimDataKeyword*> keywords      = keywordsInDeckOrder();
+    std::vector<RimDataKeyword*> otherKeywords = otherDeck->keywordsInDeckOrder();
+    for ( RimDataKeyword* keyword : keywords )
+    {
+        keyword->setDifference( QString(), QString() );
+        keyword->setComparedKeyword( nullptr );
+    }
+
+    for ( const DataDeckKeywordDiff& keywordDiff : diff.keywordDiffs() )
+    {
+        const int index = isBaseDeck ? keywordDiff.baseIndex : keywordDiff.otherIndex;
+        if ( index < 0 || index >= static_cast<int>( keywords.size() ) )
+        {
+            continue;
+        }
+
+        QString marker;
+        switch ( keywordDiff.change )
+        {
+            case DataDeckKeywordDiff::Change::ADDED:
+                marker = "added";
+                break;
+            case DataDeckKeywordDiff::Change::REMOVED:
+                marker = "removed";
+                break;
+            default:
+                marker = "changed";
+                break;
+        }
+        keywords[index]->setDifference( marker, keywordDiff.description() );
+
+        const int otherIndex = isBaseDeck ? keywordDiff.otherIndex : keywordDiff.baseIndex;
+        if ( otherIndex >= 0 && otherIndex < static_cast<int>( otherKeywords.size() ) )
+        {
+            keywords[index]->setComparedKeyword( otherKeywords[otherIndex] );
+        }
+    }
+
+    m_comparison = QString( isBaseDeck ? "Compared with %1: %2" : "Compared with base %1: %2" )
+                       .arg( QFileInfo( otherDeck->filePath() ).fileName() )
+                       .arg( diff.summary() );
+    updateConnectedEditors();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeck::clearComparison()
+{
+    for ( RimDataKeyword* keyword : keywordsInDeckOrder() )
+    {
+        keyword->setDifference( QString(), QString() );
+        keyword->setComparedKeyword( nullptr );
+    }
+    m_comparison = "";
+    updateConnectedEditors();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+std::optional<DataDeckGridChecker::GridArray> RimDataDeck::gridArray( const RimDataKeyword* keyword ) const
+{
+    if ( !m_deck )
+    {
+        return std::nullopt;
+    }
+
+    std::vector<RimDataKeyword*> keywords = keywordsInDeckOrder();
+    auto                         it       = std::find( keywords.begin(), keywords.end(), keyword );
+    if ( it == keywords.end() )
+    {
+        return std::nullopt;
+    }
+
+    const size_t keywordIndex = static_cast<size_t>( std::distance( keywords.begin(), it ) );
+    for ( const DataDeckGridChecker::GridArray& array : DataDeckGridChecker::collectGridArrays( *m_deck ) )
+    {
+        if ( array.keywordIndex == keywordIndex )
+        {
+            return array;
+        }
+    }
+    return std::nullopt;
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -523,6 +1229,8 @@ QList<RimIncludeFile*> RimDataDeck::includeFiles() const
 //--------------------------------------------------------------------------------------------------
 void RimDataDeck::resolveIncludes()
 {
+    DATADECK_TRACE_SCOPE( "include", "RimDataDeck::resolveIncludes" );
+
     // Clear existing include files
     m_includeFiles.deleteChildren();
     
@@ -534,7 +1242,6 @@ void RimDataDeck::resolveIncludes()
     int includeKeywordCount = 0;
     int includeKeywordCastCount = 0;
     int includePathCount = 0;
-    QStringList allKeywordNames;
     
     for ( RimDataSection* section : m_sections )
     {
@@ -543,12 +1250,6 @@ void RimDataDeck::resolveIncludes()
             totalKeywords++;
             QString keywordName = keyword->keywordName();
             
-            // Collect first 20 keyword names for debugging
-            if (allKeywordNames.size() < 20)
-            {
-                allKeywordNames.append(keywordName);
-            }
-            
             if ( keywordName == "INCLUDE" )
             {
                 includeKeywordCount++;
@@ -590,112 +1291,24 @@ void RimDataDeck::resolveIncludes()
         }
     }
     
-    // Debug output to console - these will show in debug builds
-    qDebug() << "INCLUDE Detection Stats:";
-    qDebug() << "  Total keywords:" << totalKeywords;
-    qDebug() << "  INCLUDE keywords found:" << includeKeywordCount;
-    qDebug() << "  Successfully cast to RimIncludeKeyword:" << includeKeywordCastCount;
-    qDebug() << "  Include paths extracted:" << includePathCount;
-    qDebug() << "  Include files created:" << m_includeFiles.size();
-    qDebug() << "  First 20 keywords:" << allKeywordNames.join(", ");
+    qCDebug( logInclude ) << "INCLUDE detection: keywords" << totalKeywords << "INCLUDE keywords" << includeKeywordCount
+                          << "cast to RimIncludeKeyword" << includeKeywordCastCount << "paths" << includePathCount
+                          << "include files" << m_includeFiles.size();
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void RimDataDeck::resolveIncludesFromRawFile()
+void RimDataDeck::resolveIncludesFromRawFile( const QMap<QString, std::shared_ptr<Opm::Deck>>& includeDecks,
+                                              const QMap<QString, DataDeckFileScan>&            fileScans )
 {
+    DATADECK_TRACE_SCOPE( "include", "RimDataDeck::resolveIncludesFromRawFile" );
+
     // Clear existing include files
     m_includeFiles.deleteChildren();
     
-    if (m_filePath().isEmpty())
-    {
-        qDebug() << "No file path available for include detection";
-        return;
-    }
-    
-    QFile file(m_filePath());
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        qDebug() << "Could not open file for include detection:" << m_filePath();
-        return;
-    }
-    
-    QTextStream in(&file);
-    QStringList includePaths;
-    int lineNumber = 0;
-    
-    qDebug() << "Scanning file for INCLUDE statements:" << m_filePath();
-    
-    while (!in.atEnd())
-    {
-        QString line = in.readLine();
-        lineNumber++;
-        
-        // Remove comments
-        int commentPos = line.indexOf("--");
-        if (commentPos >= 0)
-        {
-            line = line.left(commentPos);
-        }
-        
-        QString trimmedLine = line.trimmed();
-        
-        // Check if line is exactly "INCLUDE"
-        if (trimmedLine.compare("INCLUDE", Qt::CaseInsensitive) == 0)
-        {
-            qDebug() << "Found INCLUDE keyword at line" << lineNumber;
-            
-            // Read the next line which should contain the file path
-            if (!in.atEnd())
-            {
-                QString nextLine = in.readLine();
-                lineNumber++;
-                
-                // Remove comments from next line
-                int nextCommentPos = nextLine.indexOf("--");
-                if (nextCommentPos >= 0)
-                {
-                    nextLine = nextLine.left(nextCommentPos);
-                }
-                
-                QString trimmedNextLine = nextLine.trimmed();
-                qDebug() << "  Next line" << lineNumber << ":" << trimmedNextLine;
-                
-                // Extract filename from patterns like: 'filename' / or "filename" /
-                QRegularExpression pathRegex(R"(['\"]([^'\"]+)['\"])", QRegularExpression::CaseInsensitiveOption);
-                QRegularExpressionMatch match = pathRegex.match(trimmedNextLine);
-                
-                if (match.hasMatch())
-                {
-                    QString includePath = match.captured(1).trimmed();
-                    qDebug() << "  Extracted include path:" << includePath;
-                    
-                    if (!includePath.isEmpty() && !includePaths.contains(includePath))
-                    {
-                        includePaths.append(includePath);
-                        qDebug() << "  Added unique include path:" << includePath;
-                    }
-                    else if (!includePath.isEmpty())
-                    {
-                        qDebug() << "  Path already exists:" << includePath;
-                    }
-                }
-                else
-                {
-                    qDebug() << "  Could not extract path from:" << trimmedNextLine;
-                }
-            }
-            else
-            {
-                qDebug() << "  No next line available after INCLUDE";
-            }
-        }
-    }
-    
-    file.close();
-    
-    qDebug() << "Found" << includePaths.size() << "unique include paths";
+    auto        fileScan     = fileScans.constFind( m_filePath() );
+    QStringList includePaths = fileScan != fileScans.constEnd() ? fileScan->includePaths : scanIncludePaths( m_filePath() );
     
     // Create RimIncludeFile objects for each include
     for (const QString& includePath : includePaths)
@@ -704,17 +1317,43 @@ void RimDataDeck::resolveIncludesFromRawFile()
         includeFile->setIncludePath(includePath, m_basePath());
         includeFile->updateFileStatus();
         
-        // Try to load the content if the file exists
+        // Try to load the content if the file exists, using pre-parsed decks when available
         if (includeFile->fileExists())
         {
-            includeFile->loadContent();
+            includeFile->loadContent(includeDecks, fileScans);
         }
         
         addIncludeFile(includeFile);
-        qDebug() << "Created include file for:" << includePath;
+        qCDebug( logInclude ) << "Created include file for:" << includePath;
     }
     
-    qDebug() << "Final include files count:" << m_includeFiles.size();
+    qCDebug( logInclude ) << "Final include files count:" << m_includeFiles.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QStringList RimDataDeck::scanIncludePaths( const QString& filePath )
+{
+    DATADECK_TRACE_SCOPE_DETAIL( "include", "RimDataDeck::scanIncludePaths", filePath );
+
+    if ( filePath.isEmpty() )
+    {
+        qCDebug( logInclude ) << "No file path available for include detection";
+        return QStringList();
+    }
+
+    QFile file( filePath );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qCDebug( logInclude ) << "Could not open file for include detection:" << filePath;
+        return QStringList();
+    }
+
+    qCDebug( logInclude ) << "Scanning file for INCLUDE statements:" << filePath;
+
+    QTextStream in( &file );
+    return DataDeckFileScan::findIncludePaths( in.readAll() );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -4,9 +4,18 @@
 #include "cafPdmField.h"
 #include "cafPdmChildArrayField.h"
 
+#include "DataDeckFileScan.h"
+#include "DataDeckGridChecker.h"
+#include "DataDeckMemoryUsage.h"
+#include "DataDeckProfile.h"
+#include "DataDeckProblem.h"
+
 #include <memory>
+#include <optional>
+#include <vector>
 #include <QMap>
 #include <QPair>
+#include <QPointer>
 #include <QSet>
 
 namespace Opm
@@ -14,12 +23,17 @@ namespace Opm
 class Deck;
 }
 
+class DataDeckDiff;
 class RimDataSection;
 class RimDataKeyword;
 class RimIncludeFile;
+class RimDataDeckTextEditor;
 
 //==================================================================================================
-/// Represents an Eclipse DATA file parsed using opm-common
+/// Represents an Eclipse DATA file parsed using opm-common.
+///
+/// Only the file path and the cache key are written to the project file. Sections, keywords, items
+/// and include files are derived from the deck and rebuilt when the project is opened.
 //==================================================================================================
 class RimDataDeck : public caf::PdmObject
 {
@@ -30,17 +44,37 @@ public:
     ~RimDataDeck() override;
 
     bool loadFromFile( const QString& filePath );
-    void setDeck( std::shared_ptr<Opm::Deck> deck, const QString& filePath );
+    void setDeck( std::shared_ptr<Opm::Deck>                        deck,
+                  const QString&                                    filePath,
+                  const QMap<QString, std::shared_ptr<Opm::Deck>>& includeDecks = {},
+                  const QMap<QString, DataDeckFileScan>&            fileScans    = {} ); // Keyed by file path
     bool updateFromDeck( std::shared_ptr<Opm::Deck> deck );
 
     QString             filePath() const;
+    QString             cacheKey() const; // Changes when the deck file or one of its include files changes
     int                 keywordCount() const;
     std::shared_ptr<Opm::Deck> deck() const;
 
     QString serializeToText() const;
+
+    // Build steps run by setDeck(), public so that each step can be timed alone. Without a scan of
+    // the file, the text is read again.
+    void buildSectionsFromDeck( const DataDeckFileScan* fileScan = nullptr );
+    void calculateTextPositions( const DataDeckFileScan* fileScan = nullptr );
     
     // Position tracking
-    RimDataKeyword* findKeywordAtLine( int lineNumber );
+    RimDataKeyword*        findKeywordAtLine( int lineNumber );
+
+    // Keyword nodes in deck order, index i wraps the i-th keyword of deck()
+    std::vector<RimDataKeyword*> keywordsInDeckOrder() const;
+    void                         setValidationProblems( const QList<DataDeckProblem>& problems );
+
+    // Mark keyword nodes with the result of comparing this deck with another deck
+    void setComparison( const DataDeckDiff& diff, bool isBaseDeck, RimDataDeck* otherDeck );
+    void clearComparison();
+
+    // Grid dimensions and BOX in effect for a grid array keyword of this deck
+    std::optional<DataDeckGridChecker::GridArray> gridArray( const RimDataKeyword* keyword ) const;
     
     // Include file management
     void addIncludeFile( RimIncludeFile* includeFile );
@@ -49,27 +83,63 @@ public:
     QString basePath() const;
     QStringList findIncludeReferences() const;
     bool validateIncludePaths() const;
-    void resolveIncludesFromRawFile();
+    void resolveIncludesFromRawFile( const QMap<QString, std::shared_ptr<Opm::Deck>>& includeDecks = {},
+                                     const QMap<QString, DataDeckFileScan>&            fileScans    = {} );
+
+    // Estimated memory held by this deck, its include decks and the editor while it shows the deck
+    DataDeckMemoryUsage memoryUsage() const;
+    void                refreshMemoryUsage(); // Called when the deck is set or updated
+    void                setTextEditor( RimDataDeckTextEditor* textEditor );
+
+    // Size and load time of each keyword and include file, collected while the deck is loaded.
+    // Parse times are measured by the caller when the deck is parsed on a worker thread.
+    QList<DataDeckProfileEntry> profile() const;
+    void   setParseTimes( qint64 parseTimeNs, const QMap<QString, qint64>& includeParseTimesNs );
+    qint64 parseTimeNs() const;
+
+    // Parsing helpers, safe to call from worker threads
+    static std::shared_ptr<Opm::Deck> parseDeckFile( const QString& filePath );
+    static QStringList                scanIncludePaths( const QString& filePath );
+    static QString                    serializeToText( const QString& filePath, const Opm::Deck* deck );
 
 protected:
+    void initAfterRead() override;
     void defineUiOrdering( QString uiConfigName, caf::PdmUiOrdering& uiOrdering ) override;
     void defineUiTreeOrdering( caf::PdmUiTreeOrdering& uiTreeOrdering, QString uiConfigName = "" ) override;
+    void defineEditorAttribute( const caf::PdmFieldHandle* field, QString uiConfigName, caf::PdmUiEditorAttribute* attribute ) override;
 
 private:
-    void buildSectionsFromDeck();
-    void calculateTextPositions();
+    void updateCacheKey();
+    void collectSourceFiles( QStringList& filePaths ) const;
+    QList<DataDeckProfileEntry> includeProfile() const;
+
+    struct KeywordProfile
+    {
+        qint64 bytes       = 0; // UTF-8 text in this deck's file, -1 if inlined from an include file
+        qint64 recordCount = 0;
+        qint64 valueCount  = 0;
+        qint64 buildTimeNs = -1;
+    };
 
 private:
     caf::PdmField<QString>                      m_filePath;
+    caf::PdmField<QString>                      m_cacheKey;        // Stored in the project to detect changed files
     caf::PdmField<int>                          m_keywordCount;
     caf::PdmField<QString>                      m_fileName;
     caf::PdmField<QString>                      m_basePath;        // Base directory for resolving relative includes
+    caf::PdmField<QString>                      m_comparison;      // Summary of the last comparison with another deck
+    caf::PdmField<QString>                      m_memoryUsage;     // Text of memoryUsage() at the last refresh
 
     caf::PdmChildArrayField<RimDataSection*>    m_sections;
     caf::PdmChildArrayField<RimIncludeFile*>    m_includeFiles;   // Managed include files
 
     std::shared_ptr<Opm::Deck>                  m_deck;
+    std::vector<size_t>                         m_keywordHashes;  // Content hash per keyword of m_deck, computed on the first update
     
     // Position tracking: maps keyword index to (startLine, endLine)
     QMap<size_t, QPair<int, int>>               m_keywordPositions;
+    std::vector<KeywordProfile>                 m_keywordProfiles; // Per keyword of m_deck, filled with the positions
+    qint64                                      m_parseTimeNs;
+
+    QPointer<RimDataDeckTextEditor>             m_textEditor;     // Last editor that showed this deck
 };
@@ -1,12 +1,18 @@
 #include "RimDataDeckTextEditor.h"
 #include "DataFileSyntaxHighlighter.h"
 #include "DataFileCompleter.h"
+#include "DataDeckKeywordScanner.h"
+#include "DataDeckMemoryUsage.h"
+#include "DataDeckMetrics.h"
+#include "DataDeckTrace.h"
 #include "KeywordHelpWidget.h"
 #include "RimDataDeck.h"
 #include "RimDataKeyword.h" // Needed for RimDataKeyword
 
+#include <QMouseEvent>
 #include <QPainter>
 #include <QTextBlock>
+#include <QTextBlockUserData>
 #include <QKeyEvent>
 #include <QCompleter>
 #include <QAbstractItemView>
@@ -15,12 +21,35 @@
 #include <QRegularExpression>
 #include <QTextDocument> // Needed for QTextDocument
 #include <QTextCursor>   // Needed for QTextCursor
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+//==================================================================================================
+/// Attached to the first line of a keyword. The following body blocks are hidden while folded.
+//==================================================================================================
+class FoldRegionData : public QTextBlockUserData
+{
+public:
+    explicit FoldRegionData( int bodyBlockCount )
+        : bodyBlockCount( bodyBlockCount )
+        , isFolded( false )
+    {
+    }
+
+    int  bodyBlockCount;
+    bool isFolded;
+};
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::alignColumnsForKeyword( RimDataKeyword* keyword )
 {
-    if ( !keyword || !document() )
+    if ( !keyword || !document() || m_isLoading )
     {
         return;
     }
@@ -33,6 +62,9 @@ void RimDataDeckTextEditor::alignColumnsForKeyword( RimDataKeyword* keyword )
         return;
     }
 
+    // Hidden blocks cannot be edited in place
+    setFolded( document()->findBlockByNumber( startLine - 1 ), false );
+
     QTextCursor cursor( document() );
     cursor.beginEditBlock(); // Group all changes into a single undo/redo block
 
@@ -42,7 +74,7 @@ void RimDataDeckTextEditor::alignColumnsForKeyword( RimDataKeyword* keyword )
     // Extract lines for the keyword
     for ( int i = startLine - 1; i < endLine; ++i ) // Adjust for 0-based blockNumber
     {
-        QTextBlock block = document()->findBlockByLineNumber( i );
+        QTextBlock block = document()->findBlockByNumber( i );
         if ( block.isValid() )
         {
             linesToAlign << block.text();
@@ -183,6 +215,13 @@ RimDataDeckTextEditor::RimDataDeckTextEditor( QWidget* parent )
     , m_helpWidget( nullptr )
     , m_lineNumberArea( nullptr )
     , m_helpUpdateTimer( nullptr )
+    , m_chunkLoadTimer( nullptr )
+    , m_readWatcher( nullptr )
+    , m_foldScanWatcher( nullptr )
+    , m_pendingOffset( 0 )
+    , m_isLoading( false )
+    , m_nextFoldRegion( 0 )
+    , m_foldUpdateTimer( nullptr )
 {
     // Setup line number area
     m_lineNumberArea = new LineNumberArea( this );
@@ -204,6 +243,18 @@ RimDataDeckTextEditor::RimDataDeckTextEditor( QWidget* parent )
     m_helpUpdateTimer->setInterval( 500 ); // 500ms delay
     connect( m_helpUpdateTimer, &QTimer::timeout, this, &RimDataDeckTextEditor::updateKeywordHelp );
 
+    // Setup progressive loading timer, appends one chunk per event loop iteration
+    m_chunkLoadTimer = new QTimer( this );
+    m_chunkLoadTimer->setInterval( 0 );
+    connect( m_chunkLoadTimer, &QTimer::timeout, this, &RimDataDeckTextEditor::appendNextChunk );
+
+    // Setup fold region update timer, edits are collected and the regions around them rescanned
+    m_foldUpdateTimer = new QTimer( this );
+    m_foldUpdateTimer->setSingleShot( true );
+    m_foldUpdateTimer->setInterval( 250 );
+    connect( m_foldUpdateTimer, &QTimer::timeout, this, &RimDataDeckTextEditor::updateFoldRegions );
+    connect( document(), &QTextDocument::contentsChange, this, &RimDataDeckTextEditor::onContentsChange );
+
     // Setup font
     QFont font;
     font.setFamily( "Cascadia Mono" );
@@ -238,32 +289,521 @@ void RimDataDeckTextEditor::setDataDeck( RimDataDeck* dataDeck )
     m_dataDeck = dataDeck;
     if ( m_dataDeck )
     {
+        m_dataDeck->setTextEditor( this );
         loadFromDeck();
     }
+    else if ( m_isLoading )
+    {
+        finishProgressiveLoad();
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
+qint64 RimDataDeckTextEditor::documentMemoryBytes() const
+{
+    return DataDeckMemoryUsage::documentBytes( *document() ) + DataDeckMemoryUsage::stringBytes( m_pendingText );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Read the deck text on a worker thread, show the first part of it when it arrives and append the
+/// rest in chunks from the event loop. Editing is locked until the whole document is loaded.
+//--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::loadFromDeck()
 {
-    if ( !m_dataDeck )
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::loadFromDeck" );
+
+    if ( m_isLoading )
     {
-        setPlainText( "" );
-        return;
+        finishProgressiveLoad();
     }
 
+    m_loadedText.clear();
+
     // Block signals to avoid triggering modification
     blockSignals( true );
+    setPlainText( "" );
+    document()->setModified( false );
+    blockSignals( false );
+
+    m_foldUpdateTimer->stop();
+    m_foldDirtyStart = QTextCursor();
+    m_foldDirtyEnd   = QTextCursor();
+
+    if ( !m_dataDeck )
+    {
+        return;
+    }
+
+    m_isLoading = true;
+    setReadOnly( true );
+    setUndoRedoEnabled( false );
+    highlightCurrentLine();
+    emit loadProgress( 0 );
+
+    // The worker keeps the deck alive, also if the deck is reloaded while reading
+    const QString                    filePath = m_dataDeck->filePath();
+    const std::shared_ptr<Opm::Deck> deck     = m_dataDeck->deck();
+
+    auto* watcher = new QFutureWatcher<QString>( this );
+    connect( watcher, &QFutureWatcher<QString>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+
+        // Canceled, or superseded by a newer load
+        if ( watcher != m_readWatcher )
+        {
+            return;
+        }
+
+        m_readWatcher = nullptr;
+        onTextRead( watcher->result() );
+    } );
+
+    m_readWatcher = watcher;
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( [filePath, deck]() {
+        // The document turns "\r\n" into one block separator, without it the text equals
+        // toPlainText() position by position
+        QString text = RimDataDeck::serializeToText( filePath, deck.get() );
+        if ( text.contains( '\r' ) )
+        {
+            text.replace( "\r\n", "\n" );
+        }
+        return text;
+    } ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Show the first chunk, then scan the whole text for fold regions while the rest is appended
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::onTextRead( const QString& text )
+{
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::onTextRead" );
 
-    // Load text from deck
-    QString text = m_dataDeck->serializeToText();
-    setPlainText( text );
+    m_pendingText   = text;
+    m_pendingOffset = nextChunkEnd( 0, INITIAL_CHUNK_SIZE );
 
-    // Mark as unmodified
+    blockSignals( true );
+    setPlainText( m_pendingText.left( m_pendingOffset ) );
     document()->setModified( false );
+    blockSignals( false );
+
+    updateLineNumberAreaWidth( 0 );
+    highlightCurrentLine();
+
+    // Fold regions are attached as their text arrives
+    auto* watcher = new QFutureWatcher<QList<QPair<int, int>>>( this );
+    connect( watcher, &QFutureWatcher<QList<QPair<int, int>>>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+
+        if ( watcher != m_foldScanWatcher )
+        {
+            return;
+        }
+
+        m_foldScanWatcher = nullptr;
+        onFoldScanFinished( watcher->result() );
+    } );
 
+    m_foldScanWatcher = watcher;
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( [text]() {
+        QList<QPair<int, int>> foldRegions;
+        for ( const DataDeckKeywordScanner::KeywordLines& keywordLines : DataDeckKeywordScanner::scanText( text ) )
+        {
+            if ( keywordLines.lastLine > keywordLines.firstLine )
+            {
+                foldRegions.append( { keywordLines.firstLine, keywordLines.lastLine } );
+            }
+        }
+        return foldRegions;
+    } ) );
+
+    if ( m_pendingOffset < m_pendingText.size() )
+    {
+        emit loadProgress( static_cast<int>( 100LL * m_pendingOffset / m_pendingText.size() ) );
+        m_chunkLoadTimer->start();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::onFoldScanFinished( const QList<QPair<int, int>>& foldRegions )
+{
+    m_pendingFoldRegions = foldRegions;
+    m_nextFoldRegion     = 0;
+    applyPendingFoldRegions();
+
+    finishLoadIfComplete();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::appendNextChunk()
+{
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::appendNextChunk" );
+
+    if ( !m_isLoading || m_pendingOffset >= m_pendingText.size() )
+    {
+        m_chunkLoadTimer->stop();
+        return;
+    }
+
+    int chunkEnd = nextChunkEnd( m_pendingOffset, APPEND_CHUNK_SIZE );
+
+    // Chunks end on a line break, so appending to the last (empty) block continues the text seamlessly
+    QTextCursor cursor( document() );
+    cursor.movePosition( QTextCursor::End );
+
+    blockSignals( true );
+    cursor.insertText( m_pendingText.mid( m_pendingOffset, chunkEnd - m_pendingOffset ) );
+    document()->setModified( false );
     blockSignals( false );
+
+    m_pendingOffset = chunkEnd;
+    applyPendingFoldRegions();
+    updateLineNumberAreaWidth( 0 );
+
+    if ( m_pendingOffset >= m_pendingText.size() )
+    {
+        m_chunkLoadTimer->stop();
+        finishLoadIfComplete();
+    }
+    else
+    {
+        emit loadProgress( static_cast<int>( 100LL * m_pendingOffset / m_pendingText.size() ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The load is complete when the whole text is in the document and its fold regions are scanned
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::finishLoadIfComplete()
+{
+    if ( m_readWatcher || m_foldScanWatcher || m_pendingOffset < m_pendingText.size() )
+    {
+        return;
+    }
+
+    finishProgressiveLoad();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::finishProgressiveLoad()
+{
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::finishProgressiveLoad" );
+
+    m_chunkLoadTimer->stop();
+
+    // A load that is cut short leaves part of the text. Jobs still running are discarded.
+    if ( !m_readWatcher && m_pendingOffset >= m_pendingText.size() )
+    {
+        m_loadedText = m_pendingText;
+    }
+    m_readWatcher     = nullptr;
+    m_foldScanWatcher = nullptr;
+    m_pendingText.clear();
+    m_pendingOffset = 0;
+
+    if ( m_isLoading )
+    {
+        m_isLoading = false;
+        setUndoRedoEnabled( true );
+        setReadOnly( false );
+        highlightCurrentLine();
+    }
+
+    applyPendingFoldRegions();
+    m_pendingFoldRegions.clear();
+    m_nextFoldRegion = 0;
+
+    emit loadFinished();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Attach fold regions whose text is fully loaded, and fold the large ones
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::applyPendingFoldRegions()
+{
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::applyPendingFoldRegions" );
+
+    const int blockCount = document()->blockCount();
+
+    // Chunks end on a line break, so while loading the last block is the empty one after it
+    const int lastCompleteBlock = m_isLoading ? blockCount - 2 : blockCount - 1;
+
+    int previousLastBlock = -1;
+    if ( m_nextFoldRegion > 0 )
+    {
+        previousLastBlock = m_pendingFoldRegions[m_nextFoldRegion - 1].second;
+    }
+
+    while ( m_nextFoldRegion < m_pendingFoldRegions.size() )
+    {
+        // The keyword line stays visible, the lines below it are the body
+        const int headerBlockNumber = m_pendingFoldRegions[m_nextFoldRegion].first;
+        const int lastBlockNumber   = m_pendingFoldRegions[m_nextFoldRegion].second;
+        if ( lastBlockNumber > lastCompleteBlock )
+        {
+            break;
+        }
+        ++m_nextFoldRegion;
+
+        const int bodyBlockCount = lastBlockNumber - headerBlockNumber;
+        if ( headerBlockNumber <= previousLastBlock || bodyBlockCount <= 0 )
+        {
+            continue;
+        }
+        previousLastBlock = lastBlockNumber;
+
+        QTextBlock headerBlock = document()->findBlockByNumber( headerBlockNumber );
+        headerBlock.setUserData( new FoldRegionData( bodyBlockCount ) );
+
+        if ( bodyBlockCount > FOLD_BY_DEFAULT_LINES )
+        {
+            setFolded( headerBlock, true );
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Collect the edited range. Text appended while loading gets its regions from the load.
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::onContentsChange( int position, int charsRemoved, int charsAdded )
+{
+    Q_UNUSED( charsRemoved );
+
+    if ( m_isLoading )
+    {
+        return;
+    }
+
+    if ( m_foldDirtyStart.isNull() )
+    {
+        m_foldDirtyStart = QTextCursor( document() );
+        m_foldDirtyEnd   = QTextCursor( document() );
+        m_foldDirtyStart.setPosition( position );
+        m_foldDirtyEnd.setPosition( position + charsAdded );
+    }
+    else
+    {
+        if ( position < m_foldDirtyStart.position() ) m_foldDirtyStart.setPosition( position );
+        if ( position + charsAdded > m_foldDirtyEnd.position() ) m_foldDirtyEnd.setPosition( position + charsAdded );
+    }
+
+    m_foldUpdateTimer->start();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Rescan the fold regions around the edited text. The scan starts at the last fold header before
+/// the edit and stops at the first fold header after it, since the scan state is reset at a header.
+/// Folded regions stay folded if their header is still a keyword.
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::updateFoldRegions()
+{
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::updateFoldRegions" );
+
+    if ( m_foldDirtyStart.isNull() )
+    {
+        return;
+    }
+
+    const int dirtyStartBlock = document()->findBlock( m_foldDirtyStart.position() ).blockNumber();
+    const int dirtyEndBlock   = document()->findBlock( m_foldDirtyEnd.position() ).blockNumber();
+    m_foldDirtyStart          = QTextCursor();
+    m_foldDirtyEnd            = QTextCursor();
+
+    QTextBlock firstBlock = document()->findBlockByNumber( dirtyStartBlock ).previous();
+    while ( firstBlock.isValid() && !dynamic_cast<FoldRegionData*>( firstBlock.userData() ) )
+    {
+        firstBlock = firstBlock.previous();
+    }
+    if ( !firstBlock.isValid() )
+    {
+        firstBlock = document()->firstBlock();
+    }
+
+    DataDeckKeywordScanner scanner;
+    QTextBlock             endBlock; // First block after the rescanned range, invalid at the end of the document
+    for ( QTextBlock block = firstBlock; block.isValid(); block = block.next() )
+    {
+        const bool isHeader = scanner.addLine( block.blockNumber(), block.text() );
+        if ( isHeader && block.blockNumber() > dirtyEndBlock && dynamic_cast<FoldRegionData*>( block.userData() ) )
+        {
+            endBlock = block;
+            break;
+        }
+    }
+    if ( !endBlock.isValid() )
+    {
+        scanner.finish();
+    }
+
+    QMap<int, int> bodyBlockCounts;
+    for ( const DataDeckKeywordScanner::KeywordLines& keywordLines : scanner.keywords() )
+    {
+        if ( keywordLines.lastLine > keywordLines.firstLine )
+        {
+            bodyBlockCounts[keywordLines.firstLine] = keywordLines.lastLine - keywordLines.firstLine;
+        }
+    }
+
+    for ( QTextBlock block = firstBlock; block.isValid() && block != endBlock; block = block.next() )
+    {
+        const int       bodyBlockCount = bodyBlockCounts.value( block.blockNumber(), 0 );
+        FoldRegionData* foldData       = dynamic_cast<FoldRegionData*>( block.userData() );
+        if ( foldData && foldData->bodyBlockCount != bodyBlockCount )
+        {
+            const bool wasFolded = foldData->isFolded;
+            setFolded( block, false );
+            if ( bodyBlockCount > 0 )
+            {
+                foldData->bodyBlockCount = bodyBlockCount;
+                setFolded( block, wasFolded );
+            }
+            else
+            {
+                block.setUserData( nullptr );
+            }
+        }
+        else if ( !foldData && bodyBlockCount > 0 )
+        {
+            block.setUserData( new FoldRegionData( bodyBlockCount ) );
+        }
+    }
+
+    m_lineNumberArea->update();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Hide or show the body of a keyword. Hidden blocks get no layout lines, so they take no space and
+/// are never laid out, highlighted or painted.
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::setFolded( QTextBlock headerBlock, bool folded )
+{
+    FoldRegionData* foldData = dynamic_cast<FoldRegionData*>( headerBlock.userData() );
+    if ( !foldData || foldData->isFolded == folded )
+    {
+        return;
+    }
+    foldData->isFolded = folded;
+
+    QTextBlock firstBlock = headerBlock.next();
+    QTextBlock lastBlock  = firstBlock;
+    QTextBlock block      = firstBlock;
+    for ( int i = 0; i < foldData->bodyBlockCount && block.isValid(); ++i )
+    {
+        block.setVisible( !folded );
+        lastBlock = block;
+        block     = block.next();
+    }
+
+    if ( !firstBlock.isValid() )
+    {
+        return;
+    }
+
+    // Keep the cursor out of folded text
+    if ( folded )
+    {
+        const int cursorBlockNumber = textCursor().blockNumber();
+        if ( cursorBlockNumber > headerBlock.blockNumber() && cursorBlockNumber <= lastBlock.blockNumber() )
+        {
+            QTextCursor cursor = textCursor();
+            cursor.setPosition( headerBlock.position() );
+            setTextCursor( cursor );
+        }
+    }
+
+    document()->markContentsDirty( firstBlock.position(), lastBlock.position() + lastBlock.length() - firstBlock.position() );
+
+    viewport()->update();
+    m_lineNumberArea->update();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::toggleFold( int blockNumber )
+{
+    QTextBlock      block    = document()->findBlockByNumber( blockNumber );
+    FoldRegionData* foldData = dynamic_cast<FoldRegionData*>( block.userData() );
+    if ( foldData )
+    {
+        setFolded( block, !foldData->isFolded );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::foldAll()
+{
+    QTextBlock block = document()->begin();
+    while ( block.isValid() )
+    {
+        FoldRegionData* foldData = dynamic_cast<FoldRegionData*>( block.userData() );
+        if ( foldData )
+        {
+            setFolded( block, true );
+            block = document()->findBlockByNumber( block.blockNumber() + foldData->bodyBlockCount + 1 );
+        }
+        else
+        {
+            block = block.next();
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::unfoldAll()
+{
+    QTextBlock block = document()->begin();
+    while ( block.isValid() )
+    {
+        FoldRegionData* foldData = dynamic_cast<FoldRegionData*>( block.userData() );
+        if ( foldData )
+        {
+            setFolded( block, false );
+            block = document()->findBlockByNumber( block.blockNumber() + foldData->bodyBlockCount + 1 );
+        }
+        else
+        {
+            block = block.next();
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+int RimDataDeckTextEditor::foldMarkerWidth() const
+{
+    return fontMetrics().height();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Position just after the first line break at or beyond offset + chunkSize
+//--------------------------------------------------------------------------------------------------
+int RimDataDeckTextEditor::nextChunkEnd( int offset, int chunkSize ) const
+{
+    const int textLength = static_cast<int>( m_pendingText.size() );
+
+    int end = std::min( offset + chunkSize, textLength );
+    if ( end < textLength )
+    {
+        int lineBreak = static_cast<int>( m_pendingText.indexOf( '\n', end ) );
+        end           = lineBreak < 0 ? textLength : lineBreak + 1;
+    }
+
+    return end;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -274,6 +814,14 @@ bool RimDataDeckTextEditor::hasUnsavedChanges() const
     return document()->isModified();
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString RimDataDeckTextEditor::takeLoadedText()
+{
+    return std::exchange( m_loadedText, QString() );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -287,7 +835,7 @@ int RimDataDeckTextEditor::lineNumberAreaWidth()
         ++digits;
     }
 
-    int space = 10 + fontMetrics().horizontalAdvance( QLatin1Char( '9' ) ) * digits;
+    int space = 10 + fontMetrics().horizontalAdvance( QLatin1Char( '9' ) ) * digits + foldMarkerWidth();
 
     return space;
 }
@@ -312,6 +860,26 @@ void RimDataDeckTextEditor::updateLineNumberArea( const QRect& rect, int dy )
         m_lineNumberArea->update( 0, rect.y(), m_lineNumberArea->width(), rect.height() );
 
     if ( rect.contains( viewport()->rect() ) ) updateLineNumberAreaWidth( 0 );
+
+    updateHighlightPriority();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Let the highlighter format the visible blocks and one screenful above and below first
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::updateHighlightPriority()
+{
+    if ( !m_syntaxHighlighter )
+    {
+        return;
+    }
+
+    // The last visible block is looked up by position, folded regions make block numbers jump
+    const int firstBlockNumber = firstVisibleBlock().blockNumber();
+    const int lastBlockNumber  = cursorForPosition( QPoint( 0, viewport()->height() - 1 ) ).blockNumber();
+    const int visibleLines     = viewport()->height() / std::max( 1, fontMetrics().height() ) + 1;
+
+    m_syntaxHighlighter->setPriorityRange( firstBlockNumber - visibleLines, lastBlockNumber + visibleLines );
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -325,12 +893,26 @@ void RimDataDeckTextEditor::resizeEvent( QResizeEvent* e )
     m_lineNumberArea->setGeometry( QRect( cr.left(), cr.top(), lineNumberAreaWidth(), cr.height() ) );
 }
 
+//--------------------------------------------------------------------------------------------------
+/// The first viewport repaint after a key press completes the keystroke-to-paint latency
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::paintEvent( QPaintEvent* event )
+{
+    QPlainTextEdit::paintEvent( event );
+
+    if ( m_keyPressTimer.isValid() )
+    {
+        DataDeckMetrics::recordKeystrokeLatency( m_keyPressTimer.nsecsElapsed() );
+        m_keyPressTimer.invalidate();
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::highlightCurrentLine()
 {
-    QList<QTextEdit::ExtraSelection> extraSelections;
+    QList<QTextEdit::ExtraSelection> extraSelections = m_problemSelections;
 
     if ( !isReadOnly() )
     {
@@ -353,6 +935,8 @@ void RimDataDeckTextEditor::highlightCurrentLine()
 //--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::lineNumberAreaPaintEvent( QPaintEvent* event )
 {
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::lineNumberAreaPaintEvent" );
+
     QPainter painter( m_lineNumberArea );
     painter.fillRect( event->rect(), palette().color( QPalette::Base ) );
 
@@ -361,22 +945,126 @@ void RimDataDeckTextEditor::lineNumberAreaPaintEvent( QPaintEvent* event )
     int        top         = qRound( blockBoundingGeometry( block ).translated( contentOffset() ).top() );
     int        bottom      = top + qRound( blockBoundingRect( block ).height() );
 
+    const int markerSize = foldMarkerWidth();
+    const int markerLeft = m_lineNumberArea->width() - markerSize;
+
     while ( block.isValid() && top <= event->rect().bottom() )
     {
+        FoldRegionData* foldData = dynamic_cast<FoldRegionData*>( block.userData() );
+
         if ( block.isVisible() && bottom >= event->rect().top() )
         {
+            auto problem = m_problemBlocks.constFind( blockNumber );
+            if ( problem != m_problemBlocks.constEnd() )
+            {
+                QColor color = problem.value() == DataDeckProblem::Severity::ERROR ? QColor( 220, 50, 47 ) : QColor( 230, 160, 0 );
+                painter.fillRect( 0, top, 3, fontMetrics().height(), color );
+            }
+
             QString number = QString::number( blockNumber + 1 );
             painter.setPen( Qt::gray );
-            painter.drawText( 0, top, m_lineNumberArea->width() - 8, fontMetrics().height(), Qt::AlignRight, number );
+            painter.drawText( 0, top, markerLeft - 4, fontMetrics().height(), Qt::AlignRight, number );
+
+            if ( foldData )
+            {
+                // Right-pointing triangle when folded, down-pointing when expanded
+                QRectF    r( markerLeft + markerSize * 0.25, top + markerSize * 0.25, markerSize * 0.5, markerSize * 0.5 );
+                QPolygonF triangle;
+                if ( foldData->isFolded )
+                    triangle << r.topLeft() << r.bottomLeft() << QPointF( r.right(), r.center().y() );
+                else
+                    triangle << r.topLeft() << r.topRight() << QPointF( r.center().x(), r.bottom() );
+
+                painter.save();
+                painter.setRenderHint( QPainter::Antialiasing );
+                painter.setPen( Qt::NoPen );
+                painter.setBrush( Qt::gray );
+                painter.drawPolygon( triangle );
+                painter.restore();
+            }
+        }
+
+        // Jump over folded bodies instead of walking their blocks
+        if ( foldData && foldData->isFolded )
+        {
+            blockNumber += foldData->bodyBlockCount + 1;
+            block = document()->findBlockByNumber( blockNumber );
+        }
+        else
+        {
+            block = block.next();
+            ++blockNumber;
         }
 
-        block  = block.next();
         top    = bottom;
         bottom = top + qRound( blockBoundingRect( block ).height() );
-        ++blockNumber;
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Mark the lines of the problems in the gutter and underline them. Problems without a line or in
+/// other files are expected to be filtered out by the caller.
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::setProblems( const QList<DataDeckProblem>& problems )
+{
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::setProblems" );
+
+    m_problemBlocks.clear();
+    m_problemSelections.clear();
+
+    for ( const DataDeckProblem& problem : problems )
+    {
+        if ( problem.line <= 0 || problem.severity == DataDeckProblem::Severity::INFO )
+        {
+            continue;
+        }
+
+        const int blockNumber = problem.line - 1;
+        auto      existing    = m_problemBlocks.find( blockNumber );
+        if ( existing != m_problemBlocks.end() )
+        {
+            // Keep the most severe, errors sort first
+            existing.value() = std::min( existing.value(), problem.severity );
+            continue;
+        }
+        m_problemBlocks.insert( blockNumber, problem.severity );
+    }
+
+    for ( auto it = m_problemBlocks.constBegin(); it != m_problemBlocks.constEnd(); ++it )
+    {
+        QTextBlock block = document()->findBlockByNumber( it.key() );
+        if ( !block.isValid() )
+        {
+            continue;
+        }
+
+        QTextEdit::ExtraSelection selection;
+        selection.format.setUnderlineStyle( QTextCharFormat::WaveUnderline );
+        selection.format.setUnderlineColor( it.value() == DataDeckProblem::Severity::ERROR ? QColor( 220, 50, 47 ) : QColor( 230, 160, 0 ) );
+        selection.cursor = QTextCursor( block );
+        selection.cursor.movePosition( QTextCursor::EndOfBlock, QTextCursor::KeepAnchor );
+        m_problemSelections.append( selection );
+    }
+
+    highlightCurrentLine();
+    m_lineNumberArea->update();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Clicking the fold marker of a keyword toggles the fold
+//--------------------------------------------------------------------------------------------------
+void RimDataDeckTextEditor::lineNumberAreaMousePressEvent( QMouseEvent* event )
+{
+    if ( event->button() != Qt::LeftButton || event->position().x() < m_lineNumberArea->width() - foldMarkerWidth() )
+    {
+        return;
+    }
+
+    // The line number area and the viewport share the vertical coordinate system
+    QTextBlock block = cursorForPosition( QPoint( 0, qRound( event->position().y() ) ) ).block();
+    toggleFold( block.blockNumber() );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -390,6 +1078,8 @@ void RimDataDeckTextEditor::setKeywordHelpWidget( KeywordHelpWidget* helpWidget
 //--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::keyPressEvent( QKeyEvent* event )
 {
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::keyPressEvent" );
+
     if ( m_completer && m_completer->popup()->isVisible() )
     {
         // Handle completer popup keys
@@ -412,7 +1102,17 @@ void RimDataDeckTextEditor::keyPressEvent( QKeyEvent* event )
     // Always process the key event first (except for the shortcut)
     if ( !isShortcut )
     {
+        const int revision       = document()->revision();
+        const int cursorPosition = textCursor().position();
+
+        m_keyPressTimer.start();
         QPlainTextEdit::keyPressEvent( event );
+
+        // Only keys that change the text or move the cursor are followed by a repaint to measure
+        if ( document()->revision() == revision && textCursor().position() == cursorPosition )
+        {
+            m_keyPressTimer.invalidate();
+        }
     }
 
     // Early return if no completer
@@ -462,6 +1162,8 @@ void RimDataDeckTextEditor::keyPressEvent( QKeyEvent* event )
 //--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::onCursorPositionChanged()
 {
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::onCursorPositionChanged" );
+
     // Start/restart the help update timer
     if ( m_helpUpdateTimer )
     {
@@ -474,6 +1176,8 @@ void RimDataDeckTextEditor::onCursorPositionChanged()
 //--------------------------------------------------------------------------------------------------
 void RimDataDeckTextEditor::updateKeywordHelp()
 {
+    DATADECK_TRACE_SCOPE( "editor", "RimDataDeckTextEditor::updateKeywordHelp" );
+
     if ( !m_helpWidget )
         return;
 
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "DataDeckProblem.h"
+
+#include <QElapsedTimer>
+#include <QMap>
 #include <QPlainTextEdit>
+#include <QTextCursor>
 #include <QWidget>
 #include <QTimer>
 
@@ -9,8 +14,12 @@ class DataFileSyntaxHighlighter;
 class DataFileCompleter;
 class KeywordHelpWidget;
 class LineNumberArea;
+class QTextBlock;
 class RimDataKeyword; // Forward declaration for RimDataKeyword
 
+template <typename T>
+class QFutureWatcher;
+
 enum ColumnType { String, Integer, Double };
 
 struct ColumnInfo {
@@ -33,22 +42,43 @@ public:
 
     void setDataDeck( RimDataDeck* dataDeck );
     RimDataDeck* dataDeck() const { return m_dataDeck; }
+    DataFileCompleter* completer() const { return m_completer; }
 
     void loadFromDeck();
     bool hasUnsavedChanges() const;
+    bool isLoading() const { return m_isLoading; }
+
+    // The text of the last completed load, equal to toPlainText() until the first edit. Handed over
+    // once, so the validator does not read the whole document again.
+    QString takeLoadedText();
+
+    // Estimated bytes of the document, and of the text still to be appended while loading
+    qint64 documentMemoryBytes() const;
 
     void lineNumberAreaPaintEvent( QPaintEvent* event );
+    void lineNumberAreaMousePressEvent( QMouseEvent* event );
     int  lineNumberAreaWidth();
 
+    // Keyword folding
+    void toggleFold( int blockNumber );
+    void foldAll();
+    void unfoldAll();
+
+    // Validation markers for problems in the displayed file
+    void setProblems( const QList<DataDeckProblem>& problems );
+
     void setKeywordHelpWidget( KeywordHelpWidget* helpWidget );
     void alignColumnsForKeyword( RimDataKeyword* keyword ); // New method
 
 signals:
     void modificationChanged( bool changed );
+    void loadProgress( int percent );
+    void loadFinished();
 
 protected:
     void resizeEvent( QResizeEvent* event ) override;
     void keyPressEvent( QKeyEvent* event ) override;
+    void paintEvent( QPaintEvent* event ) override;
 
 private slots:
     void updateLineNumberAreaWidth( int newBlockCount );
@@ -56,18 +86,59 @@ private slots:
     void updateLineNumberArea( const QRect& rect, int dy );
     void onCursorPositionChanged();
     void updateKeywordHelp();
+    void appendNextChunk();
+    void onContentsChange( int position, int charsRemoved, int charsAdded );
+    void updateFoldRegions();
 
 private:
     void setupCompleter();
     void insertCompletion( const QString& completion );
     QString textUnderCursor() const;
+    void updateHighlightPriority();
+    int  nextChunkEnd( int offset, int chunkSize ) const;
+    void onTextRead( const QString& text );
+    void onFoldScanFinished( const QList<QPair<int, int>>& foldRegions );
+    void finishLoadIfComplete();
+    void finishProgressiveLoad();
+    void applyPendingFoldRegions();
+    void setFolded( QTextBlock headerBlock, bool folded );
+    int  foldMarkerWidth() const;
     
+    // Progressive loading: the text is read on a worker thread, the first screenfuls are shown when it
+    // arrives and the rest is appended from the event loop. Fold regions are scanned on a worker thread.
+    static constexpr int INITIAL_CHUNK_SIZE = 64 * 1024;
+    static constexpr int APPEND_CHUNK_SIZE  = 512 * 1024;
+
+    // Keywords with more data lines than this are folded when loaded
+    static constexpr int FOLD_BY_DEFAULT_LINES = 100;
+
     RimDataDeck*                m_dataDeck;
     DataFileSyntaxHighlighter*  m_syntaxHighlighter;
     DataFileCompleter*          m_completer;
     KeywordHelpWidget*          m_helpWidget;
     QWidget*                    m_lineNumberArea;
     QTimer*                     m_helpUpdateTimer;
+
+    QTimer*                     m_chunkLoadTimer;
+    QFutureWatcher<QString>*    m_readWatcher;     // Null when no read is pending
+    QFutureWatcher<QList<QPair<int, int>>>* m_foldScanWatcher; // Null when no scan is pending
+    QString                     m_pendingText;
+    QString                     m_loadedText;
+    int                         m_pendingOffset;
+    bool                        m_isLoading;
+
+    QList<QPair<int, int>>      m_pendingFoldRegions; // Keyword block ranges not yet attached to the document
+    int                         m_nextFoldRegion;
+
+    // Edited text whose fold regions are recomputed when the timer fires. Cursors follow later edits.
+    QTimer*                     m_foldUpdateTimer;
+    QTextCursor                 m_foldDirtyStart;
+    QTextCursor                 m_foldDirtyEnd;
+
+    QElapsedTimer               m_keyPressTimer; // Valid from a key press until the repaint showing it
+
+    QMap<int, DataDeckProblem::Severity> m_problemBlocks; // Block number to most severe problem
+    QList<QTextEdit::ExtraSelection>     m_problemSelections;
 };
 
 //==================================================================================================
@@ -86,6 +157,7 @@ public:
 
 protected:
     void paintEvent( QPaintEvent* event ) override { m_textEditor->lineNumberAreaPaintEvent( event ); }
+    void mousePressEvent( QMouseEvent* event ) override { m_textEditor->lineNumberAreaMousePressEvent( event ); }
 
 private:
     RimDataDeckTextEditor* m_textEditor;
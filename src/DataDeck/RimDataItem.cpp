@@ -1,4 +1,5 @@
 #include "RimDataItem.h"
+#include "DataDeckMemoryUsage.h"
 
 #include "cafPdmUiOrdering.h"
 
@@ -94,6 +95,15 @@ QString RimDataItem::valueAsString() const
     return formatValue();
 }
 
+//--------------------------------------------------------------------------------------------------
+/// The value is formatted on demand from the deck item, so only the name strings are held here
+//--------------------------------------------------------------------------------------------------
+qint64 RimDataItem::estimatedMemoryBytes() const
+{
+    return sizeof( RimDataItem ) + DataDeckMemoryUsage::pdmOverheadBytes( *this ) + DataDeckMemoryUsage::stringBytes( m_itemName() ) +
+           DataDeckMemoryUsage::stringBytes( m_dataType() );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
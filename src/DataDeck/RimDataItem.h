@@ -28,6 +28,8 @@ public:
     QString dataType() const;
     QString valueAsString() const;
 
+    qint64 estimatedMemoryBytes() const;
+
 protected:
     void defineUiOrdering( QString uiConfigName, caf::PdmUiOrdering& uiOrdering ) override;
 
@@ -1,4 +1,5 @@
 #include "RimDataKeyword.h"
+#include "DataDeckMemoryUsage.h"
 #include "RimDataItem.h"
 
 #include "cafPdmUiOrdering.h"
@@ -15,7 +16,8 @@ CAF_PDM_SOURCE_INIT( RimDataKeyword, "DataKeyword" );
 ///
 //--------------------------------------------------------------------------------------------------
 RimDataKeyword::RimDataKeyword()
-    : m_deckKeyword( nullptr )
+    : m_validationProblemCount( 0 )
+    , m_deckKeyword( nullptr )
 {
     CAF_PDM_InitObject( "Keyword", "", "", "" );
 
@@ -36,6 +38,17 @@ RimDataKeyword::RimDataKeyword()
     m_content.uiCapability()->setUiReadOnly( true );
     m_content.uiCapability()->setUiEditorTypeName( caf::PdmUiTextEditor::uiEditorTypeName() );
 
+    CAF_PDM_InitField( &m_validation, "Validation", QString( "" ), "Validation", "", "", "" );
+    m_validation.uiCapability()->setUiReadOnly( true );
+    m_validation.uiCapability()->setUiEditorTypeName( caf::PdmUiTextEditor::uiEditorTypeName() );
+
+    CAF_PDM_InitField( &m_difference, "Difference", QString( "" ), "Difference", "", "", "" );
+    m_difference.uiCapability()->setUiReadOnly( true );
+
+    CAF_PDM_InitField( &m_arrayComparison, "ArrayComparison", QString( "" ), "Array Comparison", "", "", "" );
+    m_arrayComparison.uiCapability()->setUiReadOnly( true );
+    m_arrayComparison.uiCapability()->setUiEditorTypeName( caf::PdmUiTextEditor::uiEditorTypeName() );
+
     // Text position tracking
     CAF_PDM_InitField( &m_startLine, "StartLine", -1, "Start Line", "", "", "" );
     m_startLine.uiCapability()->setUiHidden( true );
@@ -80,6 +93,7 @@ void RimDataKeyword::setDeckKeyword( const Opm::DeckKeyword* deckKeyword )
         if ( m_isLargeArray )
         {
             // For large arrays, just show summary
+            m_items.deleteChildren();
             m_summary = generateSummary();
         }
         else
@@ -90,7 +104,33 @@ void RimDataKeyword::setDeckKeyword( const Opm::DeckKeyword* deckKeyword )
         }
 
         // Update UI name to show keyword name
-        setUiName( m_keywordName );
+        updateUiName();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Point the node at an identical keyword from a new parse of the deck. The item nodes are kept and
+/// pointed at the new items, which only works because the content, and so the item layout, is equal.
+/// Validation problems are dropped, a problem can depend on the other keywords, which may have changed.
+//--------------------------------------------------------------------------------------------------
+void RimDataKeyword::rebindDeckKeyword( const Opm::DeckKeyword* deckKeyword )
+{
+    m_deckKeyword = deckKeyword;
+    setValidationProblems( {} );
+
+    if ( !m_deckKeyword || m_items.empty() )
+    {
+        return;
+    }
+
+    size_t itemIndex = 0;
+    for ( size_t recIdx = 0; recIdx < m_deckKeyword->size() && itemIndex < m_items.size(); ++recIdx )
+    {
+        const auto& record = m_deckKeyword->getRecord( recIdx );
+        for ( size_t i = 0; i < record.size() && itemIndex < m_items.size(); ++i )
+        {
+            m_items[itemIndex++]->setDeckItem( &record.getItem( i ) );
+        }
     }
 }
 
@@ -143,6 +183,126 @@ int RimDataKeyword::endLine() const
     return m_endLine;
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataKeyword::setValidationProblems( const QList<DataDeckProblem>& problems )
+{
+    QStringList messages;
+    for ( const DataDeckProblem& problem : problems )
+    {
+        messages.append( QString( "%1: %2" ).arg( DataDeckProblem::severityToString( problem.severity ) ).arg( problem.message ) );
+    }
+
+    const QString validation = messages.join( "\n" );
+    if ( validation == m_validation() )
+    {
+        return;
+    }
+
+    m_validation             = validation;
+    m_validationProblemCount = static_cast<int>( problems.size() );
+
+    setUiToolTip( validation );
+    updateUiName();
+    updateConnectedEditors();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool RimDataKeyword::hasValidationProblems() const
+{
+    return !m_validation().isEmpty();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The marker is shown in the tree, like "changed", the description in the property view
+//--------------------------------------------------------------------------------------------------
+void RimDataKeyword::setDifference( const QString& marker, const QString& description )
+{
+    if ( marker == m_differenceMarker && description == m_difference() )
+    {
+        return;
+    }
+
+    m_differenceMarker = marker;
+    m_difference       = description;
+
+    updateUiName();
+    updateConnectedEditors();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+QString RimDataKeyword::difference() const
+{
+    return m_difference;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataKeyword::setComparedKeyword( RimDataKeyword* keyword )
+{
+    m_comparedKeyword = keyword;
+    m_arrayComparison = "";
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+RimDataKeyword* RimDataKeyword::comparedKeyword() const
+{
+    return m_comparedKeyword;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void RimDataKeyword::setArrayComparison( const QString& text )
+{
+    m_arrayComparison = text;
+    updateConnectedEditors();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 RimDataKeyword::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof( RimDataKeyword ) + DataDeckMemoryUsage::pdmOverheadBytes( *this );
+    for ( const QString* text : { &m_keywordName(), &m_summary(), &m_validation(), &m_difference(), &m_arrayComparison(), &m_differenceMarker } )
+    {
+        bytes += DataDeckMemoryUsage::stringBytes( *text );
+    }
+
+    bytes += static_cast<qint64>( m_items.size() ) * static_cast<qint64>( sizeof( RimDataItem* ) );
+    for ( const RimDataItem* item : m_items )
+    {
+        bytes += item->estimatedMemoryBytes();
+    }
+    return bytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Keyword name with the comparison marker and the problem count, so both are visible in the tree
+//--------------------------------------------------------------------------------------------------
+void RimDataKeyword::updateUiName()
+{
+    QString name = m_keywordName;
+    if ( !m_differenceMarker.isEmpty() )
+    {
+        name += QString( " [%1]" ).arg( m_differenceMarker );
+    }
+    if ( m_validationProblemCount > 0 )
+    {
+        name += QString( " (%1 problem%2)" ).arg( m_validationProblemCount ).arg( m_validationProblemCount > 1 ? "s" : "" );
+    }
+    setUiName( name );
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -151,6 +311,21 @@ void RimDataKeyword::defineUiOrdering( QString uiConfigName, caf::PdmUiOrdering&
     uiOrdering.add( &m_keywordName );
     uiOrdering.add( &m_recordCount );
 
+    if ( hasValidationProblems() )
+    {
+        uiOrdering.add( &m_validation );
+    }
+
+    if ( !m_difference().isEmpty() )
+    {
+        uiOrdering.add( &m_difference );
+    }
+
+    if ( !m_arrayComparison().isEmpty() )
+    {
+        uiOrdering.add( &m_arrayComparison );
+    }
+
     if ( m_isLargeArray )
     {
         uiOrdering.add( &m_summary );
@@ -185,6 +360,15 @@ void RimDataKeyword::defineEditorAttribute( const caf::PdmFieldHandle* field, QS
             textEditAttr->font = font;
         }
     }
+    else if ( field == &m_validation || field == &m_arrayComparison )
+    {
+        auto* textEditAttr = dynamic_cast<caf::PdmUiTextEditorAttribute*>( attribute );
+        if ( textEditAttr )
+        {
+            textEditAttr->textMode   = caf::PdmUiTextEditorAttribute::PLAIN;
+            textEditAttr->heightHint = 80;
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "DataDeckProblem.h"
+
 #include "cafPdmObject.h"
 #include "cafPdmField.h"
 #include "cafPdmChildArrayField.h"
+#include "cafPdmPointer.h"
 #include "cafPdmProxyValueField.h"
 
 #include <memory>
@@ -26,6 +29,7 @@ public:
     ~RimDataKeyword() override;
 
     virtual void setDeckKeyword( const Opm::DeckKeyword* deckKeyword );
+    void         rebindDeckKeyword( const Opm::DeckKeyword* deckKeyword );
 
     QString keywordName() const;
     int     recordCount() const;
@@ -36,16 +40,33 @@ public:
     int     startLine() const;
     int     endLine() const;
 
+    // Problems found by the deck validators for this keyword
+    void    setValidationProblems( const QList<DataDeckProblem>& problems );
+    bool    hasValidationProblems() const;
+
+    // Result of comparing the deck with another deck, empty if unchanged or not compared
+    void    setDifference( const QString& marker, const QString& description );
+    QString difference() const;
+
+    // The matching keyword in the compared deck, set for changed keywords
+    void            setComparedKeyword( RimDataKeyword* keyword );
+    RimDataKeyword* comparedKeyword() const;
+    void            setArrayComparison( const QString& text );
+
+    // Estimated bytes of this node and its items, the deck keyword is accounted for by the deck
+    qint64 estimatedMemoryBytes() const;
+
+    const Opm::DeckKeyword* deckKeyword() const { return m_deckKeyword; }
+
     static constexpr size_t LARGE_ARRAY_THRESHOLD = 100;
 
 protected:
     void defineUiOrdering( QString uiConfigName, caf::PdmUiOrdering& uiOrdering ) override;
     void defineEditorAttribute( const caf::PdmFieldHandle* field, QString uiConfigName, caf::PdmUiEditorAttribute* attribute ) override;
-    
-    const Opm::DeckKeyword* deckKeyword() const { return m_deckKeyword; }
 
 private:
     void buildItemsFromKeyword();
+    void updateUiName();
     QString generateSummary() const;
     QString formatKeywordContent() const;
 
@@ -55,6 +76,12 @@ private:
     caf::PdmField<bool>                         m_isLargeArray;
     caf::PdmField<QString>                      m_summary;
     caf::PdmProxyValueField<QString>            m_content;
+    caf::PdmField<QString>                      m_validation;
+    caf::PdmField<QString>                      m_difference;
+    QString                                     m_differenceMarker;
+    int                                         m_validationProblemCount;
+    caf::PdmPointer<RimDataKeyword>             m_comparedKeyword;
+    caf::PdmField<QString>                      m_arrayComparison;
 
     // Text position tracking
     caf::PdmField<int>                          m_startLine;
@@ -1,4 +1,5 @@
 #include "RimDataSection.h"
+#include "DataDeckMemoryUsage.h"
 #include "RimDataKeyword.h"
 
 #include "cafPdmUiOrdering.h"
@@ -61,6 +62,21 @@ void RimDataSection::addKeyword( RimDataKeyword* keyword )
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Detach all keywords without deleting them, the caller takes ownership
+//--------------------------------------------------------------------------------------------------
+std::vector<RimDataKeyword*> RimDataSection::takeKeywords()
+{
+    std::vector<RimDataKeyword*> keywords;
+    for ( RimDataKeyword* keyword : m_keywords )
+    {
+        keywords.push_back( keyword );
+    }
+    m_keywords.clearWithoutDelete();
+    m_keywordCount = 0;
+    return keywords;
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -85,6 +101,21 @@ int RimDataSection::keywordCount() const
     return m_keywordCount;
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+qint64 RimDataSection::estimatedMemoryBytes() const
+{
+    qint64 bytes = sizeof( RimDataSection ) + DataDeckMemoryUsage::pdmOverheadBytes( *this ) + DataDeckMemoryUsage::stringBytes( m_sectionName() );
+
+    bytes += static_cast<qint64>( m_keywords.size() ) * static_cast<qint64>( sizeof( RimDataKeyword* ) );
+    for ( const RimDataKeyword* keyword : m_keywords )
+    {
+        bytes += keyword->estimatedMemoryBytes();
+    }
+    return bytes;
+}
+
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
@@ -4,6 +4,8 @@
 #include "cafPdmField.h"
 #include "cafPdmChildArrayField.h"
 
+#include <vector>
+
 class RimDataKeyword;
 
 //==================================================================================================
@@ -34,10 +36,12 @@ public:
     void setSectionType( SectionType type );
     void setSectionName( const QString& name );
     void addKeyword( RimDataKeyword* keyword );
+    std::vector<RimDataKeyword*> takeKeywords();
 
     QString         sectionName() const;
     SectionType     sectionType() const;
     int             keywordCount() const;
+    qint64          estimatedMemoryBytes() const; // Including the keyword nodes
     const caf::PdmChildArrayField<RimDataKeyword*>& keywords() const;
 
     static QString  sectionTypeToString( SectionType type );
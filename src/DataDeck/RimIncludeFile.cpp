@@ -1,5 +1,6 @@
 #include "RimIncludeFile.h"
 
+#include "DataDeckTrace.h"
 #include "RimDataDeck.h"
 
 #include "cafPdmUiOrdering.h"
@@ -14,6 +15,7 @@ CAF_PDM_SOURCE_INIT(RimIncludeFile, "IncludeFile");
 /// 
 //--------------------------------------------------------------------------------------------------
 RimIncludeFile::RimIncludeFile()
+    : m_fileSize(0)
 {
     CAF_PDM_InitObject("Include File", ":/File16x16.png");
 
@@ -84,6 +86,14 @@ bool RimIncludeFile::fileExists() const
     return m_fileExists;
 }
 
+//--------------------------------------------------------------------------------------------------
+/// 
+//--------------------------------------------------------------------------------------------------
+qint64 RimIncludeFile::fileSize() const
+{
+    return m_fileSize;
+}
+
 //--------------------------------------------------------------------------------------------------
 /// 
 //--------------------------------------------------------------------------------------------------
@@ -93,20 +103,36 @@ QString RimIncludeFile::fileName() const
 }
 
 //--------------------------------------------------------------------------------------------------
-/// 
+/// Load the include file content. Decks already parsed by a background loader are keyed by resolved
+/// path; a null entry means the loader failed to parse the file.
 //--------------------------------------------------------------------------------------------------
-bool RimIncludeFile::loadContent()
+bool RimIncludeFile::loadContent(const QMap<QString, std::shared_ptr<Opm::Deck>>& preparsedDecks,
+                                 const QMap<QString, DataDeckFileScan>& fileScans)
 {
+    DATADECK_TRACE_SCOPE_DETAIL( "include", "RimIncludeFile::loadContent", resolvedPath() );
+
     if (!m_fileExists)
     {
         return false;
     }
 
+    auto preparsed = preparsedDecks.constFind(m_resolvedPath);
+    if (preparsed != preparsedDecks.constEnd() && !preparsed.value())
+    {
+        return false;
+    }
+
     if (m_content == nullptr)
     {
         m_content = new RimDataDeck();
     }
 
+    if (preparsed != preparsedDecks.constEnd())
+    {
+        m_content->setDeck(preparsed.value(), m_resolvedPath, preparsedDecks, fileScans);
+        return true;
+    }
+
     return m_content->loadFromFile(m_resolvedPath);
 }
 
@@ -125,6 +151,7 @@ void RimIncludeFile::updateFileStatus()
 {
     QFileInfo info(m_resolvedPath);
     m_fileExists = info.exists() && info.isFile();
+    m_fileSize = m_fileExists ? info.size() : 0;
     
     // Update UI name to show status
     QString uiName = m_fileName;
@@ -176,7 +203,7 @@ void RimIncludeFile::defineUiTreeOrdering(caf::PdmUiTreeOrdering& uiTreeOrdering
 //--------------------------------------------------------------------------------------------------
 /// 
 //--------------------------------------------------------------------------------------------------
-QString RimIncludeFile::resolveAbsolutePath(const QString& includePath, const QString& basePath) const
+QString RimIncludeFile::resolveAbsolutePath(const QString& includePath, const QString& basePath)
 {
     QFileInfo info(includePath);
     if (info.isAbsolute())
@@ -4,7 +4,17 @@
 #include "cafPdmField.h"
 #include "cafPdmChildField.h"
 
+#include "DataDeckFileScan.h"
+
 #include <QFileInfo>
+#include <QMap>
+
+#include <memory>
+
+namespace Opm
+{
+class Deck;
+}
 
 class RimDataDeck;
 
@@ -24,19 +34,20 @@ public:
     QString resolvedPath() const;
     bool fileExists() const;
     QString fileName() const;
+    qint64 fileSize() const;          // Bytes on disk when the status was last updated
     
-    bool loadContent();
+    bool loadContent(const QMap<QString, std::shared_ptr<Opm::Deck>>& preparsedDecks = {},
+                     const QMap<QString, DataDeckFileScan>& fileScans = {});
     RimDataDeck* content() const;
     
     void updateFileStatus();
 
+    static QString resolveAbsolutePath(const QString& includePath, const QString& basePath);
+
 protected:
     void defineUiOrdering(QString uiConfigName, caf::PdmUiOrdering& uiOrdering) override;
     void defineUiTreeOrdering(caf::PdmUiTreeOrdering& uiTreeOrdering, QString uiConfigName = "") override;
 
-private:
-    QString resolveAbsolutePath(const QString& includePath, const QString& basePath) const;
-
 private:
     caf::PdmField<QString>                  m_includePath;      // Original path from INCLUDE statement
     caf::PdmField<QString>                  m_resolvedPath;     // Computed absolute path
@@ -45,4 +56,6 @@ private:
     caf::PdmField<QString>                  m_basePath;         // Base directory for relative paths
     
     caf::PdmChildField<RimDataDeck*>        m_content;          // Parsed content of included file
+
+    qint64                                  m_fileSize;
 };
\ No newline at end of file
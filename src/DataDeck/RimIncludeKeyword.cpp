@@ -1,4 +1,5 @@
 #include "RimIncludeKeyword.h"
+#include "DataDeckLogging.h"
 #include "RimIncludeFile.h"
 
 #include "cafPdmUiOrdering.h"
@@ -7,8 +8,6 @@
 #include "opm/input/eclipse/Deck/DeckRecord.hpp"
 #include "opm/input/eclipse/Deck/DeckItem.hpp"
 
-#include <QDebug>
-
 CAF_PDM_SOURCE_INIT(RimIncludeKeyword, "IncludeKeyword");
 
 //--------------------------------------------------------------------------------------------------
@@ -119,17 +118,17 @@ void RimIncludeKeyword::extractIncludePathFromKeyword()
     const Opm::DeckKeyword* deckKw = deckKeyword();
     if (!deckKw)
     {
-        qDebug() << "RimIncludeKeyword::extractIncludePathFromKeyword - No deck keyword";
+        qCDebug( logInclude ) << "RimIncludeKeyword::extractIncludePathFromKeyword - No deck keyword";
         return;
     }
 
-    qDebug() << "RimIncludeKeyword::extractIncludePathFromKeyword - Processing keyword with" << deckKw->size() << "records";
+    qCDebug( logInclude ) << "RimIncludeKeyword::extractIncludePathFromKeyword - Processing keyword with" << deckKw->size() << "records";
 
     // INCLUDE keyword should have one record with one string item (the file path)
     if (deckKw->size() > 0)
     {
         const auto& record = deckKw->getRecord(0);
-        qDebug() << "Record has" << record.size() << "items";
+        qCDebug( logInclude ) << "Record has" << record.size() << "items";
         if (record.size() > 0)
         {
             const auto& item = record.getItem(0);
@@ -137,16 +136,16 @@ void RimIncludeKeyword::extractIncludePathFromKeyword()
             {
                 QString path = QString::fromStdString(item.getTrimmedString(0));
                 m_includePath = path;
-                qDebug() << "Extracted include path:" << path;
+                qCDebug( logInclude ) << "Extracted include path:" << path;
             }
             else
             {
-                qDebug() << "Item has no value";
+                qCDebug( logInclude ) << "Item has no value";
             }
         }
     }
     else
     {
-        qDebug() << "No records in INCLUDE keyword";
+        qCDebug( logInclude ) << "No records in INCLUDE keyword";
     }
 }
\ No newline at end of file
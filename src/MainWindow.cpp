@@ -17,28 +17,88 @@
 #include "DataDeck/RicImportDataDeckFeature.h"
 #include "DataDeck/RimDataDeckTextEditor.h"
 #include "DataDeck/KeywordHelpWidget.h"
+#include "DataDeck/DataDeckLoader.h"
+#include "DataDeck/DataFileMappedViewer.h"
+#include "DataDeck/DataDeckValidator.h"
+#include "DataDeck/DataDeckProblemsWidget.h"
+#include "DataDeck/DataDeckProfileWidget.h"
+#include "DataDeck/DataArrayComparison.h"
+#include "DataDeck/DataDeckDiff.h"
+#include "DataDeck/DataDeckLogging.h"
+#include "DataDeck/DataDeckMetrics.h"
+#include "DataDeck/DataDeckPerformanceHud.h"
+#include "DataDeck/DataDeckRestoreQueue.h"
+#include "DataDeck/DataDeckTrace.h"
+#include "DataDeck/EditingSessionRecorder.h"
 
 // Qt includes
 #include <QAction>
+#include <QApplication>
+#include <QDialog>
+#include <QDialogButtonBox>
 #include <QDockWidget>
+#include <QDoubleSpinBox>
+#include <QElapsedTimer>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QFormLayout>
+#include <QFutureWatcher>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QProgressBar>
 #include <QSettings>
+#include <QSignalBlocker>
+#include <QStackedWidget>
 #include <QStatusBar>
 #include <QTextBlock>
 #include <QTextCursor>
 #include <QTextDocument>
 #include <QToolBar>
+#include <QToolButton>
+#include <QtConcurrent/QtConcurrentRun>
 
 // opm-common includes
-#include "opm/input/eclipse/Parser/Parser.hpp"
-#include "opm/input/eclipse/Parser/ParseContext.hpp"
-#include "opm/input/eclipse/Parser/InputErrorAction.hpp"
 #include "opm/input/eclipse/Deck/Deck.hpp"
 
+namespace
+{
+struct SyncParseResult
+{
+    std::shared_ptr<Opm::Deck> deck;
+    QList<DataDeckProblem>     problems;
+};
+
+//--------------------------------------------------------------------------------------------------
+/// Parse editor text next to the deck, so relative include paths resolve as for the deck itself
+//--------------------------------------------------------------------------------------------------
+SyncParseResult parseSyncText( const QString& text, const QString& deckFilePath )
+{
+    SyncParseResult result;
+
+    const QString tempFilePath = deckFilePath + ".temp";
+    QFile         tempFile( tempFilePath );
+    if ( !tempFile.open( QIODevice::WriteOnly | QIODevice::Text ) )
+    {
+        DataDeckProblem problem;
+        problem.message  = "Failed to create temporary file for parsing";
+        problem.filePath = deckFilePath;
+        result.problems.append( problem );
+        return result;
+    }
+
+    QTextStream out( &tempFile );
+    out << text;
+    tempFile.close();
+
+    result.deck = DataDeckValidator::parseCollectingProblems( tempFilePath, result.problems );
+    DataDeckValidator::replaceFilePath( result.problems, tempFilePath, deckFilePath );
+
+    QFile::remove( tempFilePath );
+    return result;
+}
+} // namespace
+
 //==================================================================================================
 /// Project Document - Root object for the data object editor project
 //==================================================================================================
@@ -51,9 +111,17 @@ public:
     {
         CAF_PDM_InitObject( "Data Object Editor Project", "", "", "" );
         CAF_PDM_InitFieldNoDefault( &m_dataDecks, "DataDecks", "DATA Files", "", "", "" );
+
+        // UI state restored when the project is opened
+        CAF_PDM_InitField( &m_currentDataDeck, "CurrentDataDeck", QString( "" ), "Current DATA File", "", "", "" );
+        m_currentDataDeck.uiCapability()->setUiHidden( true );
+        CAF_PDM_InitField( &m_currentLine, "CurrentLine", 0, "Current Line", "", "", "" );
+        m_currentLine.uiCapability()->setUiHidden( true );
     }
 
-    caf::PdmChildArrayField<RimDataDeck*> m_dataDecks;
+    caf::PdmChildArrayField<RimDataDeck*> m_dataDecks; // References only, the decks are loaded on open
+    caf::PdmField<QString>                m_currentDataDeck;
+    caf::PdmField<int>                    m_currentLine;
 };
 
 CAF_PDM_SOURCE_INIT( ProjectDocument, "ProjectDocument" );
@@ -68,48 +136,87 @@ MainWindow::MainWindow()
     : m_pdmUiTreeView( nullptr )
     , m_pdmUiPropertyView( nullptr )
     , m_project( nullptr )
+    , m_centralStack( nullptr )
     , m_textEditor( nullptr )
+    , m_largeFileViewer( nullptr )
     , m_keywordHelpWidget( nullptr )
     , m_updatingFromTree( false )
+    , m_isSyncingTextToTree( false )
     , m_textEditorToolBar( nullptr )
     , m_syncTextToTreeAction( nullptr )
     , m_syncTreeToTextAction( nullptr )
     , m_recentFilesMenu( nullptr )
     , m_openLastUsedAction( nullptr )
+    , m_pendingRestoreLine( 0 )
+    , m_dataDeckLoader( nullptr )
+    , m_loadProgressBar( nullptr )
+    , m_cancelLoadButton( nullptr )
+    , m_textLoadProgressBar( nullptr )
+    , m_autoOpenLastFile( true )
+    , m_restoreQueue( nullptr )
+    , m_dataDeckValidator( nullptr )
+    , m_problemsWidget( nullptr )
+    , m_problemsDock( nullptr )
+    , m_profileWidget( nullptr )
+    , m_profileDock( nullptr )
+    , m_performanceHud( nullptr )
+    , m_performanceHudAction( nullptr )
+    , m_sessionRecorder( nullptr )
+    , m_recordSessionAction( nullptr )
 {
     sm_mainWindowInstance = this;
 
-    // Create text editor as central widget
-    m_textEditor = new RimDataDeckTextEditor( this );
-    setCentralWidget( m_textEditor );
+    // Validate the editor text on a worker thread while editing
+    m_dataDeckValidator = new DataDeckValidator( this );
+    connect( m_dataDeckValidator, &DataDeckValidator::validationStarted, this, &MainWindow::slotValidationStarted );
+    connect( m_dataDeckValidator, &DataDeckValidator::validationFinished, this, &MainWindow::slotValidationFinished );
+
+    // Parse DATA files on a worker thread
+    m_dataDeckLoader = new DataDeckLoader( this );
+    connect( m_dataDeckLoader, &DataDeckLoader::loadStarted, this, &MainWindow::slotDataDeckLoadStarted );
+    connect( m_dataDeckLoader, &DataDeckLoader::loadFinished, this, &MainWindow::slotDataDeckLoaded );
+    connect( m_dataDeckLoader, &DataDeckLoader::loadCanceled, this, &MainWindow::slotDataDeckLoadCanceled );
+
+    // Parse the decks of an opened project in parallel
+    m_restoreQueue = new DataDeckRestoreQueue( this );
+    connect( m_restoreQueue, &DataDeckRestoreQueue::deckLoaded, this, &MainWindow::slotRestoredDeckLoaded );
+    connect( m_restoreQueue, &DataDeckRestoreQueue::finished, this, &MainWindow::slotProjectRestoreFinished );
+
+    m_sessionRecorder = new EditingSessionRecorder( this );
+
+    // Create text editor as central widget. Files too large for the editor are shown in a read-only
+    // viewer reading from a memory-mapped file.
+    m_centralStack = new QStackedWidget( this );
+    m_textEditor   = new RimDataDeckTextEditor( m_centralStack );
+    m_largeFileViewer = new DataFileMappedViewer( m_centralStack );
+    m_centralStack->addWidget( m_textEditor );
+    m_centralStack->addWidget( m_largeFileViewer );
+    setCentralWidget( m_centralStack );
 
     // Create dock panels
     createDockPanels();
 
-    // Load recent files from settings
+    // Load recent files from settings. The last used DATA file is opened when the existence check
+    // completes, which is always delivered through the event loop after the window is shown.
     loadRecentFiles();
 
     // Create actions and menus
     createActions();
     createMenus();
     createToolBar();
+    createStatusBarWidgets();
 
     // Create an empty project
     createEmptyProject();
 
-    // Auto-open last used DATA file
-    QString lastFile = mostRecentFile();
-    if ( !lastFile.isEmpty() && QFileInfo::exists( lastFile ) )
-    {
-        importDataFile( lastFile );
-    }
-
     // Status bar
     statusBar()->showMessage( "Ready" );
 }
 
 MainWindow::~MainWindow()
 {
+    m_dataDeckLoader->cancel();
+
     // Clear UI views before deleting objects to avoid CAF_ASSERT
     if ( m_pdmUiTreeView )
     {
@@ -181,11 +288,46 @@ void MainWindow::createDockPanels()
         m_textEditor->setKeywordHelpWidget( m_keywordHelpWidget );
     }
 
+    // Create problems dock (bottom)
+    {
+        m_problemsDock = new QDockWidget( "Problems", this );
+        m_problemsDock->setObjectName( "problemsPanel" );
+        m_problemsDock->setAllowedAreas( Qt::BottomDockWidgetArea | Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea );
+
+        m_problemsWidget = new DataDeckProblemsWidget( m_problemsDock );
+        m_problemsDock->setWidget( m_problemsWidget );
+
+        addDockWidget( Qt::BottomDockWidgetArea, m_problemsDock );
+
+        connect( m_problemsWidget, &DataDeckProblemsWidget::problemActivated, this, &MainWindow::slotProblemActivated );
+    }
+
+    // Create deck profile dock (bottom, behind the problems), shown from the Tools menu
+    {
+        m_profileDock = new QDockWidget( "Deck Profile", this );
+        m_profileDock->setObjectName( "deckProfilePanel" );
+        m_profileDock->setAllowedAreas( Qt::BottomDockWidgetArea | Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea );
+
+        m_profileWidget = new DataDeckProfileWidget( m_profileDock );
+        m_profileDock->setWidget( m_profileWidget );
+
+        addDockWidget( Qt::BottomDockWidgetArea, m_profileDock );
+        tabifyDockWidget( m_problemsDock, m_profileDock );
+        m_problemsDock->raise();
+        m_profileDock->hide();
+
+        connect( m_profileWidget, &DataDeckProfileWidget::entryActivated, this, &MainWindow::slotProfileEntryActivated );
+        connect( m_profileDock, &QDockWidget::visibilityChanged, this, [this]( bool visible ) {
+            if ( visible ) updateDeckProfile();
+        } );
+    }
+
     // Connect text editor modification signal
     connect( m_textEditor, &RimDataDeckTextEditor::modificationChanged, this, &MainWindow::slotTextEditorModified );
 
     // Connect text editor cursor position changes to tree selection
     connect( m_textEditor, &QPlainTextEdit::cursorPositionChanged, this, &MainWindow::slotTextCursorChanged );
+    connect( m_largeFileViewer, &DataFileMappedViewer::currentLineChanged, this, &MainWindow::slotLargeFileViewerLineChanged );
 
     // Connect tree view selection to property view and text editor
     connect( m_pdmUiTreeView, SIGNAL( selectionChanged() ), this, SLOT( slotSelectionChanged() ) );
@@ -201,12 +343,37 @@ void MainWindow::createMenus()
     connect( newAction, &QAction::triggered, this, &MainWindow::slotNewProject );
     fileMenu->addAction( newAction );
 
+    QAction* openProjectAction = new QAction( "&Open Project...", this );
+    openProjectAction->setShortcuts( QKeySequence::Open );
+    connect( openProjectAction, &QAction::triggered, this, &MainWindow::slotOpenProject );
+    fileMenu->addAction( openProjectAction );
+
+    QAction* saveProjectAction = new QAction( "&Save Project", this );
+    saveProjectAction->setShortcuts( QKeySequence::Save );
+    connect( saveProjectAction, &QAction::triggered, this, &MainWindow::slotSaveProject );
+    fileMenu->addAction( saveProjectAction );
+
+    QAction* saveProjectAsAction = new QAction( "Save Project &As...", this );
+    saveProjectAsAction->setShortcuts( QKeySequence::SaveAs );
+    connect( saveProjectAsAction, &QAction::triggered, this, &MainWindow::slotSaveProjectAs );
+    fileMenu->addAction( saveProjectAsAction );
+
     fileMenu->addSeparator();
 
     QAction* importDataAction = new QAction( "Import &DATA File...", this );
     connect( importDataAction, &QAction::triggered, this, &MainWindow::slotImportDataFile );
     fileMenu->addAction( importDataAction );
 
+    QAction* compareAction = new QAction( "&Compare With DATA File...", this );
+    compareAction->setToolTip( "Compare the selected DATA file with another DATA file" );
+    connect( compareAction, &QAction::triggered, this, &MainWindow::slotCompareDataDecks );
+    fileMenu->addAction( compareAction );
+
+    QAction* compareArraysAction = new QAction( "Compare &Arrays...", this );
+    compareArraysAction->setToolTip( "Compare two selected grid arrays, or a changed array with its compared deck, cell by cell" );
+    connect( compareArraysAction, &QAction::triggered, this, &MainWindow::slotCompareArrays );
+    fileMenu->addAction( compareArraysAction );
+
     // Open Last Used DATA File
     m_openLastUsedAction = new QAction( "Open &Last Used DATA File", this );
     m_openLastUsedAction->setEnabled( !mostRecentFile().isEmpty() );
@@ -226,6 +393,50 @@ void MainWindow::createMenus()
     connect( exitAction, &QAction::triggered, this, &QWidget::close );
     fileMenu->addAction( exitAction );
 
+    // Tools menu
+    QMenu* toolsMenu = menuBar()->addMenu( "&Tools" );
+
+    m_recordSessionAction = new QAction( "&Record Editing Session", this );
+    m_recordSessionAction->setToolTip( "Record key presses, cursor moves, tree selections and syncs for latency replay" );
+    m_recordSessionAction->setCheckable( true );
+    connect( m_recordSessionAction, &QAction::toggled, this, &MainWindow::slotRecordEditingSession );
+    toolsMenu->addAction( m_recordSessionAction );
+
+    QAction* recordTraceAction = new QAction( "Record &Trace", this );
+    recordTraceAction->setToolTip( "Trace the load and edit pipeline, and save it for chrome://tracing or Perfetto" );
+    recordTraceAction->setCheckable( true );
+    recordTraceAction->setChecked( DataDeckTrace::isEnabled() );
+    connect( recordTraceAction, &QAction::toggled, this, &MainWindow::slotRecordTrace );
+    toolsMenu->addAction( recordTraceAction );
+
+    QAction* profileAction = m_profileDock->toggleViewAction();
+    profileAction->setText( "Deck &Profile" );
+    profileAction->setToolTip( "Show the size and load time of each keyword and include file" );
+    toolsMenu->addAction( profileAction );
+
+    m_performanceHudAction = new QAction( "Performance &HUD", this );
+    m_performanceHudAction->setToolTip( "Show parse, highlighting and typing latency, deck memory and background jobs in the status bar" );
+    m_performanceHudAction->setCheckable( true );
+    connect( m_performanceHudAction, &QAction::toggled, this, &MainWindow::slotShowPerformanceHud );
+    toolsMenu->addAction( m_performanceHudAction );
+
+    QAction* refreshMemoryAction = new QAction( "Refresh &Memory Usage", this );
+    refreshMemoryAction->setToolTip( "Estimate the memory held by the selected DATA file again" );
+    connect( refreshMemoryAction, &QAction::triggered, this, &MainWindow::slotRefreshMemoryUsage );
+    toolsMenu->addAction( refreshMemoryAction );
+
+    // Runtime switches for the debug output of each logging category, QT_LOGGING_RULES sets the initial state
+    QMenu* loggingMenu = toolsMenu->addMenu( "Debug &Logging" );
+    for ( const QString& categoryName : DataDeckLogging::categoryNames() )
+    {
+        QAction* categoryAction = loggingMenu->addAction( categoryName );
+        categoryAction->setCheckable( true );
+        categoryAction->setChecked( DataDeckLogging::isDebugEnabled( categoryName ) );
+        connect( categoryAction, &QAction::toggled, this, [categoryName]( bool checked ) {
+            DataDeckLogging::setDebugEnabled( categoryName, checked );
+        } );
+    }
+
     // Help menu
     QMenu* helpMenu = menuBar()->addMenu( "&Help" );
 
@@ -258,6 +469,56 @@ void MainWindow::createToolBar()
     alignColumnsAction->setToolTip( "Align columns for selected keyword" );
     connect( alignColumnsAction, &QAction::triggered, this, &MainWindow::slotAlignColumns );
     m_textEditorToolBar->addAction( alignColumnsAction );
+
+    m_textEditorToolBar->addSeparator();
+
+    // Folding actions
+    QAction* foldAllAction = new QAction( "Fold All", this );
+    foldAllAction->setToolTip( "Fold the data of all keywords" );
+    connect( foldAllAction, &QAction::triggered, m_textEditor, &RimDataDeckTextEditor::foldAll );
+    m_textEditorToolBar->addAction( foldAllAction );
+
+    QAction* unfoldAllAction = new QAction( "Unfold All", this );
+    unfoldAllAction->setToolTip( "Show the data of all keywords" );
+    connect( unfoldAllAction, &QAction::triggered, m_textEditor, &RimDataDeckTextEditor::unfoldAll );
+    m_textEditorToolBar->addAction( unfoldAllAction );
+}
+
+void MainWindow::createStatusBarWidgets()
+{
+    m_loadProgressBar = new QProgressBar( this );
+    m_loadProgressBar->setRange( 0, 0 ); // Busy indicator, the parser does not report progress
+    m_loadProgressBar->setMaximumWidth( 150 );
+    m_loadProgressBar->setMaximumHeight( 16 );
+    m_loadProgressBar->setTextVisible( false );
+    m_loadProgressBar->hide();
+    statusBar()->addPermanentWidget( m_loadProgressBar );
+
+    m_cancelLoadButton = new QToolButton( this );
+    m_cancelLoadButton->setText( "Cancel" );
+    m_cancelLoadButton->setToolTip( "Cancel loading of the DATA file" );
+    m_cancelLoadButton->hide();
+    connect( m_cancelLoadButton, &QToolButton::clicked, m_dataDeckLoader, &DataDeckLoader::cancel );
+    statusBar()->addPermanentWidget( m_cancelLoadButton );
+
+    m_textLoadProgressBar = new QProgressBar( this );
+    m_textLoadProgressBar->setRange( 0, 100 );
+    m_textLoadProgressBar->setMaximumWidth( 150 );
+    m_textLoadProgressBar->setMaximumHeight( 16 );
+    m_textLoadProgressBar->setFormat( "Text %p%" );
+    m_textLoadProgressBar->hide();
+    statusBar()->addPermanentWidget( m_textLoadProgressBar );
+
+    // Optional live performance readout, off by default
+    m_performanceHud = new DataDeckPerformanceHud( m_textEditor, this );
+    m_performanceHud->hide();
+    statusBar()->addPermanentWidget( m_performanceHud );
+
+    QSettings settings( "Ceetron", "DataObjectEditor" );
+    m_performanceHudAction->setChecked( settings.value( "showPerformanceHud", false ).toBool() );
+
+    connect( m_textEditor, &RimDataDeckTextEditor::loadProgress, this, &MainWindow::slotTextLoadProgress );
+    connect( m_textEditor, &RimDataDeckTextEditor::loadFinished, this, &MainWindow::slotTextLoadFinished );
 }
 
 void MainWindow::createEmptyProject()
@@ -273,6 +534,9 @@ void MainWindow::createEmptyProject()
         m_pdmUiPropertyView->showProperties( nullptr );
     }
 
+    // Decks still parsing for the previous project are dropped
+    m_restoreQueue->cancel();
+
     releaseProjectData();
 
     // Create an empty project document
@@ -301,6 +565,261 @@ void MainWindow::slotNewProject()
     createEmptyProject();
 }
 
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotOpenProject()
+{
+    QString filePath = QFileDialog::getOpenFileName( this, "Open Project", "", PROJECT_FILE_FILTER );
+    if ( !filePath.isEmpty() )
+    {
+        openProject( filePath );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotSaveProject()
+{
+    if ( !m_project )
+    {
+        return;
+    }
+
+    if ( m_project->fileName().isEmpty() )
+    {
+        slotSaveProjectAs();
+        return;
+    }
+
+    saveProject( m_project->fileName() );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotSaveProjectAs()
+{
+    if ( !m_project )
+    {
+        return;
+    }
+
+    QString filePath = QFileDialog::getSaveFileName( this, "Save Project", m_project->fileName(), PROJECT_FILE_FILTER );
+    if ( !filePath.isEmpty() )
+    {
+        saveProject( filePath );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The project file holds the deck paths, their cache keys and the UI state. The decks are parsed
+/// again and their trees rebuilt after the references are read.
+//--------------------------------------------------------------------------------------------------
+bool MainWindow::openProject( const QString& filePath )
+{
+    if ( !QFileInfo( filePath ).isReadable() )
+    {
+        QMessageBox::critical( this, "Open Project", QString( "Could not read project file:\n%1" ).arg( filePath ) );
+        return false;
+    }
+
+    m_dataDeckLoader->cancel();
+    m_autoOpenLastFile   = false;
+    m_pendingRestoreLine = 0;
+
+    createEmptyProject();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_project->fileName = filePath;
+    m_project->readFile();
+    m_project->updateConnectedEditors();
+
+    const qint64 readTimeMs = timer.elapsed();
+
+    const int deckCount = restoreDataDecks();
+
+    if ( deckCount > 0 )
+    {
+        statusBar()->showMessage( QString( "Opened project %1, references read in %2 ms, loading %3 DATA file(s)" )
+                                      .arg( QFileInfo( filePath ).fileName() )
+                                      .arg( readTimeMs )
+                                      .arg( deckCount ) );
+    }
+    else
+    {
+        statusBar()->showMessage( QString( "Opened project %1 in %2 ms" ).arg( QFileInfo( filePath ).fileName() ).arg( readTimeMs ), 3000 );
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool MainWindow::saveProject( const QString& filePath )
+{
+    ProjectDocument* doc = dynamic_cast<ProjectDocument*>( m_project );
+    if ( !doc )
+    {
+        return false;
+    }
+
+    // UI state, the deck in the editor and the line of its cursor
+    RimDataDeck* editorDeck = m_textEditor->dataDeck();
+    if ( editorDeck && !isLargeFileViewerActive() )
+    {
+        doc->m_currentDataDeck = editorDeck->filePath();
+        doc->m_currentLine     = m_textEditor->textCursor().blockNumber() + 1;
+    }
+    else
+    {
+        doc->m_currentDataDeck = QString();
+        doc->m_currentLine     = 0;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    doc->fileName = filePath;
+    if ( !doc->writeFile() )
+    {
+        QMessageBox::critical( this, "Save Project", QString( "Could not write project file:\n%1" ).arg( filePath ) );
+        return false;
+    }
+
+    statusBar()->showMessage( QString( "Saved project %1 in %2 ms" ).arg( QFileInfo( filePath ).fileName() ).arg( timer.elapsed() ), 3000 );
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Queue the decks referenced by a project that was just read, the deck that was current when the
+/// project was saved first. The deck nodes are in the tree right away and get their content as the
+/// parses complete in slotRestoredDeckLoaded(). Returns the number of decks queued.
+//--------------------------------------------------------------------------------------------------
+int MainWindow::restoreDataDecks()
+{
+    ProjectDocument* doc = dynamic_cast<ProjectDocument*>( m_project );
+    if ( !doc )
+    {
+        return 0;
+    }
+
+    RimDataDeck* currentDeck = findDataDeck( doc->m_currentDataDeck );
+
+    QStringList filePaths;
+    for ( RimDataDeck* dataDeck : doc->m_dataDecks )
+    {
+        dataDeck->setUiName( QFileInfo( dataDeck->filePath() ).fileName() + " (loading)" );
+        if ( dataDeck == currentDeck )
+        {
+            filePaths.prepend( dataDeck->filePath() );
+        }
+        else
+        {
+            filePaths.append( dataDeck->filePath() );
+        }
+    }
+    m_project->updateConnectedEditors();
+
+    m_restoreChangedFiles.clear();
+    m_restoreFailedFiles.clear();
+    m_restoreTimer.start();
+    m_restoreQueue->enqueue( filePaths );
+
+    if ( currentDeck )
+    {
+        // The line is selected when the deck is loaded and shown
+        m_pendingRestoreLine = doc->m_currentLine;
+        m_pdmUiTreeView->selectAsCurrentItem( currentDeck );
+    }
+
+    return filePaths.size();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Build the tree of a restored deck in its reference node, and show it if it is selected
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotRestoredDeckLoaded( const DataDeckLoadResult& result )
+{
+    RimDataDeck* dataDeck = findDataDeck( result.filePath );
+    if ( !dataDeck || dataDeck->deck() )
+    {
+        return;
+    }
+
+    const QString savedCacheKey = dataDeck->cacheKey();
+    bool          loaded        = false;
+    if ( result.success() )
+    {
+        try
+        {
+            dataDeck->setDeck( result.deck, result.filePath, result.includeDecks, result.fileScans );
+            dataDeck->setParseTimes( result.parseTimeNs, result.includeParseTimesNs );
+            loaded = true;
+        }
+        catch ( const std::exception& e )
+        {
+            qCWarning( logDeck ) << "Failed to build" << result.filePath << ":" << e.what();
+        }
+    }
+
+    if ( !loaded )
+    {
+        dataDeck->setUiName( QFileInfo( result.filePath ).fileName() + " (not loaded)" );
+        m_restoreFailedFiles.append( result.errorMessage.isEmpty() ? result.filePath
+                                                                   : result.filePath + ": " + result.errorMessage );
+    }
+    else if ( !savedCacheKey.isEmpty() && savedCacheKey != dataDeck->cacheKey() )
+    {
+        m_restoreChangedFiles.append( QFileInfo( result.filePath ).fileName() );
+    }
+
+    dataDeck->updateConnectedEditors();
+
+    if ( loaded && getCurrentDataDeck() == dataDeck )
+    {
+        // The editor applies a restored cursor line when the text is loaded, the large file viewer here
+        updateTextEditor();
+        if ( isLargeFileViewerActive() && m_pendingRestoreLine > 0 )
+        {
+            highlightTextRange( m_pendingRestoreLine, m_pendingRestoreLine );
+            m_pendingRestoreLine = 0;
+        }
+    }
+    if ( loaded && m_profiledDeck.p() == dataDeck )
+    {
+        updateDeckProfile();
+    }
+
+    statusBar()->showMessage( QString( "Loaded %1, %2 DATA file(s) left" )
+                                  .arg( QFileInfo( result.filePath ).fileName() )
+                                  .arg( m_restoreQueue->pendingCount() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotProjectRestoreFinished()
+{
+    QString message = QString( "Project restored in %1 ms" ).arg( m_restoreTimer.elapsed() );
+    if ( !m_restoreChangedFiles.isEmpty() )
+    {
+        message += QString( ", changed since saved: %1" ).arg( m_restoreChangedFiles.join( ", " ) );
+    }
+    statusBar()->showMessage( message, 5000 );
+
+    if ( !m_restoreFailedFiles.isEmpty() )
+    {
+        QMessageBox::warning( this, "Open Project", QString( "Failed to load DATA file(s):\n%1" ).arg( m_restoreFailedFiles.join( '\n' ) ) );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
 void MainWindow::slotImportDataFile()
 {
     if ( !m_project )
@@ -320,6 +839,40 @@ void MainWindow::slotImportDataFile()
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/// Compare the selected deck with another DATA file, which is loaded into the project if needed
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotCompareDataDecks()
+{
+    RimDataDeck* baseDeck = getCurrentDataDeck();
+    if ( !baseDeck || !baseDeck->deck() )
+    {
+        statusBar()->showMessage( "Select the DATA file to compare from in the project tree", 3000 );
+        return;
+    }
+
+    QString filePath = QFileDialog::getOpenFileName( this,
+                                                     "Compare With DATA File",
+                                                     QFileInfo( baseDeck->filePath() ).absolutePath(),
+                                                     "Eclipse DATA Files (*.DATA *.data);;All Files (*.*)" );
+    if ( filePath.isEmpty() )
+    {
+        return;
+    }
+
+    RimDataDeck* otherDeck = findDataDeck( filePath );
+    if ( otherDeck && otherDeck != baseDeck )
+    {
+        compareDataDecks( baseDeck, otherDeck );
+        return;
+    }
+
+    // Compared in slotDataDeckLoaded() when the other deck is in the project
+    m_pendingCompareBaseDeck = baseDeck;
+    m_pendingCompareFilePath = filePath;
+    importDataFile( filePath );
+}
+
 void MainWindow::slotOpenLastUsedDataFile()
 {
     if ( !m_project )
@@ -369,6 +922,29 @@ void MainWindow::slotSelectionChanged()
 
     m_pdmUiPropertyView->showProperties( obj );
 
+    RimDataDeck* selectedDeck = nullptr;
+    if ( obj )
+    {
+        obj->firstAncestorOrThisOfType( selectedDeck );
+    }
+    if ( selectedDeck != m_profiledDeck.p() )
+    {
+        m_profiledDeck = selectedDeck;
+        updateDeckProfile();
+    }
+
+    // A restored deck that is still waiting is parsed next
+    if ( selectedDeck && !selectedDeck->deck() && m_restoreQueue->prioritize( selectedDeck->filePath() ) )
+    {
+        statusBar()->showMessage( QString( "Loading %1 next" ).arg( QFileInfo( selectedDeck->filePath() ).fileName() ), 3000 );
+    }
+
+    // Only selections made in the tree are recorded, not those following the text cursor
+    if ( obj && m_pdmUiTreeView->isAncestorOf( QApplication::focusWidget() ) )
+    {
+        m_sessionRecorder->recordTreeSelection( obj );
+    }
+
     // Update text editor first
     updateTextEditor();
     
@@ -414,7 +990,7 @@ void MainWindow::slotAbout()
 
 void MainWindow::slotAlignColumns()
 {
-    if ( !m_textEditor )
+    if ( !m_textEditor || isLargeFileViewerActive() )
     {
         return;
     }
@@ -454,16 +1030,58 @@ void MainWindow::loadRecentFiles()
     QSettings settings( "Ceetron", "DataObjectEditor" );
     m_recentFiles = settings.value( "recentFiles" ).toStringList();
 
-    // Remove files that no longer exist
-    QStringList validFiles;
-    for ( const QString& file : m_recentFiles )
+    // Remove files that no longer exist. QFileInfo::exists can block for a long time on an unreachable
+    // mount, so the check runs on a worker thread.
+    auto* watcher = new QFutureWatcher<QStringList>( this );
+    connect( watcher, &QFutureWatcher<QStringList>::finished, this, [this, watcher]() {
+        slotRecentFilesChecked( watcher->result() );
+        watcher->deleteLater();
+    } );
+
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run(
+        []( const QStringList& files ) {
+            QStringList missingFiles;
+            for ( const QString& file : files )
+            {
+                if ( !QFileInfo::exists( file ) )
+                {
+                    missingFiles.append( file );
+                }
+            }
+            return missingFiles;
+        },
+        m_recentFiles ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotRecentFilesChecked( const QStringList& missingFiles )
+{
+    // The list may have changed while the check was running, so only drop the missing entries
+    for ( const QString& file : missingFiles )
+    {
+        m_recentFiles.removeAll( file );
+    }
+
+    updateRecentFilesMenu();
+
+    if ( m_openLastUsedAction )
+    {
+        m_openLastUsedAction->setEnabled( !mostRecentFile().isEmpty() );
+    }
+
+    // Auto-open last used DATA file unless the user already started loading something else
+    if ( m_autoOpenLastFile && !m_dataDeckLoader->isLoading() )
     {
-        if ( QFileInfo::exists( file ) )
+        QString lastFile = mostRecentFile();
+        if ( !lastFile.isEmpty() )
         {
-            validFiles.append( file );
+            importDataFile( lastFile );
         }
     }
-    m_recentFiles = validFiles;
+    m_autoOpenLastFile = false;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -566,49 +1184,343 @@ QString MainWindow::mostRecentFile() const
 //--------------------------------------------------------------------------------------------------
 bool MainWindow::importDataFile( const QString& filePath )
 {
-    if ( !m_project )
+    if ( !m_project || filePath.isEmpty() )
     {
         return false;
     }
 
-    RimDataDeck* dataDeck = RicImportDataDeckFeature::importDataFile( filePath );
-
-    if ( dataDeck )
-    {
-        ProjectDocument* doc = dynamic_cast<ProjectDocument*>( m_project );
-        if ( doc )
-        {
-            doc->m_dataDecks.push_back( dataDeck );
-            m_project->updateConnectedEditors();
-
-            // Add to recent files
-            addRecentFile( filePath );
+    m_autoOpenLastFile = false;
 
-            statusBar()->showMessage( QString( "Imported: %1 with %2 keywords" )
-                                          .arg( dataDeck->filePath() )
-                                          .arg( dataDeck->keywordCount() ) );
-            return true;
-        }
-    }
-    else
-    {
-        QMessageBox::critical( this,
-                               "Import Failed",
-                               QString( "Failed to import DATA file:\n%1" ).arg( filePath ) );
-    }
+    // Parse on a worker thread, the deck is added to the project in slotDataDeckLoaded()
+    m_dataDeckLoader->load( filePath );
 
-    return false;
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
 ///
 //--------------------------------------------------------------------------------------------------
-void MainWindow::updateTextEditor()
+void MainWindow::addDataDeckToProject( RimDataDeck* dataDeck )
+{
+    ProjectDocument* doc = dynamic_cast<ProjectDocument*>( m_project );
+    if ( !doc )
+    {
+        delete dataDeck;
+        return;
+    }
+
+    doc->m_dataDecks.push_back( dataDeck );
+    m_project->updateConnectedEditors();
+
+    // Add to recent files
+    addRecentFile( dataDeck->filePath() );
+
+    statusBar()->showMessage( QString( "Imported: %1 with %2 keywords" )
+                                  .arg( dataDeck->filePath() )
+                                  .arg( dataDeck->keywordCount() ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Compare two selected array keywords, or one changed array keyword with its counterpart from the
+/// last deck comparison
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotCompareArrays()
+{
+    std::vector<caf::PdmUiItem*> selection;
+    m_pdmUiTreeView->selectedUiItems( selection );
+
+    std::vector<RimDataKeyword*> keywords;
+    for ( caf::PdmUiItem* item : selection )
+    {
+        caf::PdmUiObjectHandle* uiObject = dynamic_cast<caf::PdmUiObjectHandle*>( item );
+        RimDataKeyword*         keyword  = uiObject ? dynamic_cast<RimDataKeyword*>( uiObject->objectHandle() ) : nullptr;
+        if ( keyword )
+        {
+            keywords.push_back( keyword );
+        }
+    }
+
+    RimDataKeyword* baseKeyword  = nullptr;
+    RimDataKeyword* otherKeyword = nullptr;
+    if ( keywords.size() == 2 )
+    {
+        baseKeyword  = keywords[0];
+        otherKeyword = keywords[1];
+    }
+    else if ( keywords.size() == 1 && keywords[0]->comparedKeyword() )
+    {
+        baseKeyword  = keywords[0];
+        otherKeyword = keywords[0]->comparedKeyword();
+    }
+
+    if ( !baseKeyword || !otherKeyword || !baseKeyword->deckKeyword() || !otherKeyword->deckKeyword() )
+    {
+        statusBar()->showMessage( "Select two array keywords, or a changed array after comparing DATA files", 5000 );
+        return;
+    }
+
+    RimDataDeck* baseDeck  = nullptr;
+    RimDataDeck* otherDeck = nullptr;
+    baseKeyword->firstAncestorOrThisOfType( baseDeck );
+    otherKeyword->firstAncestorOrThisOfType( otherDeck );
+
+    std::optional<DataDeckGridChecker::GridArray> shape = baseDeck ? baseDeck->gridArray( baseKeyword ) : std::nullopt;
+    if ( !shape || !otherDeck )
+    {
+        statusBar()->showMessage( QString( "%1 is not a grid array" ).arg( baseKeyword->keywordName() ), 5000 );
+        return;
+    }
+
+    // Tolerances, remembered between comparisons
+    QSettings settings( "Ceetron", "DataObjectEditor" );
+
+    QDialog dialog( this );
+    dialog.setWindowTitle( QString( "Compare %1 with %2" ).arg( baseKeyword->keywordName() ).arg( otherKeyword->keywordName() ) );
+
+    auto* absoluteSpinBox = new QDoubleSpinBox( &dialog );
+    absoluteSpinBox->setDecimals( 10 );
+    absoluteSpinBox->setRange( 0.0, 1.0e30 );
+    absoluteSpinBox->setValue( settings.value( "arrayComparison/absoluteTolerance", 0.0 ).toDouble() );
+
+    auto* relativeSpinBox = new QDoubleSpinBox( &dialog );
+    relativeSpinBox->setDecimals( 10 );
+    relativeSpinBox->setRange( 0.0, 1.0 );
+    relativeSpinBox->setValue( settings.value( "arrayComparison/relativeTolerance", 1.0e-6 ).toDouble() );
+
+    auto* buttons = new QDialogButtonBox( QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog );
+    connect( buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept );
+    connect( buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject );
+
+    auto* layout = new QFormLayout( &dialog );
+    layout->addRow( "Absolute tolerance", absoluteSpinBox );
+    layout->addRow( "Relative tolerance", relativeSpinBox );
+    layout->addRow( buttons );
+
+    if ( dialog.exec() != QDialog::Accepted )
+    {
+        return;
+    }
+
+    DataArrayComparison::Tolerance tolerance;
+    tolerance.absolute = absoluteSpinBox->value();
+    tolerance.relative = relativeSpinBox->value();
+    settings.setValue( "arrayComparison/absoluteTolerance", tolerance.absolute );
+    settings.setValue( "arrayComparison/relativeTolerance", tolerance.relative );
+
+    // The decks own the keyword data, keep them alive while comparing
+    std::shared_ptr<Opm::Deck>      base      = baseDeck->deck();
+    std::shared_ptr<Opm::Deck>      other     = otherDeck->deck();
+    const Opm::DeckKeyword*         baseData  = baseKeyword->deckKeyword();
+    const Opm::DeckKeyword*         otherData = otherKeyword->deckKeyword();
+    caf::PdmPointer<RimDataKeyword> resultKeyword( baseKeyword );
+
+    const QString title = QString( "%1 compared with %2 in %3" )
+                              .arg( baseKeyword->keywordName() )
+                              .arg( otherKeyword->keywordName() )
+                              .arg( QFileInfo( otherDeck->filePath() ).fileName() );
+
+    statusBar()->showMessage( QString( "Comparing %1 ..." ).arg( baseKeyword->keywordName() ) );
+
+    auto* watcher = new QFutureWatcher<DataArrayComparison::Result>( this );
+    connect( watcher, &QFutureWatcher<DataArrayComparison::Result>::finished, this, [this, watcher, resultKeyword, title]() {
+        const DataArrayComparison::Result result = watcher->result();
+        watcher->deleteLater();
+
+        if ( resultKeyword )
+        {
+            resultKeyword->setArrayComparison( title + "\n" + result.toText() );
+        }
+        statusBar()->showMessage( result.isValid() ? QString( "%1: %2 values changed" ).arg( title ).arg( result.stats.changedCount ) : result.errorMessage, 5000 );
+    } );
+
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( [base, other, baseData, otherData, shape, tolerance]()
+                                           { return DataArrayComparison::compare( *baseData, *otherData, *shape, tolerance ); } ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+RimDataDeck* MainWindow::findDataDeck( const QString& filePath ) const
+{
+    ProjectDocument* doc = dynamic_cast<ProjectDocument*>( m_project );
+    if ( !doc )
+    {
+        return nullptr;
+    }
+
+    const QString canonicalPath = QFileInfo( filePath ).canonicalFilePath();
+    for ( RimDataDeck* dataDeck : doc->m_dataDecks )
+    {
+        if ( dataDeck && QFileInfo( dataDeck->filePath() ).canonicalFilePath() == canonicalPath )
+        {
+            return dataDeck;
+        }
+    }
+    return nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Compare on a worker thread and mark the keyword nodes of both decks when done
+//--------------------------------------------------------------------------------------------------
+void MainWindow::compareDataDecks( RimDataDeck* baseDeck, RimDataDeck* otherDeck )
+{
+    std::shared_ptr<Opm::Deck> base  = baseDeck->deck();
+    std::shared_ptr<Opm::Deck> other = otherDeck->deck();
+    if ( !base || !other )
+    {
+        return;
+    }
+
+    statusBar()->showMessage( QString( "Comparing %1 with %2 ..." )
+                                  .arg( QFileInfo( baseDeck->filePath() ).fileName() )
+                                  .arg( QFileInfo( otherDeck->filePath() ).fileName() ) );
+
+    caf::PdmPointer<RimDataDeck> basePointer( baseDeck );
+    caf::PdmPointer<RimDataDeck> otherPointer( otherDeck );
+
+    auto* watcher = new QFutureWatcher<DataDeckDiff>( this );
+    connect( watcher, &QFutureWatcher<DataDeckDiff>::finished, this, [this, watcher, basePointer, otherPointer, base, other]() {
+        const DataDeckDiff diff = watcher->result();
+        watcher->deleteLater();
+
+        // The trees may have been rebuilt from other decks while comparing
+        if ( !basePointer || !otherPointer || basePointer->deck() != base || otherPointer->deck() != other )
+        {
+            statusBar()->showMessage( "Comparison discarded, a DATA file changed while comparing", 5000 );
+            return;
+        }
+
+        basePointer->setComparison( diff, true, otherPointer );
+        otherPointer->setComparison( diff, false, basePointer );
+
+        statusBar()->showMessage( QString( "Comparison: %1" ).arg( diff.summary() ) );
+    } );
+
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( [base, other]() { return DataDeckDiff::compare( *base, *other ); } ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotDataDeckLoadStarted( const QString& filePath )
+{
+    m_loadProgressBar->show();
+    m_cancelLoadButton->show();
+
+    statusBar()->showMessage( QString( "Loading: %1 ..." ).arg( filePath ) );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotDataDeckLoaded( const DataDeckLoadResult& result )
+{
+    m_loadProgressBar->hide();
+    m_cancelLoadButton->hide();
+
+    RimDataDeck* dataDeck     = nullptr;
+    QString      errorMessage = result.errorMessage;
+    if ( result.success() && m_project )
+    {
+        try
+        {
+            dataDeck = new RimDataDeck();
+            dataDeck->setDeck( result.deck, result.filePath, result.includeDecks, result.fileScans );
+            dataDeck->setParseTimes( result.parseTimeNs, result.includeParseTimesNs );
+        }
+        catch ( const std::exception& e )
+        {
+            delete dataDeck;
+            dataDeck     = nullptr;
+            errorMessage = QString::fromStdString( e.what() );
+        }
+    }
+
+    RimDataDeck* pendingCompareBaseDeck = m_pendingCompareBaseDeck;
+    const bool   isPendingCompare       = result.filePath == m_pendingCompareFilePath;
+    if ( isPendingCompare )
+    {
+        m_pendingCompareBaseDeck = nullptr;
+        m_pendingCompareFilePath.clear();
+    }
+
+    if ( dataDeck )
+    {
+        addDataDeckToProject( dataDeck );
+
+        if ( isPendingCompare && pendingCompareBaseDeck )
+        {
+            compareDataDecks( pendingCompareBaseDeck, dataDeck );
+        }
+    }
+    else
+    {
+        statusBar()->clearMessage();
+
+        QString message = QString( "Failed to import DATA file:\n%1" ).arg( result.filePath );
+        if ( !errorMessage.isEmpty() )
+        {
+            message += "\n\n" + errorMessage;
+        }
+        QMessageBox::critical( this, "Import Failed", message );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotDataDeckLoadCanceled( const QString& filePath )
+{
+    m_loadProgressBar->hide();
+    m_cancelLoadButton->hide();
+
+    if ( filePath == m_pendingCompareFilePath )
+    {
+        m_pendingCompareBaseDeck = nullptr;
+        m_pendingCompareFilePath.clear();
+    }
+
+    statusBar()->showMessage( QString( "Canceled loading: %1" ).arg( filePath ), 3000 );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::updateTextEditor()
 {
     RimDataDeck* dataDeck = getCurrentDataDeck();
+    if ( dataDeck && !dataDeck->deck() )
+    {
+        // Restored deck still loading, or failed to load
+        dataDeck = nullptr;
+    }
 
-    if ( dataDeck && m_textEditor )
+    // Validation restarts when the new text is loaded
+    if ( dataDeck )
     {
+        m_dataDeckValidator->setDocument( nullptr, QString() );
+    }
+
+    if ( dataDeck && m_textEditor && DataFileMappedViewer::shouldUseForFile( dataDeck->filePath() ) )
+    {
+        // Too large to edit, show the file read-only without loading it into a QTextDocument
+        m_textEditor->setDataDeck( nullptr );
+        m_textEditor->clear();
+        m_largeFileViewer->openFile( dataDeck->filePath() );
+        m_centralStack->setCurrentWidget( m_largeFileViewer );
+        m_textEditorToolBar->setEnabled( false );
+        m_syncTreeToTextAction->setEnabled( false );
+        m_syncTextToTreeAction->setEnabled( false );
+
+        statusBar()->showMessage( QString( "Large file opened read-only: %1 lines" ).arg( m_largeFileViewer->lineCount() ), 5000 );
+    }
+    else if ( dataDeck && m_textEditor )
+    {
+        m_largeFileViewer->closeFile();
+        m_centralStack->setCurrentWidget( m_textEditor );
+        m_textEditorToolBar->setEnabled( true );
         m_textEditor->setDataDeck( dataDeck );
         m_syncTreeToTextAction->setEnabled( true );
         m_syncTextToTreeAction->setEnabled( false ); // Only enable after modifications
@@ -661,7 +1573,7 @@ RimDataDeck* MainWindow::getCurrentDataDeck()
 //--------------------------------------------------------------------------------------------------
 void MainWindow::slotSyncTreeToText()
 {
-    if ( !m_textEditor )
+    if ( !m_textEditor || isLargeFileViewerActive() )
     {
         return;
     }
@@ -673,7 +1585,10 @@ void MainWindow::slotSyncTreeToText()
         return;
     }
 
-    // Reload text from deck
+    m_sessionRecorder->recordSync( EditingSessionEvent::Type::SYNC_TREE_TO_TEXT );
+
+    // Reload text from deck. Validation starts again with the loaded text when it is complete.
+    m_dataDeckValidator->setDocument( nullptr, QString() );
     m_textEditor->loadFromDeck();
     statusBar()->showMessage( "Synchronized tree to text editor", 3000 );
 }
@@ -683,7 +1598,7 @@ void MainWindow::slotSyncTreeToText()
 //--------------------------------------------------------------------------------------------------
 void MainWindow::slotSyncTextToTree()
 {
-    if ( !m_textEditor )
+    if ( !m_textEditor || isLargeFileViewerActive() )
     {
         return;
     }
@@ -695,53 +1610,139 @@ void MainWindow::slotSyncTextToTree()
         return;
     }
 
-    try
+    if ( m_textEditor->isLoading() )
     {
-        // Get text from editor
-        QString text = m_textEditor->toPlainText();
+        statusBar()->showMessage( "Text is still loading, try again when it is complete", 3000 );
+        return;
+    }
+
+    if ( m_isSyncingTextToTree )
+    {
+        statusBar()->showMessage( "Text is already being synchronized", 3000 );
+        return;
+    }
+
+    m_sessionRecorder->recordSync( EditingSessionEvent::Type::SYNC_TEXT_TO_TREE );
+
+    // The text is parsed on a worker thread, the tree is updated when the parse completes
+    const QString                    text         = m_textEditor->toPlainText();
+    const QString                    deckFilePath = dataDeck->filePath();
+    const int                        revision     = m_textEditor->document()->revision();
+    const std::shared_ptr<Opm::Deck> previousDeck = dataDeck->deck();
+    caf::PdmPointer<RimDataDeck>     deckPointer( dataDeck );
+
+    m_isSyncingTextToTree = true;
+    m_syncTextToTreeAction->setEnabled( false );
+    statusBar()->showMessage( "Parsing text ..." );
+
+    auto* watcher = new QFutureWatcher<SyncParseResult>( this );
+    connect( watcher, &QFutureWatcher<SyncParseResult>::finished, this, [this, watcher, deckPointer, previousDeck, revision]() {
+        const SyncParseResult result = watcher->result();
+        watcher->deleteLater();
 
-        // Write to temporary file
-        QString tempFilePath = dataDeck->filePath() + ".temp";
-        QFile   tempFile( tempFilePath );
-        if ( !tempFile.open( QIODevice::WriteOnly | QIODevice::Text ) )
+        m_isSyncingTextToTree = false;
+
+        // The deck may have been reloaded or removed, or another deck shown, while parsing
+        if ( !deckPointer || deckPointer->deck() != previousDeck || m_textEditor->dataDeck() != deckPointer.p() )
         {
-            QMessageBox::critical( this, "Sync Error", "Failed to create temporary file for parsing" );
+            statusBar()->showMessage( "Sync discarded, the DATA file changed while parsing", 5000 );
             return;
         }
 
-        QTextStream out( &tempFile );
-        out << text;
-        tempFile.close();
+        applySyncedDeck( deckPointer, result.deck, result.problems, revision );
+    } );
 
-        // Parse the text
-        Opm::Parser       parser;
-        Opm::ParseContext parseContext;
-        parseContext.update( Opm::InputErrorAction::WARN );
+    DataDeckMetrics::trackBackgroundJob( watcher );
+    watcher->setFuture( QtConcurrent::run( &parseSyncText, text, deckFilePath ) );
+}
 
-        auto newDeck = std::make_shared<Opm::Deck>( parser.parseFile( tempFilePath.toStdString(), parseContext ) );
+//--------------------------------------------------------------------------------------------------
+/// Update the tree from the parsed editor text. The text is only marked unmodified if it was not
+/// edited while parsing.
+//--------------------------------------------------------------------------------------------------
+void MainWindow::applySyncedDeck( RimDataDeck* dataDeck, std::shared_ptr<Opm::Deck> newDeck, QList<DataDeckProblem> problems, int revision )
+{
+    showProblems( problems );
 
-        // Delete temporary file
-        QFile::remove( tempFilePath );
+    if ( !newDeck )
+    {
+        statusBar()->showMessage( "Failed to parse text, see the Problems panel", 5000 );
+        m_problemsDock->show();
+        m_problemsDock->raise();
+        m_syncTextToTreeAction->setEnabled( m_textEditor->document()->isModified() );
+        return;
+    }
 
-        // Update the data deck
-        if ( dataDeck->updateFromDeck( newDeck ) )
-        {
-            // Mark as unmodified
-            m_textEditor->document()->setModified( false );
-            m_syncTextToTreeAction->setEnabled( false );
+    // Update the data deck
+    bool updated = false;
+    try
+    {
+        updated = dataDeck->updateFromDeck( newDeck );
+    }
+    catch ( const std::exception& e )
+    {
+        DataDeckProblem problem;
+        problem.message  = QString( "Failed to update DATA deck from text: %1" ).arg( e.what() );
+        problem.filePath = dataDeck->filePath();
+        problems.append( problem );
+        showProblems( problems );
+    }
 
-            statusBar()->showMessage( "Synchronized text to tree successfully", 3000 );
-        }
-        else
+    if ( updated )
+    {
+        // Mark as unmodified, unless there are newer edits to sync
+        if ( m_textEditor->document()->revision() == revision )
         {
-            QMessageBox::critical( this, "Sync Error", "Failed to update DATA deck from text" );
+            m_textEditor->document()->setModified( false );
         }
+        m_syncTextToTreeAction->setEnabled( m_textEditor->document()->isModified() );
+
+        statusBar()->showMessage( "Synchronized text to tree successfully", 3000 );
+        updateDeckProfile();
+
+        // Changed keyword nodes are rebuilt and unchanged ones rebound, both without validation markers.
+        // Attach the latest results, then validate the synced text to replace them.
+        attachProblemsToTree( m_dataDeckValidator->problems() );
+        m_dataDeckValidator->validateNow();
     }
-    catch ( const std::exception& e )
+    else
     {
-        QMessageBox::critical( this,
-                               "Parse Error",
-                               QString( "Failed to parse text:\n%1" ).arg( e.what() ) );
+        statusBar()->showMessage( "Failed to update DATA deck from text, see the Problems panel", 5000 );
+        m_problemsDock->show();
+        m_problemsDock->raise();
+        m_syncTextToTreeAction->setEnabled( m_textEditor->document()->isModified() );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotTextLoadProgress( int percent )
+{
+    m_textLoadProgressBar->setValue( percent );
+    m_textLoadProgressBar->show();
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotTextLoadFinished()
+{
+    m_textLoadProgressBar->hide();
+
+    // Start validating once the whole text is in the editor. The memory estimate now includes the document.
+    RimDataDeck* dataDeck = m_textEditor->dataDeck();
+    if ( dataDeck )
+    {
+        m_dataDeckValidator->setDocument( m_textEditor->document(), dataDeck->filePath(), m_textEditor->takeLoadedText() );
+        dataDeck->refreshMemoryUsage();
+    }
+
+    // Cursor line saved with the project
+    if ( m_pendingRestoreLine > 0 && dataDeck )
+    {
+        highlightTextRange( m_pendingRestoreLine, m_pendingRestoreLine );
+        m_pendingRestoreLine = 0;
     }
 }
 
@@ -753,7 +1754,7 @@ void MainWindow::slotTextEditorModified( bool modified )
     // Enable sync to tree button when text is modified
     if ( m_syncTextToTreeAction )
     {
-        m_syncTextToTreeAction->setEnabled( modified && getCurrentDataDeck() != nullptr );
+        m_syncTextToTreeAction->setEnabled( modified && !m_isSyncingTextToTree && getCurrentDataDeck() != nullptr );
     }
 }
 
@@ -767,10 +1768,17 @@ void MainWindow::highlightTextRange( int startLine, int endLine )
         return;
     }
 
-    // Convert line numbers to text positions (lines are 1-based, but QTextEdit is 0-based)
+    if ( isLargeFileViewerActive() )
+    {
+        m_largeFileViewer->selectLines( startLine, endLine );
+        return;
+    }
+
+    // Convert line numbers to text positions (lines are 1-based, but QTextEdit is 0-based). Blocks are
+    // looked up by number, layout line numbers skip folded text.
     QTextDocument* doc = m_textEditor->document();
-    QTextBlock startBlock = doc->findBlockByLineNumber( startLine - 1 );
-    QTextBlock endBlock = doc->findBlockByLineNumber( endLine - 1 );
+    QTextBlock startBlock = doc->findBlockByNumber( startLine - 1 );
+    QTextBlock endBlock = doc->findBlockByNumber( endLine - 1 );
 
     if ( !startBlock.isValid() || !endBlock.isValid() )
     {
@@ -778,10 +1786,11 @@ void MainWindow::highlightTextRange( int startLine, int endLine )
         return;
     }
 
-    // Create text cursor and select the range
+    // Create text cursor and select the range. The cursor is left on the first line, which stays
+    // visible when the keyword is folded.
     QTextCursor cursor = m_textEditor->textCursor();
-    cursor.setPosition( startBlock.position() );
-    cursor.setPosition( endBlock.position() + endBlock.length() - 1, QTextCursor::KeepAnchor );
+    cursor.setPosition( endBlock.position() + endBlock.length() - 1 );
+    cursor.setPosition( startBlock.position(), QTextCursor::KeepAnchor );
 
     // Set the cursor (this will highlight the selection)
     m_textEditor->setTextCursor( cursor );
@@ -833,3 +1842,225 @@ void MainWindow::slotTextCursorChanged()
     // Select corresponding object in tree (but don't highlight text to avoid recursion)
     selectObjectAtTextPosition( lineNumber );
 }
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+bool MainWindow::isLargeFileViewerActive() const
+{
+    return m_centralStack && m_centralStack->currentWidget() == m_largeFileViewer;
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotLargeFileViewerLineChanged( int lineNumber )
+{
+    if ( m_updatingFromTree )
+    {
+        return;
+    }
+
+    selectObjectAtTextPosition( lineNumber );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotValidationStarted()
+{
+    m_problemsWidget->setValidating( true );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotValidationFinished( const QList<DataDeckProblem>& problems )
+{
+    showProblems( problems );
+    attachProblemsToTree( problems );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Show problems in the panel, and as markers in the editor for those in the displayed file
+//--------------------------------------------------------------------------------------------------
+void MainWindow::showProblems( const QList<DataDeckProblem>& problems )
+{
+    m_problemsWidget->setProblems( problems );
+    m_problemsDock->setWindowTitle( problems.isEmpty() ? "Problems" : QString( "Problems (%1)" ).arg( problems.size() ) );
+
+    QString editorFilePath = m_textEditor->dataDeck() ? m_textEditor->dataDeck()->filePath() : m_dataDeckValidator->deckFilePath();
+
+    QList<DataDeckProblem> editorProblems;
+    for ( const DataDeckProblem& problem : problems )
+    {
+        if ( problem.filePath == editorFilePath )
+        {
+            editorProblems.append( problem );
+        }
+    }
+    m_textEditor->setProblems( editorProblems );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Show validation problems on the keyword nodes. The keyword indices refer to the validated text,
+/// so this is only done while the text matches the deck in the tree.
+//--------------------------------------------------------------------------------------------------
+void MainWindow::attachProblemsToTree( const QList<DataDeckProblem>& problems )
+{
+    RimDataDeck* dataDeck = m_textEditor->dataDeck();
+    if ( !dataDeck || isLargeFileViewerActive() || m_textEditor->document()->isModified() ||
+         dataDeck->filePath() != m_dataDeckValidator->deckFilePath() )
+    {
+        return;
+    }
+
+    dataDeck->setValidationProblems( problems );
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotProfileEntryActivated( const QString& deckFilePath, int line )
+{
+    RimDataDeck* dataDeck = m_textEditor->dataDeck();
+    if ( line <= 0 || !dataDeck || deckFilePath != dataDeck->filePath() || isLargeFileViewerActive() )
+    {
+        statusBar()->showMessage( QString( "Keyword is at line %1 of %2" ).arg( line ).arg( deckFilePath ), 5000 );
+        return;
+    }
+
+    highlightTextRange( line, line );
+    m_textEditor->setFocus();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The profile is collected during the load, so this only copies it into the panel
+//--------------------------------------------------------------------------------------------------
+void MainWindow::updateDeckProfile()
+{
+    if ( !m_profileDock->isVisible() )
+    {
+        return;
+    }
+
+    if ( m_profiledDeck )
+    {
+        m_profileWidget->setProfile( m_profiledDeck->filePath(), m_profiledDeck->profile() );
+    }
+    else
+    {
+        m_profileWidget->clearProfile();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+///
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotProblemActivated( const QString& filePath, int line )
+{
+    if ( line <= 0 )
+    {
+        return;
+    }
+
+    if ( filePath != m_dataDeckValidator->deckFilePath() )
+    {
+        statusBar()->showMessage( QString( "Problem is in %1 line %2" ).arg( filePath ).arg( line ), 5000 );
+        return;
+    }
+
+    highlightTextRange( line, line );
+    m_textEditor->setFocus();
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Start recording an editing session in the text editor, or stop and save the recorded session
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotRecordEditingSession( bool checked )
+{
+    if ( checked )
+    {
+        RimDataDeck* dataDeck = m_textEditor->dataDeck();
+        if ( !dataDeck || isLargeFileViewerActive() )
+        {
+            QMessageBox::information( this, "Record Editing Session", "Open a DATA file in the text editor before recording." );
+            QSignalBlocker blocker( m_recordSessionAction );
+            m_recordSessionAction->setChecked( false );
+            return;
+        }
+
+        m_sessionRecorder->start( m_textEditor, dataDeck );
+        statusBar()->showMessage( QString( "Recording editing session on %1" ).arg( dataDeck->filePath() ) );
+        return;
+    }
+
+    const EditingSession session = m_sessionRecorder->stop();
+    statusBar()->showMessage( QString( "Recorded %1 events" ).arg( session.events.size() ), 5000 );
+
+    QString filePath = QFileDialog::getSaveFileName( this, "Save Editing Session", QString(), "Editing Sessions (*.json)" );
+    if ( filePath.isEmpty() )
+    {
+        return;
+    }
+
+    QString errorMessage;
+    if ( !session.save( filePath, &errorMessage ) )
+    {
+        QMessageBox::warning( this, "Save Editing Session", errorMessage );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// Start tracing, or stop and save the trace as Chrome trace JSON
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotRecordTrace( bool checked )
+{
+    if ( checked )
+    {
+        DataDeckTrace::start();
+        statusBar()->showMessage( "Recording trace" );
+        return;
+    }
+
+    DataDeckTrace::stop();
+    statusBar()->showMessage( QString( "Recorded %1 trace events" ).arg( DataDeckTrace::eventCount() ), 5000 );
+
+    QString filePath = QFileDialog::getSaveFileName( this, "Save Trace", QString(), "Chrome Trace (*.json)" );
+    if ( filePath.isEmpty() )
+    {
+        return;
+    }
+
+    QString errorMessage;
+    if ( !DataDeckTrace::writeChromeTrace( filePath, &errorMessage ) )
+    {
+        QMessageBox::warning( this, "Save Trace", errorMessage );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The choice is remembered between sessions
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotShowPerformanceHud( bool checked )
+{
+    m_performanceHud->setVisible( checked );
+
+    QSettings settings( "Ceetron", "DataObjectEditor" );
+    settings.setValue( "showPerformanceHud", checked );
+}
+
+//--------------------------------------------------------------------------------------------------
+/// The estimate in the properties is only refreshed when the deck is loaded or updated
+//--------------------------------------------------------------------------------------------------
+void MainWindow::slotRefreshMemoryUsage()
+{
+    RimDataDeck* dataDeck = getCurrentDataDeck();
+    if ( !dataDeck )
+    {
+        statusBar()->showMessage( "No DATA file selected", 3000 );
+        return;
+    }
+
+    dataDeck->refreshMemoryUsage();
+}
@@ -1,14 +1,39 @@
 #pragma once
 
+#include "cafPdmPointer.h"
+
+#include <QElapsedTimer>
+#include <QList>
 #include <QMainWindow>
 #include <QStringList>
 
+#include <memory>
+
 class QMenu;
 class QAction;
 class QToolBar;
+class QProgressBar;
+class QToolButton;
+class QStackedWidget;
 class RimDataDeckTextEditor;
 class RimDataDeck;
 class KeywordHelpWidget;
+class DataFileMappedViewer;
+class DataDeckLoader;
+class DataDeckRestoreQueue;
+class DataDeckValidator;
+class DataDeckProblemsWidget;
+class DataDeckProfileWidget;
+class DataDeckPerformanceHud;
+class EditingSessionRecorder;
+struct DataDeckLoadResult;
+struct DataDeckProblem;
+class QDockWidget;
+
+namespace Opm
+{
+class Deck;
+}
 
 namespace caf
 {
@@ -33,9 +58,15 @@ private:
     void createDockPanels();
     void createMenus();
     void createToolBar();
+    void createStatusBarWidgets();
     void createEmptyProject();
     void releaseProjectData();
 
+    // Project files store deck references and UI state, the decks are loaded again on open
+    bool        openProject( const QString& filePath );
+    bool        saveProject( const QString& filePath );
+    int         restoreDataDecks();
+
     // Recent files management
     void        loadRecentFiles();
     void        saveRecentFiles();
@@ -43,18 +74,41 @@ private:
     void        updateRecentFilesMenu();
     QString     mostRecentFile() const;
     bool        importDataFile( const QString& filePath );
+    void        addDataDeckToProject( RimDataDeck* dataDeck );
 
     // Text editor synchronization
     void        updateTextEditor();
     RimDataDeck* getCurrentDataDeck();
     void        highlightTextRange( int startLine, int endLine );
     void        selectObjectAtTextPosition( int lineNumber );
+    void        showProblems( const QList<DataDeckProblem>& problems );
+    void        attachProblemsToTree( const QList<DataDeckProblem>& problems );
+    void        updateDeckProfile();
+    bool        isLargeFileViewerActive() const;
+    void        applySyncedDeck( RimDataDeck* dataDeck, std::shared_ptr<Opm::Deck> newDeck, QList<DataDeckProblem> problems, int revision );
+
+    // Deck comparison
+    RimDataDeck* findDataDeck( const QString& filePath ) const;
+    void         compareDataDecks( RimDataDeck* baseDeck, RimDataDeck* otherDeck );
 
 private slots:
     void slotNewProject();
+    void slotOpenProject();
+    void slotSaveProject();
+    void slotSaveProjectAs();
     void slotImportDataFile();
+    void slotCompareDataDecks();
+    void slotCompareArrays();
     void slotOpenLastUsedDataFile();
     void slotOpenRecentFile();
+    void slotRecentFilesChecked( const QStringList& missingFiles );
+    void slotDataDeckLoadStarted( const QString& filePath );
+    void slotDataDeckLoaded( const DataDeckLoadResult& result );
+    void slotDataDeckLoadCanceled( const QString& filePath );
+    void slotRestoredDeckLoaded( const DataDeckLoadResult& result );
+    void slotProjectRestoreFinished();
+    void slotTextLoadProgress( int percent );
+    void slotTextLoadFinished();
     void slotSelectionChanged();
     void slotAbout();
     void slotAlignColumns(); // New slot
@@ -64,8 +118,23 @@ private slots:
     void slotSyncTreeToText();
     void slotTextEditorModified( bool modified );
     void slotTextCursorChanged();
+    void slotLargeFileViewerLineChanged( int lineNumber );
+
+    // Validation
+    void slotValidationStarted();
+    void slotValidationFinished( const QList<DataDeckProblem>& problems );
+    void slotProblemActivated( const QString& filePath, int line );
+    void slotProfileEntryActivated( const QString& deckFilePath, int line );
+
+    // Editing session recording and tracing
+    void slotRecordEditingSession( bool checked );
+    void slotRecordTrace( bool checked );
+    void slotShowPerformanceHud( bool checked );
+    void slotRefreshMemoryUsage();
 
 private:
+    friend class EditingSessionReplayer; // Drives the window headless to replay recorded sessions
+
     static MainWindow* sm_mainWindowInstance;
 
     caf::PdmUiTreeView*     m_pdmUiTreeView;
@@ -73,7 +142,9 @@ private:
     caf::PdmDocument*       m_project;
 
     // Text editor
+    QStackedWidget*         m_centralStack;
     RimDataDeckTextEditor*  m_textEditor;
+    DataFileMappedViewer*   m_largeFileViewer;
     KeywordHelpWidget*      m_keywordHelpWidget;
     QToolBar*               m_textEditorToolBar;
     QAction*                m_syncTextToTreeAction;
@@ -85,6 +156,45 @@ private:
     QAction*    m_openLastUsedAction;
     static constexpr int MAX_RECENT_FILES = 10;
 
+    static constexpr const char* PROJECT_FILE_FILTER = "Data Object Editor Projects (*.doeproj);;All Files (*.*)";
+    int                          m_pendingRestoreLine; // Editor line to select when the restored deck's text is loaded
+
+    // Background loading
+    DataDeckLoader* m_dataDeckLoader;
+    QProgressBar*   m_loadProgressBar;
+    QToolButton*    m_cancelLoadButton;
+    QProgressBar*   m_textLoadProgressBar;
+    bool            m_autoOpenLastFile;
+
+    // Parallel loading of the decks of an opened project
+    DataDeckRestoreQueue* m_restoreQueue;
+    QElapsedTimer         m_restoreTimer;
+    QStringList           m_restoreChangedFiles;
+    QStringList           m_restoreFailedFiles;
+
+    // Background validation
+    DataDeckValidator*      m_dataDeckValidator;
+    DataDeckProblemsWidget* m_problemsWidget;
+    QDockWidget*            m_problemsDock;
+
+    // Deck profile of the deck holding the selection
+    DataDeckProfileWidget*       m_profileWidget;
+    QDockWidget*                 m_profileDock;
+    caf::PdmPointer<RimDataDeck> m_profiledDeck;
+
+    // Performance readout in the status bar
+    DataDeckPerformanceHud* m_performanceHud;
+    QAction*                m_performanceHudAction;
+
+    // Comparison waiting for the other deck to load
+    caf::PdmPointer<RimDataDeck> m_pendingCompareBaseDeck;
+    QString                      m_pendingCompareFilePath;
+
     // Synchronization state
     bool        m_updatingFromTree;
+    bool        m_isSyncingTextToTree; // The editor text is being parsed for a sync to the tree
+
+    // Editing session recording
+    EditingSessionRecorder* m_sessionRecorder;
+    QAction*                m_recordSessionAction;
 };
@@ -1,4 +1,7 @@
 #include "MainWindow.h"
+#include "DataDeck/DataDeckBatchRunner.h"
+#include "DataDeck/DataDeckTrace.h"
+#include "DataDeck/DataDeckValidator.h"
 
 #include "cafCmdFeatureManager.h"
 #include "cafFactory.h"
@@ -7,10 +10,42 @@
 #include "cafUiAppearanceSettings.h"
 
 #include <QApplication>
+#include <QCoreApplication>
+
+#include <cstdio>
 
 
 int main( int argc, char* argv[] )
 {
+    // Trace the whole run when DATA_OBJECT_EDITOR_TRACE names an output file
+    DataDeckTrace::startFromEnvironment();
+
+    // Parses run on worker threads in both modes, the parser log must be set up before them
+    DataDeckValidator::registerLogBackend();
+
+    // Batch mode only needs a core application, so it runs without a display server
+    if ( DataDeckBatchRunner::isBatchMode( argc, argv ) )
+    {
+        QCoreApplication app( argc, argv );
+
+        DataDeckBatchRunner::Options options;
+        QString                      errorMessage;
+        if ( !DataDeckBatchRunner::parseArguments( app.arguments(), &options, &errorMessage ) )
+        {
+            std::fprintf( stderr, "%s\n\n%s", qPrintable( errorMessage ), qPrintable( DataDeckBatchRunner::helpText() ) );
+            return DataDeckBatchRunner::EXIT_USAGE_ERROR;
+        }
+        if ( options.helpRequested )
+        {
+            std::fprintf( stdout, "%s", qPrintable( DataDeckBatchRunner::helpText() ) );
+            return DataDeckBatchRunner::EXIT_OK;
+        }
+
+        const int exitCode = DataDeckBatchRunner::run( options );
+        DataDeckTrace::finishFromEnvironment();
+        return exitCode;
+    }
+
     // Configure UI appearance
     caf::UiAppearanceSettings::instance()->setAutoValueEditorColor( "moccasin" );
 
@@ -27,6 +62,8 @@ int main( int argc, char* argv[] )
         window.show();
 
         appExitCode = app.exec();
+
+        DataDeckTrace::finishFromEnvironment();
     }
 
     // Cleanup singletons